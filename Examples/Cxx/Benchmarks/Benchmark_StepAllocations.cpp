@@ -0,0 +1,132 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Number of heap allocations while counting is enabled
+static std::atomic<Int> allocations(0);
+static std::atomic<Bool> countAllocations(false);
+
+#ifdef __GLIBC__
+extern "C" {
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t num, size_t size);
+	void* __libc_realloc(void* ptr, size_t size);
+
+	// Counting allocator that replaces malloc for the whole process,
+	// which includes operator new and the aligned allocations of Eigen
+	void* malloc(size_t size) {
+		if (countAllocations.load(std::memory_order_relaxed))
+			allocations++;
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t num, size_t size) {
+		if (countAllocations.load(std::memory_order_relaxed))
+			allocations++;
+		return __libc_calloc(num, size);
+	}
+
+	void* realloc(void* ptr, size_t size) {
+		if (countAllocations.load(std::memory_order_relaxed))
+			allocations++;
+		return __libc_realloc(ptr, size);
+	}
+}
+#endif
+
+/// Simulates a ladder network of RL line sections with a capacitor and
+/// a load at every node and returns the number of heap allocations per step
+Real benchmark(Int sections, Int steps) {
+	String simName = "Benchmark_StepAllocations_" + std::to_string(sections);
+	Logger::setLogDir("logs/" + simName);
+
+	SystemNodeList nodes;
+	SystemComponentList components;
+
+	auto n0 = SimNode::make("n0");
+	auto vs = VoltageSource::make("vs", Logger::Level::off);
+	vs->setParameters(Complex(10000, 0));
+	vs->connect({ SimNode::GND, n0 });
+	nodes.push_back(n0);
+	components.push_back(vs);
+
+	auto prev = n0;
+	for (Int k = 1; k <= sections; k++) {
+		auto mid = SimNode::make("m" + std::to_string(k));
+		auto node = SimNode::make("n" + std::to_string(k));
+		auto r = Resistor::make("r" + std::to_string(k), Logger::Level::off);
+		r->setParameters(0.1);
+		auto l = Inductor::make("l" + std::to_string(k), Logger::Level::off);
+		l->setParameters(1e-3);
+		auto c = Capacitor::make("c" + std::to_string(k), Logger::Level::off);
+		c->setParameters(1e-6);
+		auto load = Resistor::make("load" + std::to_string(k), Logger::Level::off);
+		load->setParameters(1000);
+		r->connect({ prev, mid });
+		l->connect({ mid, node });
+		c->connect({ node, SimNode::GND });
+		load->connect({ node, SimNode::GND });
+		nodes.push_back(mid);
+		nodes.push_back(node);
+		components.insert(components.end(), { r, l, c, load });
+		prev = node;
+	}
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(SystemTopology(50, nodes, components));
+	sim.setTimeStep(1e-4);
+	sim.setFinalTime((steps + 10) * 1e-4);
+	sim.setMnaSolverImplementation(MnaSolverFactory::EigenSparse);
+
+	sim.start();
+	// The first steps may still allocate lazily initialized buffers
+	for (Int i = 0; i < 10; i++)
+		sim.step();
+
+	allocations = 0;
+	countAllocations = true;
+	auto start = std::chrono::steady_clock::now();
+	for (Int i = 0; i < steps; i++)
+		sim.step();
+	auto end = std::chrono::steady_clock::now();
+	countAllocations = false;
+	sim.stop();
+
+	Real perStep = Real(allocations.load()) / steps;
+	std::cout << sections << " sections, " << nodes.size() << " nodes: "
+		<< perStep << " allocations per step, "
+		<< std::chrono::duration<Real, std::micro>(end - start).count() / steps
+		<< " us per step" << std::endl;
+	return perStep;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int steps = args.options.count("steps") ? Int(args.options["steps"]) : 1000;
+
+	Real maxAllocations = 0;
+	for (Int sections : { 10, 100, 1000 })
+		maxAllocations = std::max(maxAllocations, benchmark(sections, steps));
+
+#ifdef __GLIBC__
+	return maxAllocations == 0 ? 0 : 1;
+#else
+	std::cout << "Allocations are only counted with glibc" << std::endl;
+	return 0;
+#endif
+}
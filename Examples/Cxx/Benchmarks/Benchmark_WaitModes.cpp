@@ -0,0 +1,71 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <thread>
+
+#include <dpsim/Scheduler.h>
+#include <dpsim/Utils.h>
+
+using namespace DPsim;
+
+/// Measures the wake-up latency of a thread waiting for a counter that is
+/// incremented by another thread after an idle time, and the CPU time
+/// used by both threads relative to the wall clock time.
+void benchmark(String name, WaitMode mode, Int iterations, Int idleTime) {
+	Counter counter;
+	counter.setWaitMode(mode);
+	Barrier barrier(2, mode);
+	std::atomic<std::chrono::steady_clock::rep> incTime(0);
+	std::vector<Real> latencies(iterations);
+
+	auto wallStart = std::chrono::steady_clock::now();
+	std::clock_t cpuStart = std::clock();
+
+	std::thread waiter([&]() {
+		for (Int i = 0; i < iterations; i++) {
+			counter.wait(i + 1);
+			auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+			latencies[i] = std::chrono::duration<Real, std::micro>(
+				std::chrono::steady_clock::duration(now - incTime.load())).count();
+			barrier.wait();
+		}
+	});
+	for (Int i = 0; i < iterations; i++) {
+		std::this_thread::sleep_for(std::chrono::microseconds(idleTime));
+		incTime.store(std::chrono::steady_clock::now().time_since_epoch().count());
+		counter.inc();
+		barrier.wait();
+	}
+	waiter.join();
+
+	Real cpuTime = Real(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+	Real wallTime = std::chrono::duration<Real>(std::chrono::steady_clock::now() - wallStart).count();
+
+	std::sort(latencies.begin(), latencies.end());
+	Real mean = 0;
+	for (auto latency : latencies)
+		mean += latency / iterations;
+
+	std::cout << name << ": latency mean " << mean << " us, median " << latencies[iterations / 2]
+		<< " us, max " << latencies.back() << " us, CPU usage " << 100 * cpuTime / wallTime << " %" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int iterations = args.options.count("iterations") ? Int(args.options["iterations"]) : 1000;
+	// Idle time of the waiting thread in us between two wake-ups
+	Int idleTime = args.options.count("idle") ? Int(args.options["idle"]) : 100;
+
+	benchmark("spin", WaitMode::Spin, iterations, idleTime);
+	benchmark("condition", WaitMode::Condition, iterations, idleTime);
+	benchmark("adaptive", WaitMode::Adaptive, iterations, idleTime);
+}
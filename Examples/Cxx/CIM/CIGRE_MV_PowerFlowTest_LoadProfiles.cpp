@@ -64,10 +64,14 @@ int main(int argc, char** argv){
 	CPS::Real time_step = 1;
 	CPS::Real time_end = 300;
 
+	// Use "--solver-type FDP" for the fast decoupled powerflow
+	Solver::Type solverType = Solver::Type::NRP;
 	if (argc > 1) {
 		CommandLineArgs args(argc, argv);
 		time_step = args.timeStep;
 		time_end = args.duration;
+		if (args.solver.type == Solver::Type::FDP)
+			solverType = Solver::Type::FDP;
 	}
 
     CIM::Reader reader(simName, Logger::Level::info, Logger::Level::off);
@@ -139,7 +143,7 @@ int main(int argc, char** argv){
 	sim.setTimeStep(time_step);
 	sim.setFinalTime(time_end);
 	sim.setDomain(Domain::SP);
-	sim.setSolverType(Solver::Type::NRP);
+	sim.setSolverType(solverType);
 	sim.doInitFromNodesAndTerminals(true);
 	sim.addLogger(logger);
 	
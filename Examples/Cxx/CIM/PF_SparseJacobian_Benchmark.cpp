@@ -0,0 +1,73 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <cps/CIM/Reader.h>
+#include <DPsim.h>
+
+using namespace std;
+using namespace DPsim;
+using namespace CPS;
+using namespace CPS::CIM;
+
+/*
+ * This example compares the powerflow with sparse and dense Jacobian
+ * for the CIGRE MV and the IEEE European LV benchmark systems.
+ */
+Real runPowerflow(String simName, std::list<fs::path> filenames, Bool sparseJacobian, Int numSteps) {
+	CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+	SystemTopology system = reader.loadCIM(50, filenames, CPS::Domain::SP);
+
+	auto logger = DPsim::DataLogger::make(simName);
+	for (auto node : system.mNodes)
+		logger->addAttribute(node->name() + ".V", node->attribute("v"));
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(system);
+	sim.setTimeStep(1);
+	sim.setFinalTime(numSteps);
+	sim.setDomain(Domain::SP);
+	sim.setSolverType(Solver::Type::NRP);
+	sim.doInitFromNodesAndTerminals(true);
+	sim.doSparsePowerflowJacobian(sparseJacobian);
+	sim.addLogger(logger);
+
+	auto start = std::chrono::steady_clock::now();
+	sim.run();
+	auto end = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<Real>(end - start).count();
+}
+
+void benchmark(String name, std::list<fs::path> filenames, Int numSteps) {
+	Real sparseTime = runPowerflow(name + "_SparseJacobian", filenames, true, numSteps);
+	Real denseTime = runPowerflow(name + "_DenseJacobian", filenames, false, numSteps);
+
+	std::cout << name << ": sparse Jacobian " << sparseTime << " s, dense Jacobian "
+		<< denseTime << " s, speedup " << denseTime / sparseTime << std::endl;
+}
+
+int main(int argc, char** argv) {
+	Int numSteps = argc > 1 ? std::stoi(argv[1]) : 10;
+
+	benchmark("CIGRE-MV", DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_06J16h_DI.xml",
+		"Rootnet_FULL_NE_06J16h_EQ.xml",
+		"Rootnet_FULL_NE_06J16h_SV.xml",
+		"Rootnet_FULL_NE_06J16h_TP.xml"
+	}, "build/_deps/cim-data-src/CIGRE_MV/NEPLAN/CIGRE_MV_no_tapchanger_With_LoadFlow_Results", "CIMPATH"), numSteps);
+
+	benchmark("IEEE-EU-LV", DPsim::Utils::findFiles({
+		"Rootnet_FULL_NE_13J16h_DI.xml",
+		"Rootnet_FULL_NE_13J16h_EQ.xml",
+		"Rootnet_FULL_NE_13J16h_SV.xml",
+		"Rootnet_FULL_NE_13J16h_TP.xml"
+	}, "build/_deps/cim-data-src/IEEE_EU_LV/IEEE_EU_LV_reduced", "CIMPATH"), numSteps);
+
+	return 0;
+}
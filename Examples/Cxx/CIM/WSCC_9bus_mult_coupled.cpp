@@ -12,6 +12,7 @@
 
 #include <DPsim.h>
 #include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
 
 using namespace DPsim;
 using namespace CPS;
@@ -78,8 +79,14 @@ void simulateCoupled(std::list<fs::path> filenames, CommandLineArgs& args, Int c
 
 	Simulation sim(simName, args);
 	sim.setSystem(sys);
-	if (threads > 0)
-		sim.setScheduler(std::make_shared<OpenMPLevelScheduler>(threads));
+	sim.doBatchLinearComponents(args.options_bool["batch_linear"]);
+	if (threads > 0) {
+		if (args.options_bool["work_stealing"])
+			sim.setScheduler(std::make_shared<WorkStealingScheduler>(threads));
+		else
+			sim.setScheduler(std::make_shared<OpenMPLevelScheduler>(threads));
+		sim.doTaskFusion(args.options_bool["fuse_tasks"]);
+	}
 
 	// Logging
 	//auto logger = DataLogger::make(simName);
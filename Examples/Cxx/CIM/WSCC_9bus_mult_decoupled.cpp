@@ -11,6 +11,7 @@
 #include <fstream>
 
 #include <DPsim.h>
+#include <dpsim/SubnetPipelineScheduler.h>
 #include <dpsim/ThreadLevelScheduler.h>
 
 using namespace DPsim;
@@ -46,7 +47,7 @@ void multiply_decoupled(SystemTopology& sys, int copies,
 	}
 }
 
-void simulateDecoupled(std::list<fs::path> filenames, Int copies, Int threads, Int seq = 0) {
+void simulateDecoupled(std::list<fs::path> filenames, Int copies, Int threads, Int seq = 0, Int window = 0) {
 	String simName = "WSCC_9bus_decoupled_" + std::to_string(copies)
 		+ "_" + std::to_string(threads) + "_" + std::to_string(seq);
 	Logger::setLogDir("logs/"+simName);
@@ -62,7 +63,10 @@ void simulateDecoupled(std::list<fs::path> filenames, Int copies, Int threads, I
 	sim.setTimeStep(0.0001);
 	sim.setFinalTime(0.5);
 	sim.setDomain(Domain::DP);
-	if (threads > 0)
+	// Run each subnet on its own thread for a window of steps
+	if (threads > 0 && window > 0)
+		sim.setScheduler(std::make_shared<SubnetPipelineScheduler>(threads, window));
+	else if (threads > 0)
 		sim.setScheduler(std::make_shared<OpenMPLevelScheduler>(threads));
 
 	// Logging
@@ -107,5 +111,5 @@ int main(int argc, char *argv[]) {
 		<< Int(args.options["threads"]) << " threads, sequence number "
 		<< Int(args.options["seq"]) << std::endl;
 	simulateDecoupled(filenames, Int(args.options["copies"]),
-		Int(args.options["threads"]), Int(args.options["seq"]));
+		Int(args.options["threads"]), Int(args.options["seq"]), Int(args.options["window"]));
 }
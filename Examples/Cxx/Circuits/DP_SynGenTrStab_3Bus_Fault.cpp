@@ -11,7 +11,7 @@ ScenarioConfig ThreeBus;
 Real SwitchOpen = 1e12;
 Real SwitchClosed = 0.1;
 
-void DP_SynGenTrStab_3Bus_Fault(String simName, Real timeStep, Real finalTime, bool startFaultEvent, bool endFaultEvent, Real startTimeFault, Real endTimeFault, Real cmdInertia_G1, Real cmdInertia_G2, Real cmdDamping_G1, Real cmdDamping_G2) {
+void DP_SynGenTrStab_3Bus_Fault(String simName, Real timeStep, Real finalTime, bool startFaultEvent, bool endFaultEvent, Real startTimeFault, Real endTimeFault, Real cmdInertia_G1, Real cmdInertia_G2, Real cmdDamping_G1, Real cmdDamping_G2, Bool batchMachines) {
 	// ----- POWERFLOW FOR INITIALIZATION -----
 	Real timeStepPF = finalTime;
 	Real finalTimePF = finalTime+timeStepPF;
@@ -197,6 +197,8 @@ void DP_SynGenTrStab_3Bus_Fault(String simName, Real timeStep, Real finalTime, b
 	simDP.setDomain(Domain::DP);
 	simDP.addLogger(loggerDP);
 	simDP.doSystemMatrixRecomputation(true);
+	// Integrate the rotor dynamics in a bank, generator 2 with reference omega is not batched
+	simDP.doBatchMachines(batchMachines);
 
 	// Events
 	if (startFaultEvent){
@@ -230,6 +232,7 @@ int main(int argc, char* argv[]) {
 	Real cmdInertia_G2= 1.0;
 	Real cmdDamping_G1=1.0;
 	Real cmdDamping_G2=1.0;
+	Bool batchMachines=false;
 
 	CommandLineArgs args(argc, argv);
 	if (argc > 1) {
@@ -249,7 +252,12 @@ int main(int argc, char* argv[]) {
 			startTimeFault = args.options["STARTTIMEFAULT"];
 		if (args.options.find("ENDTIMEFAULT") != args.options.end())
 			endTimeFault = args.options["ENDTIMEFAULT"];	
+		// The w_r and delta_r traces of the batched run should match the unbatched run
+		if (args.options_bool.find("batch_machines") != args.options_bool.end())
+			batchMachines = args.options_bool["batch_machines"];
+		if (batchMachines)
+			simName += "_BatchMachines";
 	}
 	
-	DP_SynGenTrStab_3Bus_Fault(simName, timeStep, finalTime, startFaultEvent, endFaultEvent, startTimeFault, endTimeFault, cmdInertia_G1, cmdInertia_G2, cmdDamping_G1, cmdDamping_G2);
+	DP_SynGenTrStab_3Bus_Fault(simName, timeStep, finalTime, startFaultEvent, endFaultEvent, startTimeFault, endTimeFault, cmdInertia_G1, cmdInertia_G2, cmdDamping_G1, cmdDamping_G2, batchMachines);
 }
\ No newline at end of file
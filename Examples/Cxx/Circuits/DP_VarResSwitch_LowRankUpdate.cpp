@@ -0,0 +1,110 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/// Load voltage of each step and solver statistics of one run
+struct RunResult {
+	std::vector<Complex> voltages;
+	Int refactorizations = 0;
+	Int lowRankUpdates = 0;
+};
+
+/// Switches two variable resistors and solves the changed system either with
+/// full refactorizations (maxUpdateRank = 0) or with low-rank updates
+RunResult simulate(String simName, UInt maxUpdateRank) {
+	Logger::setLogDir("logs/"+simName);
+
+	// Nodes
+	auto n1 = SimNode::make("n1");
+	auto n2 = SimNode::make("n2");
+	auto n3 = SimNode::make("n3");
+
+	// Components
+	auto vs = VoltageSource::make("vs");
+	vs->setParameters(Complex(10000, 0));
+	auto rLine = Resistor::make("r_line");
+	rLine->setParameters(1);
+	auto lLine = Inductor::make("l_line");
+	lLine->setParameters(0.01);
+	auto cLoad = Capacitor::make("c_load");
+	cLoad->setParameters(1e-6);
+	auto rLoad = Resistor::make("r_load");
+	rLoad->setParameters(100);
+	auto fault = varResSwitch::make("fault");
+	fault->setParameters(1e9, 1, false);
+	fault->setInitParameters(1e-4);
+	auto bypass = varResSwitch::make("bypass");
+	bypass->setParameters(1e9, 5, false);
+	bypass->setInitParameters(1e-4);
+
+	// Topology
+	vs->connect({ SimNode::GND, n1 });
+	rLine->connect({ n1, n2 });
+	lLine->connect({ n2, n3 });
+	cLoad->connect({ n3, SimNode::GND });
+	rLoad->connect({ n3, SimNode::GND });
+	fault->connect({ n3, SimNode::GND });
+	bypass->connect({ n2, n3 });
+
+	auto sys = SystemTopology(50,
+		SystemNodeList{n1, n2, n3},
+		SystemComponentList{vs, rLine, lLine, cLoad, rLoad, fault, bypass});
+
+	// Logging
+	auto logger = DataLogger::make(simName);
+	logger->addAttribute("v3", n3->attribute("v"));
+	logger->addAttribute("i_line", lLine->attribute("i_intf"));
+
+	Simulation sim(simName, Logger::Level::info);
+	sim.setSystem(sys);
+	sim.setTimeStep(1e-4);
+	sim.setFinalTime(0.1);
+	sim.doSystemMatrixRecomputation(true);
+	sim.setMaxUpdateRank(maxUpdateRank);
+	sim.addLogger(logger);
+
+	sim.addEvent(SwitchEvent::make(0.03, fault, true));
+	sim.addEvent(SwitchEvent::make(0.05, bypass, true));
+	sim.addEvent(SwitchEvent::make(0.07, fault, false));
+
+	RunResult result;
+	sim.start();
+	while (sim.time() < sim.finalTime()) {
+		sim.step();
+		result.voltages.push_back(n3->singleVoltage());
+	}
+	sim.stop();
+
+	auto solver = std::dynamic_pointer_cast<CPS::AttributeList>(sim.solvers().front());
+	result.refactorizations = solver->attribute<Int>("refactorizations")->get();
+	result.lowRankUpdates = solver->attribute<Int>("low_rank_updates")->get();
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+	RunResult full = simulate("DP_VarResSwitch_Refactorization", 0);
+	RunResult update = simulate("DP_VarResSwitch_LowRankUpdate", 4);
+
+	Real maxDeviation = 0;
+	for (UInt k = 0; k < full.voltages.size(); k++)
+		maxDeviation = std::max(maxDeviation,
+			std::abs(full.voltages[k] - update.voltages[k]) / std::max(std::abs(full.voltages[k]), 1.));
+
+	std::cout << "Refactorization: refactorizations = " << full.refactorizations
+		<< ", low_rank_updates = " << full.lowRankUpdates << std::endl;
+	std::cout << "Low-rank update: refactorizations = " << update.refactorizations
+		<< ", low_rank_updates = " << update.lowRankUpdates << std::endl;
+	std::cout << "Maximum relative deviation of v3: " << maxDeviation << std::endl;
+
+	return maxDeviation < 1e-6 ? 0 : 1;
+}
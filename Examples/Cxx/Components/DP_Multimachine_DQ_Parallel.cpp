@@ -13,13 +13,14 @@ using namespace DPsim;
 using namespace CPS::DP;
 using namespace CPS::DP::Ph3;
 
-void doSim(int threads, int generators, int repNumber) {
+void doSim(int threads, int generators, int repNumber, Bool aggregateODE, Bool trapez, Bool batchMachines) {
 	// Define simulation parameters
 	Real timeStep = 0.00005;
 	Real finalTime = 0.3;
 	String name = "DP_Multimachine_th" + std::to_string(threads)
 		+ "_gen" + std::to_string(generators)
-		+ "_rep" + std::to_string(repNumber);
+		+ "_rep" + std::to_string(repNumber)
+		+ (trapez ? "_trapez" : "") + (batchMachines ? "_bank" : "");
 	Logger::setLogDir("logs/"+name);
 
 	// Define machine parameters in per unit
@@ -70,7 +71,14 @@ void doSim(int threads, int generators, int repNumber) {
 		auto node = SimNode::make("n_" + std::to_string(i), PhaseType::ABC, initVoltGen);
 		nodes.push_back(node);
 
-		auto gen = Ph3::SynchronGeneratorDQODE::make("Gen" + std::to_string(i));
+		// Without Sundials, the generators always use the trapezoidal model
+		std::shared_ptr<Ph3::SynchronGeneratorDQ> gen;
+#ifdef WITH_SUNDIALS
+		if (!trapez)
+			gen = Ph3::SynchronGeneratorDQODE::make("Gen" + std::to_string(i));
+		else
+#endif
+			gen = Ph3::SynchronGeneratorDQTrapez::make("Gen" + std::to_string(i));
 		gen->setParametersFundamentalPerUnit(
 			nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
 			Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H,
@@ -112,6 +120,8 @@ void doSim(int threads, int generators, int repNumber) {
 	sim.setTimeStep(timeStep);
 	sim.setFinalTime(finalTime);
 	sim.setDomain(Domain::DP);
+	sim.doAggregateODESolvers(aggregateODE);
+	sim.doBatchMachines(batchMachines);
 	if (threads > 0) {
 		// Scheduler
 		auto sched = std::make_shared<ThreadLevelScheduler>(threads);
@@ -128,5 +138,6 @@ int main(int argc, char* argv[]) {
 	std::cout << "Simulate with " << Int(args.options["gen"]) << " generators, "
 		<< Int(args.options["threads"]) << " threads, sequence number "
 		<< Int(args.options["seq"]) << std::endl;
-	doSim(Int(args.options["threads"]), Int(args.options["gen"]), Int(args.options["seq"]));
+	doSim(Int(args.options["threads"]), Int(args.options["gen"]), Int(args.options["seq"]),
+		args.options_bool["aggregate_ode"], args.options_bool["trapez"], args.options_bool["batch_machines"]);
 }
@@ -0,0 +1,157 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph3;
+
+/// Rotor speeds and interface currents of each step and the run time
+struct RunResult {
+	std::vector<std::vector<Real>> omegas;
+	std::vector<std::vector<Complex>> currents;
+	Real seconds = 0;
+};
+
+/// Simulates generators that are faulted one after another, either with one
+/// ODE solver per generator or with a single aggregated solver
+RunResult simulate(String simName, Int generators, Bool aggregateODE, Bool implicit) {
+	Logger::setLogDir("logs/"+simName);
+
+	// Define machine parameters in per unit
+	Real nomPower = 555e6;
+	Real nomPhPhVoltRMS = 24e3;
+	Real nomFreq = 60;
+	Real nomFieldCurr = 1300;
+	Int poleNum = 2;
+	Real H = 3.7;
+	Real Rs = 0.003;
+	Real Ll = 0.15;
+	Real Lmd = 1.6599;
+	Real Lmq = 1.61;
+	Real Rfd = 0.0006;
+	Real Llfd = 0.1648;
+	Real Rkd = 0.0284;
+	Real Llkd = 0.1713;
+	Real Rkq1 = 0.0062;
+	Real Llkq1 = 0.7252;
+	Real Rkq2 = 0.0237;
+	Real Llkq2 = 0.125;
+	// Initialization parameters
+	Real initActivePower = 300e6;
+	Real initReactivePower = 0;
+	Real initTerminalVolt = 24000 / sqrt(3) * sqrt(2);
+	Real initVoltAngle = -PI / 2;
+	Real fieldVoltage = 7.0821;
+	Real mechPower = 300e6;
+	// Define grid parameters
+	Real Rload = 1.92;
+	Real BreakerOpen = 1e6;
+	Real BreakerClosed = 0.001;
+
+	std::vector<Complex> initVolt = std::vector<Complex>({
+		Complex(initTerminalVolt * cos(initVoltAngle), initTerminalVolt * sin(initVoltAngle)),
+		Complex(initTerminalVolt * cos(initVoltAngle - 2 * PI / 3), initTerminalVolt * sin(initVoltAngle - 2 * PI / 3)),
+		Complex(initTerminalVolt * cos(initVoltAngle + 2 * PI / 3), initTerminalVolt * sin(initVoltAngle + 2 * PI / 3)) });
+
+	SystemNodeList nodes;
+	SystemComponentList components;
+	std::vector<std::shared_ptr<Ph3::SynchronGeneratorDQODE>> gens;
+	std::vector<std::shared_ptr<Ph3::SeriesSwitch>> faults;
+
+	for (Int i = 0; i < generators; i++) {
+		auto node = SimNode::make("n_" + std::to_string(i), PhaseType::ABC, initVolt);
+
+		// The inertia differs, so that every generator has its own dynamics
+		auto gen = Ph3::SynchronGeneratorDQODE::make("Gen" + std::to_string(i));
+		gen->setParametersFundamentalPerUnit(
+			nomPower, nomPhPhVoltRMS, nomFreq, poleNum, nomFieldCurr,
+			Rs, Ll, Lmd, Lmq, Rfd, Llfd, Rkd, Llkd, Rkq1, Llkq1, Rkq2, Llkq2, H * (1 + 0.1 * i),
+			initActivePower, initReactivePower, initTerminalVolt, initVoltAngle, fieldVoltage, mechPower);
+
+		auto res = Ph3::SeriesResistor::make("R_load" + std::to_string(i));
+		res->setParameters(Rload);
+
+		auto fault = Ph3::SeriesSwitch::make("Br_fault" + std::to_string(i));
+		fault->setParameters(BreakerOpen, BreakerClosed);
+		fault->open();
+
+		gen->connect({node});
+		res->connect({SimNode::GND, node});
+		fault->connect({SimNode::GND, node});
+
+		nodes.push_back(node);
+		components.insert(components.end(), { gen, res, fault });
+		gens.push_back(gen);
+		faults.push_back(fault);
+	}
+
+	Simulation sim(simName, Logger::Level::off);
+	sim.setSystem(SystemTopology(60, nodes, components));
+	sim.setTimeStep(0.00005);
+	sim.setFinalTime(0.3);
+	sim.setDomain(Domain::DP);
+	sim.doAggregateODESolvers(aggregateODE);
+	sim.doImplicitODEIntegration(implicit);
+
+	for (Int i = 0; i < generators; i++) {
+		sim.addEvent(SwitchEvent::make(0.1 + 0.01 * i, faults[i], true));
+		sim.addEvent(SwitchEvent::make(0.2, faults[i], false));
+	}
+
+	RunResult result;
+	sim.start();
+	auto start = std::chrono::steady_clock::now();
+	while (sim.time() < sim.finalTime()) {
+		sim.step();
+		std::vector<Real> omegas;
+		std::vector<Complex> currents;
+		for (auto gen : gens) {
+			omegas.push_back(gen->attribute<Real>("w_r")->get());
+			currents.push_back(gen->attribute<MatrixComp>("i_intf")->get()(0, 0));
+		}
+		result.omegas.push_back(omegas);
+		result.currents.push_back(currents);
+	}
+	result.seconds = std::chrono::duration<Real>(std::chrono::steady_clock::now() - start).count();
+	sim.stop();
+	return result;
+}
+
+int main(int argc, char* argv[]) {
+	CommandLineArgs args(argc, argv);
+
+	Int generators = args.options.count("gen") ? Int(args.options["gen"]) : 4;
+	Bool implicit = args.options_bool["implicit"];
+
+	RunResult single = simulate("DP_SynGenDq7odODE_PerComponent", generators, false, implicit);
+	RunResult aggregated = simulate("DP_SynGenDq7odODE_Aggregated", generators, true, implicit);
+
+	// The step size control of the aggregated solver acts on all states together,
+	// so the results only agree within the integration tolerances
+	Real maxOmegaDeviation = 0, maxCurrentDeviation = 0;
+	for (UInt k = 0; k < single.omegas.size(); k++) {
+		for (Int i = 0; i < generators; i++) {
+			maxOmegaDeviation = std::max(maxOmegaDeviation,
+				std::abs(single.omegas[k][i] - aggregated.omegas[k][i]) / std::abs(single.omegas[k][i]));
+			maxCurrentDeviation = std::max(maxCurrentDeviation,
+				std::abs(single.currents[k][i] - aggregated.currents[k][i]) / std::max(std::abs(single.currents[k][i]), 1.));
+		}
+	}
+
+	std::cout << generators << " generators, " << (implicit ? "implicit" : "explicit") << " integration" << std::endl;
+	std::cout << "Per component solvers: " << single.seconds << " s" << std::endl;
+	std::cout << "Aggregated solver: " << aggregated.seconds << " s" << std::endl;
+	std::cout << "Maximum relative deviation of w_r: " << maxOmegaDeviation << std::endl;
+	std::cout << "Maximum relative deviation of i_intf: " << maxCurrentDeviation << std::endl;
+
+	return maxOmegaDeviation < 1e-6 && maxCurrentDeviation < 1e-3 ? 0 : 1;
+}
@@ -11,39 +11,134 @@
 #include <map>
 #include <iostream>
 #include <fstream>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <experimental/filesystem>
 namespace fs = std::experimental::filesystem;
 
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
+#include <dpsim/RingBuffer.h>
 #include <cps/PtrFactory.h>
 #include <cps/Attribute.h>
+#include <cps/AttributeList.h>
 #include <cps/SimNode.h>
 #include <cps/Task.h>
 
 namespace DPsim {
 
-	class DataLogger : public SharedFactory<DataLogger> {
+	class DataLogger :
+		public SharedFactory<DataLogger>,
+		public CPS::AttributeList {
+
+	public:
+		/// File format of the logged data
+		enum class Format {
+			/// Comma separated text with one line per time step
+			CSV,
+			/// Header with column names and types followed by fixed-width binary rows
+			Binary
+		};
+
+		/// Behaviour of asynchronous logging when the ring buffer is full
+		enum class OverflowPolicy {
+			/// Discard the row of the current time step
+			Drop,
+			/// Wait until the I/O thread has written a row
+			Block,
+			/// Queue the row in a growing overflow buffer
+			Grow
+		};
 
 	protected:
 		std::ofstream mLogFile;
 		String mName;
 		Bool mEnabled;
 		UInt mDownsampling;
+		Format mFormat = Format::CSV;
 		fs::path mFilename;
 
 		std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+		/// File descriptor of the binary log file
+		int mFd = -1;
+		/// File offset of the next flushed row
+		std::int64_t mFileOffset = 0;
+		/// Rows which have not been written to the file yet
+		std::vector<char> mBuffer;
+		/// Number of valid bytes in mBuffer
+		std::size_t mBufferUsed = 0;
+
+		/// Logged attribute, one of the pointers is set
+		struct Column {
+			CPS::Attribute<Real>::Ptr real;
+			CPS::Attribute<Int>::Ptr integer;
+		};
+		/// Logged attributes in column order
+		std::vector<Column> mColumns;
+		/// Row index and address of the values which can be read directly from memory
+		std::vector<std::pair<std::size_t, const Real*>> mRealAddresses;
+		std::vector<std::pair<std::size_t, const Int*>> mIntAddresses;
+		/// Row index of the values which are only available through a getter
+		std::vector<std::size_t> mGetterColumns;
+		/// Binary rows can be written as a whole if there are no Int columns
+		Bool mIntegerColumns = false;
+		/// Columns are compiled and the header is written by start()
+		Bool mColumnsReady = false;
+		/// Values of the current row, starting with the time
+		std::vector<Real> mRow;
+
+		/// Rows are written by a separate I/O thread
+		Bool mAsync = false;
+		/// Number of rows in the ring buffer
+		UInt mRingCapacity = 4096;
+		OverflowPolicy mOverflowPolicy = OverflowPolicy::Block;
+		/// Rows captured by the simulation and written by the I/O thread
+		RowRingBuffer mRing;
+		/// Rows which did not fit into the ring buffer with OverflowPolicy::Grow
+		std::vector<Real> mOverflowRows;
+		std::mutex mOverflowMutex;
+		/// Set while mOverflowRows contains rows, newer rows must not enter the ring
+		std::atomic<Bool> mOverflowing{false};
+		std::thread mWriter;
+		std::atomic<Bool> mStopWriter{false};
+		/// Number of time steps at which the ring buffer was full
+		std::atomic<Int> mOverruns{0};
+		/// Number of rows discarded by OverflowPolicy::Drop
+		std::atomic<Int> mDropped{0};
+
 		void logDataLine(Real time, Real data);
 		void logDataLine(Real time, const Matrix& data);
 		void logDataLine(Real time, const MatrixComp& data);
 
+		/// Returns true if no header has been written yet
+		Bool isEmpty();
+		/// Writes the binary header with the names and type codes ('f' or 'i') of all columns
+		void writeBinaryHeader(const std::vector<String> &names, const std::vector<char> &types);
+		/// Appends raw row data to the buffer of the binary log file
+		void writeBinary(const void *data, std::size_t size);
+		/// Writes the buffered rows to the binary log file
+		void flushBinary();
+
+		/// Copies the time and the values of all logged attributes into a row
+		void captureRow(Real time, Real *row);
+		/// Writes a row in the file format of the logger
+		void writeRow(const Real *row);
+		/// Writes all rows captured so far, returns the number of written rows
+		std::size_t drainRows();
+		/// Loop of the I/O thread
+		void runWriter();
+		void stopWriter();
+
 	public:
 		typedef std::shared_ptr<DataLogger> Ptr;
 		typedef std::vector<DataLogger::Ptr> List;
 
 		DataLogger(Bool enabled = true);
-		DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
+		DataLogger(String name, Bool enabled = true, UInt downsampling = 1, Format format = Format::CSV);
+		~DataLogger();
 
 		void open();
 		void close();
@@ -57,6 +152,15 @@ namespace DPsim {
 
 		void setColumnNames(std::vector<String> names);
 
+		/// Write the logged attributes from a separate I/O thread.
+		/// The log task only copies the values into a ring buffer with the given number of rows.
+		/// Only applies to log(), the other logging methods still write synchronously.
+		void doAsync(Bool async = true, UInt capacity = 4096, OverflowPolicy policy = OverflowPolicy::Block) {
+			mAsync = async;
+			mRingCapacity = capacity > 0 ? capacity : 1;
+			mOverflowPolicy = policy;
+		}
+
 		void addAttribute(const String &name, CPS::AttributeBase::Ptr attr);
 		void addAttribute(const String &name, CPS::Attribute<Int>::Ptr attr);
 		void addAttribute(const String &name, CPS::Attribute<Real>::Ptr attr);
@@ -74,6 +178,10 @@ namespace DPsim {
 			addAttribute(node->name() + ".voltage", node->attributeMatrix("voltage"));
 		}
 
+		/// Compiles the logged attributes into a flat list of memory addresses,
+		/// writes the header and starts the I/O thread of the asynchronous mode.
+		/// Called when the simulation starts, after all attributes are initialized.
+		void start();
 		void log(Real time, Int timeStepCount);
 
 		CPS::Task::Ptr getTask();
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 #include <queue>
 
 #include <dpsim/Config.h>
@@ -37,6 +38,9 @@ namespace DPsim {
 
 		virtual void execute() = 0;
 
+		/// Simulation time at which the event is executed
+		CPS::Real time() const { return mTime; }
+
 		Event(CPS::Real t) :
 			mTime(t)
 		{ }
@@ -84,6 +88,11 @@ namespace DPsim {
 			mNewState(state)
 		{ }
 
+		/// Switch that is operated by the event
+		const std::shared_ptr<CPS::Base::Ph1::Switch>& switchComponent() const { return mSwitch; }
+		/// State of the switch after the event, true if closed
+		CPS::Bool newState() const { return mNewState; }
+
 		void execute() {
 			if (mNewState)
 				mSwitch->close();
@@ -107,6 +116,11 @@ namespace DPsim {
 			mNewState(state)
 		{ }
 
+		/// Switch that is operated by the event
+		const std::shared_ptr<CPS::Base::Ph3::Switch>& switchComponent() const { return mSwitch; }
+		/// State of the switch after the event, true if closed
+		CPS::Bool newState() const { return mNewState; }
+
 		void execute() {
 			if (mNewState)
 				mSwitch->closeSwitch();
@@ -126,6 +140,10 @@ namespace DPsim {
 		void addEvent(Event::Ptr e);
 		///
 		void handleEvents(CPS::Real currentTime);
+		/// Returns the queued events ordered by time
+		std::vector<Event::Ptr> events() const;
+		/// Time of the next queued event, infinity if there is none
+		CPS::Real nextEventTime() const;
 	};
 }
 
@@ -0,0 +1,107 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <cps/Solver/MNAInterface.h>
+#include <cps/Solver/MNADQMachineBatchInterface.h>
+#include <cps/IdentifiedObject.h>
+#include <cps/PtrFactory.h>
+
+namespace DPsim {
+	/// Integrates the flux and rotor dynamics of many three-phase dynamic phasor
+	/// generators with a dq0 state space model in a single pre and post step task.
+	///
+	/// The parameters and states of the machines are stored as structure of arrays,
+	/// one array of all machines per state and matrix entry, so that every operation
+	/// of the step is a loop over contiguous memory. With the trapezoidal rule, the
+	/// matrices I - dt/2 A of all machines are factorized together every step without
+	/// pivoting. Machines are therefore only added if this matrix is diagonally dominant
+	/// for rotor speeds between standstill and twice the nominal speed. All machines of
+	/// a bank use the numerical method of the first one. The states are written back
+	/// to the machines after each step, so that their attributes can still be logged
+	/// and interfaced, and the machines stamp their own right side vector.
+	class MnaDQMachineBank :
+		public CPS::IdentifiedObject,
+		public CPS::MNAInterface,
+		public SharedFactory<MnaDQMachineBank> {
+	public:
+		typedef std::shared_ptr<MnaDQMachineBank> Ptr;
+
+		MnaDQMachineBank(String name) : IdentifiedObject(name) { }
+
+		/// Adds an initialized machine, returns false if it cannot be batched
+		Bool addMachine(CPS::MNAInterface::Ptr machine);
+		/// Number of machines in the bank
+		UInt size() const { return static_cast<UInt>(mMachines.size()); }
+
+		// #### MNA section ####
+		/// Sets up the arrays and tasks, must be called after all machines were added
+		void mnaInitialize(Real omega, Real timeStep, CPS::Attribute<Matrix>::Ptr leftVector);
+		/// Advances the rotor speeds, angles and fluxes and updates the interface currents
+		void mnaPreStep(Real time, Int timeStepCount);
+		/// Updates the interface voltages from the solution
+		void mnaPostStep(Real time, Int timeStepCount, CPS::Attribute<Matrix>::Ptr &leftVector);
+
+		class MnaPreStep : public CPS::Task {
+		public:
+			MnaPreStep(MnaDQMachineBank& bank);
+			void execute(Real time, Int timeStepCount) { mBank.mnaPreStep(time, timeStepCount); }
+		private:
+			MnaDQMachineBank& mBank;
+		};
+
+		class MnaPostStep : public CPS::Task {
+		public:
+			MnaPostStep(MnaDQMachineBank& bank, CPS::Attribute<Matrix>::Ptr leftVector);
+			void execute(Real time, Int timeStepCount) { mBank.mnaPostStep(time, timeStepCount, mLeftVector); }
+		private:
+			MnaDQMachineBank& mBank;
+			CPS::Attribute<Matrix>::Ptr mLeftVector;
+		};
+
+	private:
+		static const Int S = CPS::MNADQMachineBatchInterface::NumStates;
+
+		/// Pointer to the array of entry (i, j) of a per machine matrix
+		Real* entry(std::vector<Real>& mat, Int i, Int j) { return &mat[(i * S + j) * mMachines.size()]; }
+		/// Pointer to the array of entry i of a per machine vector
+		template <typename T>
+		T* entry(std::vector<T>& vec, Int i) { return &vec[i * mMachines.size()]; }
+
+		/// Integrates the fluxes with the trapezoidal rule
+		void stepTrapezoidal();
+		/// Integrates the fluxes with forward Euler
+		void stepEuler();
+
+		CPS::MNAInterface::List mMachines;
+		std::vector<CPS::MNADQMachineBatchInterface::Ptr> mBatchMachines;
+		std::vector<CPS::MNADQMachineBatchInterface::DQMachineBatchModel> mModels;
+		Bool mTrapezoidal = true;
+		Real mTimeStep = 0;
+		/// Offset of the imaginary parts in the solution vector
+		Int mImagOffset = 0;
+
+		// Parameters as structure of arrays
+		std::vector<Real> mBaseOmElec, mBaseOmMech, mBaseVoltage, mBaseCurrent;
+		std::vector<Real> mInertia, mMechTorque;
+		std::vector<Real> mFluxStateMat, mOmegaFluxMat, mFluxToCurrentMat;
+		std::vector<Int> mNodes;
+
+		// States as structure of arrays
+		std::vector<Real> mOmega, mTheta, mElecTorque;
+		std::vector<Real> mFluxes, mCurrents, mVoltages;
+		std::vector<Real> mVoltRe, mVoltIm, mCurrRe, mCurrIm;
+
+		// Workspace of the flux step
+		std::vector<Real> mStateMat, mLu, mRhs;
+	};
+}
@@ -0,0 +1,96 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <cps/Solver/MNAInterface.h>
+#include <cps/Solver/MNABatchInterface.h>
+#include <cps/IdentifiedObject.h>
+#include <cps/PtrFactory.h>
+
+namespace DPsim {
+	/// Executes the MNA pre and post steps of many linear dynamic phasor
+	/// components of the same type with a single task each.
+	///
+	/// The companion models of the components are stored as structure of arrays,
+	/// so that the history currents and interface currents of all components
+	/// are updated in plain loops over contiguous memory. The interface voltages
+	/// and currents are written back to the components after each step.
+	/// The batch replaces its components in the list of MNA components of the
+	/// solver and forwards the system matrix stamps to them.
+	class MnaLinearBatch :
+		public CPS::IdentifiedObject,
+		public CPS::MNAInterface,
+		public SharedFactory<MnaLinearBatch> {
+	public:
+		typedef std::shared_ptr<MnaLinearBatch> Ptr;
+
+		MnaLinearBatch(String name) : IdentifiedObject(name) { }
+
+		/// Adds an initialized component, returns false if it cannot be batched
+		Bool addComponent(CPS::MNAInterface::Ptr comp);
+		/// Number of components in the batch
+		UInt size() const { return static_cast<UInt>(mComponents.size()); }
+		/// Components in the batch in the order of their arrays
+		const CPS::MNAInterface::List& components() const { return mComponents; }
+
+		// #### MNA section ####
+		/// Sets up the source vector and tasks, must be called after all components were added
+		void mnaInitialize(Real omega, Real timeStep, CPS::Attribute<Matrix>::Ptr leftVector);
+		/// Stamps the system matrix of all components
+		void mnaApplySystemMatrixStamp(CPS::SparseMatrixRow& systemMatrix);
+		/// Stamps the source vector of all components
+		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
+		/// Updates the history currents and stamps them into the source vector
+		void mnaPreStep(Real time, Int timeStepCount);
+		/// Updates the interface voltages and currents from the solution
+		void mnaPostStep(Real time, Int timeStepCount, CPS::Attribute<Matrix>::Ptr &leftVector);
+
+		class MnaPreStep : public CPS::Task {
+		public:
+			MnaPreStep(MnaLinearBatch& batch);
+			void execute(Real time, Int timeStepCount) { mBatch.mnaPreStep(time, timeStepCount); }
+		private:
+			MnaLinearBatch& mBatch;
+		};
+
+		class MnaPostStep : public CPS::Task {
+		public:
+			MnaPostStep(MnaLinearBatch& batch, CPS::Attribute<Matrix>::Ptr leftVector);
+			void execute(Real time, Int timeStepCount) { mBatch.mnaPostStep(time, timeStepCount, mLeftVector); }
+		private:
+			MnaLinearBatch& mBatch;
+			CPS::Attribute<Matrix>::Ptr mLeftVector;
+		};
+
+	private:
+		/// Components in the order of the arrays, components with history current first
+		CPS::MNAInterface::List mComponents;
+		std::vector<CPS::MNABatchInterface::MnaBatchModel> mModels;
+		/// Number of components with history current
+		UInt mNumHistory = 0;
+		/// Offset of the imaginary parts in the source and solution vectors
+		Int mImagOffset = 0;
+
+		// Companion models as structure of arrays
+		std::vector<Int> mNode0;
+		std::vector<Int> mNode1;
+		/// Positions of the real and imaginary node rows in the stored source vector stamp
+		std::vector<Int> mPos0, mPos0Im;
+		std::vector<Int> mPos1, mPos1Im;
+		std::vector<Real> mCondRe, mCondIm;
+		std::vector<Real> mVoltCoeffRe, mVoltCoeffIm;
+		std::vector<Real> mCurrCoeffRe, mCurrCoeffIm;
+		std::vector<Real> mHistRe, mHistIm;
+		std::vector<Real> mVoltRe, mVoltIm;
+		std::vector<Real> mCurrRe, mCurrIm;
+	};
+}
@@ -0,0 +1,84 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Definitions.h>
+#include <cps/Solver/MNAInterface.h>
+#include <cps/Solver/MNAMachineBatchInterface.h>
+#include <cps/IdentifiedObject.h>
+#include <cps/PtrFactory.h>
+
+namespace DPsim {
+	/// Integrates the rotor dynamics of many dynamic phasor generators of the
+	/// same type with a single pre and post step task.
+	///
+	/// The states of the machines are stored as structure of arrays and advanced
+	/// in plain loops over contiguous memory. They are written back to the machines
+	/// after each step, so that the attributes of the machines can still be logged
+	/// and interfaced. In contrast to MnaLinearBatch, the machines stay in the list
+	/// of MNA components of the solver, as only their own pre and post steps are
+	/// replaced while the tasks of their inner components are kept.
+	class MnaMachineBank :
+		public CPS::IdentifiedObject,
+		public CPS::MNAInterface,
+		public SharedFactory<MnaMachineBank> {
+	public:
+		typedef std::shared_ptr<MnaMachineBank> Ptr;
+
+		MnaMachineBank(String name) : IdentifiedObject(name) { }
+
+		/// Adds an initialized machine, returns false if it cannot be batched
+		Bool addMachine(CPS::MNAInterface::Ptr machine);
+		/// Number of machines in the bank
+		UInt size() const { return static_cast<UInt>(mMachines.size()); }
+
+		// #### MNA section ####
+		/// Sets up the arrays and tasks, must be called after all machines were added
+		void mnaInitialize(Real omega, Real timeStep, CPS::Attribute<Matrix>::Ptr leftVector);
+		/// Advances the rotor speeds and angles and updates the emfs of the inner voltage sources
+		void mnaPreStep(Real time, Int timeStepCount);
+		/// Updates the interface voltages and currents from the solution
+		void mnaPostStep(Real time, Int timeStepCount, CPS::Attribute<Matrix>::Ptr &leftVector);
+
+		class MnaPreStep : public CPS::Task {
+		public:
+			MnaPreStep(MnaMachineBank& bank);
+			void execute(Real time, Int timeStepCount) { mBank.mnaPreStep(time, timeStepCount); }
+		private:
+			MnaMachineBank& mBank;
+		};
+
+		class MnaPostStep : public CPS::Task {
+		public:
+			MnaPostStep(MnaMachineBank& bank, CPS::Attribute<Matrix>::Ptr leftVector);
+			void execute(Real time, Int timeStepCount) { mBank.mnaPostStep(time, timeStepCount, mLeftVector); }
+		private:
+			MnaMachineBank& mBank;
+			CPS::Attribute<Matrix>::Ptr mLeftVector;
+		};
+
+	private:
+		CPS::MNAInterface::List mMachines;
+		std::vector<CPS::MNAMachineBatchInterface::MachineBatchModel> mModels;
+		Real mTimeStep = 0;
+		/// Offset of the imaginary parts in the solution vector
+		Int mImagOffset = 0;
+
+		// Parameters and states as structure of arrays
+		std::vector<Real> mNomOmega, mNomPower, mDamping, mEmfAbs;
+		std::vector<Real> mConvert;
+		std::vector<Real> mInertia, mMechPower, mIntegrate;
+		std::vector<Real> mOmega, mDelta, mElecPower, mOmegaDeriv;
+		std::vector<Real> mEmfRe, mEmfIm;
+		std::vector<Real> mVoltRe, mVoltIm;
+		std::vector<Real> mCurrRe, mCurrIm;
+	};
+}
@@ -12,11 +12,14 @@
 #include <vector>
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <bitset>
+#include <set>
 
 #include <dpsim/Config.h>
 #include <dpsim/Solver.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/Event.h>
 #include <cps/AttributeList.h>
 #include <cps/Solver/MNASwitchInterface.h>
 #include <cps/Solver/MNAVariableCompInterface.h>
@@ -80,8 +83,8 @@ namespace DPsim {
 
 		/// Source vector of known quantities
 		Matrix mRightSideVector;
-		/// List of all right side vector contributions
-		std::vector<const Matrix*> mRightVectorStamps;
+		/// List of all components with right side vector contributions
+		std::vector<const CPS::MNAInterface*> mRightVectorStamps;
 		/// Solution vector of unknown quantities
 		Matrix mLeftSideVector;
 				
@@ -101,6 +104,51 @@ namespace DPsim {
 		/// Collects the status of switches to select correct system matrix
 		void updateSwitchStatus();
 
+		// #### Switch configuration cache ####
+		/// Build the system matrices of switch configurations on first use
+		/// instead of precomputing all 2^n configurations. A configuration that
+		/// has not been warmed up is then built and factorized in the solve task.
+		Bool mLazySwitchedMatrices = false;
+		/// Memory budget of the cached system matrices and factorizations in bytes, 0 means unlimited
+		std::size_t mSwitchCacheMemoryBudget = 0;
+		/// Memory currently used by the cached switch configurations in bytes
+		std::size_t mSwitchCacheMemory = 0;
+		/// Cached switch configurations ordered from most to least recently used
+		std::list< std::bitset<SWITCH_NUM> > mSwitchCacheOrder;
+		/// Position of the cached switch configurations in the LRU list
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::list< std::bitset<SWITCH_NUM> >::iterator > mSwitchCacheIndex;
+		/// Memory used by each cached switch configuration in bytes
+		std::unordered_map< std::bitset<SWITCH_NUM>, std::size_t > mSwitchCacheEntryMemory;
+		/// Switch configuration used by the solve task, which is never evicted
+		std::bitset<SWITCH_NUM> mRequiredSwitchStatus;
+		/// Indicates that the required switch configuration is available in the cache
+		Bool mRequiredSwitchStatusValid = false;
+		/// Number of switched system matrices that have been built and factorized
+		Int mNumSwitchedMatrixBuilds = 0;
+		/// Number of switched system matrices that have been evicted from the cache
+		Int mNumSwitchedMatrixEvictions = 0;
+
+		/// Returns true if all switch configurations are computed during initialization
+		Bool precomputesSwitchedMatrices() const { return !mLazySwitchedMatrices || mFrequencyParallel; }
+		/// Builds the given switch configuration if required and marks it as most recently used
+		void requireSwitchedMatrix(std::bitset<SWITCH_NUM> status);
+		/// Builds and factorizes the system matrix of the given switch configuration
+		void buildSwitchedMatrix(std::bitset<SWITCH_NUM> status);
+		/// Removes least recently used configurations until the memory budget is met
+		void evictSwitchedMatrices();
+		/// Removes all cached switch configurations
+		void clearSwitchedMatrices();
+
+		// #### Batched linear components ####
+		/// Execute the MNA steps of linear components of the same type in batches
+		Bool mBatchLinearComponents = false;
+		/// Replaces the batchable components in the component list by one batch per component type
+		void batchLinearComponents();
+		/// Integrate the rotor dynamics of generators of the same type in banks
+		Bool mBatchMachines = false;
+		/// Adds one bank per generator type to the component list
+		void batchMachines();
+
 		// #### Attributes related to logging ####
 		/// Last simulation time step when log was updated
 		Int mLastLogTimeStep = 0;
@@ -116,6 +164,16 @@ namespace DPsim {
 
 		/// Initialization of individual components
 		void initializeComponents();
+		/// Adds the right side vector contribution of a component to the list of stamps
+		void addRightVectorStamp(CPS::MNAInterface::Ptr comp);
+		/// Sets the right side vector rows that an initialized component can stamp, so that
+		/// only these rows of its contribution are stored
+		void initializeRightVectorRows(CPS::MNAInterface::Ptr comp);
+		/// Determines the right side vector rows that a component and its subcomponents can stamp
+		/// from their terminal and virtual nodes. Returns the matrix node indices of the component.
+		std::set<UInt> assignRightVectorRows(typename CPS::SimPowerComp<VarType>::Ptr comp);
+		/// Sums the right side vector contributions of all components
+		void sumRightVectorStamps();
 		/// Initialization of system matrices and source vector
 		virtual void initializeSystem();
 		/// Initialization of system matrices and source vector
@@ -136,6 +194,12 @@ namespace DPsim {
 		void createEmptyVectors();
 		/// Create system matrix
 		virtual void createEmptySystemMatrix() = 0;
+		/// Allocates the system matrix and factorization for the given switch index
+		virtual void switchedMatrixCreate(std::size_t index) = 0;
+		/// Frees the system matrix and factorization for the given switch index
+		virtual void switchedMatrixErase(std::size_t index) = 0;
+		/// Returns the memory used by the system matrix and factorization for the given switch index in bytes
+		virtual std::size_t switchedMatrixMemory(std::size_t index) = 0;
 		/// Sets all entries in the matrix with the given switch index to zero
 		virtual void switchedMatrixEmpty(std::size_t index) = 0;
 		/// Sets all entries in the matrix with the given switch index and frequency index to zero
@@ -181,5 +245,18 @@ namespace DPsim {
 		///
 		virtual CPS::Task::List getTasks() override;
 
+		// #### Switch configuration cache ####
+		/// Build all switch configurations during initialization (default) instead of on first use
+		void doPrecomputeSwitchedMatrices(Bool value) { mLazySwitchedMatrices = !value; }
+		/// Set memory budget of the cached switch configurations in bytes, 0 means unlimited
+		void setSwitchCacheMemoryBudget(std::size_t bytes) { mSwitchCacheMemoryBudget = bytes; }
+		/// Builds the switch configurations reached by the given events if they are
+		/// built on first use. Must be called before the simulation starts.
+		virtual void warmUpSwitchedMatrices(const std::vector<Event::Ptr>& events);
+
+		/// Execute the MNA steps of linear dynamic phasor components of the same type in batches
+		void doBatchLinearComponents(Bool value) { mBatchLinearComponents = value; }
+		/// Integrate the rotor dynamics of dynamic phasor generators of the same type in banks
+		void doBatchMachines(Bool value) { mBatchMachines = value; }
 	};
 }
@@ -53,6 +53,12 @@ namespace DPsim {
 
 		/// Create system matrix
 		virtual void createEmptySystemMatrix() override;
+		/// Allocates the system matrix and factorization for the given switch index
+		virtual void switchedMatrixCreate(std::size_t index) override;
+		/// Frees the system matrix and factorization for the given switch index
+		virtual void switchedMatrixErase(std::size_t index) override;
+		/// Returns the memory used by the system matrix and factorization for the given switch index in bytes
+		virtual std::size_t switchedMatrixMemory(std::size_t index) override;
 		/// Sets all entries in the matrix with the given switch index to zero
 		virtual void switchedMatrixEmpty(std::size_t index) override;
 		/// Sets all entries in the matrix with the given switch index and frequency index to zero
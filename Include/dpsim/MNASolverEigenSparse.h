@@ -39,6 +39,12 @@ namespace DPsim {
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector<SparseMatrix> > mSwitchedMatrices;
 		/// Map of LU factorizations related to the system matrices
 		std::unordered_map< std::bitset<SWITCH_NUM>, std::vector< std::shared_ptr< CPS::LUFactorizedSparse> > > mLuFactorizations;
+		/// Number of entries reserved per matrix row before the components are stamped
+		Int mNumReservedRowEntries = 16;
+		/// Row-permuted right side vector that the factorization is applied to in place
+		CPS::Vector mPermutedRightSideVector;
+		/// Workspace of the supernodal forward substitution
+		CPS::Vector mForwardSubstitutionWorkspace;
 
 		using MnaSolver<VarType>::mSwitches;
 		using MnaSolver<VarType>::mRightSideVector;
@@ -60,8 +66,17 @@ namespace DPsim {
 		virtual void switchedMatrixEmpty(std::size_t swIdx, Int freqIdx) override;
 		/// Create system matrix
 		virtual void createEmptySystemMatrix() override;
+		/// Allocates the system matrix and factorization for the given switch index
+		virtual void switchedMatrixCreate(std::size_t index) override;
+		/// Frees the system matrix and factorization for the given switch index
+		virtual void switchedMatrixErase(std::size_t index) override;
+		/// Returns the memory used by the system matrix and factorization for the given switch index in bytes
+		virtual std::size_t switchedMatrixMemory(std::size_t index) override;
 		/// Applies a component stamp to the matrix with the given switch index
 		virtual void switchedMatrixStamp(std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>>& comp) override;
+		/// Reserves row storage so that component stamps are inserted in place.
+		/// The matrix is compressed once after all stamps have been applied.
+		void reserveSystemMatrix(SparseMatrix& systemMatrix);
 		/// Create a solve task for this solver implementation
 		virtual std::shared_ptr<CPS::Task> createSolveTask() override;
 		/// Create a solve task for this solver implementation
@@ -70,6 +85,9 @@ namespace DPsim {
 		virtual std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) override;
 		/// Logging of system matrices and source vector
 		virtual void logSystemMatrices() override;
+		/// Solves the system with the given factorization for mRightSideVector into mLeftSideVector.
+		/// In contrast to SparseLU::solve, all temporaries are preallocated.
+		void solveInPlace(const CPS::LUFactorizedSparse& lu);
 
 		// #### Scheduler Task Methods ####
 		/// Solves system for single frequency
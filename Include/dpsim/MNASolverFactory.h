@@ -13,6 +13,7 @@
 #include <dpsim/MNASolverEigenDense.h>
 #ifdef WITH_SPARSE
 #include <dpsim/MNASolverEigenSparse.h>
+#include <dpsim/MNASolverWoodbury.h>
 #endif
 #ifdef WITH_CUDA
 	#include <dpsim/MNASolverGpuDense.h>
@@ -37,6 +38,7 @@ class MnaSolverFactory {
 		CUDADense,
 		CUDASparse,
 		CUDAMagma,
+		EigenSparseWoodbury,
 	};
 
 	/// MNA implementations supported by this compilation
@@ -44,6 +46,8 @@ class MnaSolverFactory {
 		static std::vector<MnaSolverImpl> ret = {
 			EigenDense,
 #ifdef WITH_SPARSE
+			/* Listed before EigenSparse to keep it as default */
+			EigenSparseWoodbury,
 			EigenSparse,
 #endif //WITH_SPARSE
 #ifdef WITH_CUDA
@@ -81,6 +85,9 @@ class MnaSolverFactory {
 		case MnaSolverImpl::EigenSparse:
 			log->info("creating EigenSparse solver implementation");
 			return std::make_shared<MnaSolverEigenSparse<VarType>>(name, domain, logLevel);
+		case MnaSolverImpl::EigenSparseWoodbury:
+			log->info("creating EigenSparseWoodbury solver implementation");
+			return std::make_shared<MnaSolverWoodbury<VarType>>(name, domain, logLevel);
 #endif
 #ifdef WITH_CUDA
 		case MnaSolverImpl::CUDADense:
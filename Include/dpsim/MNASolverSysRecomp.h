@@ -15,6 +15,8 @@ namespace DPsim {
 	template <typename VarType>
 	class MnaSolverSysRecomp : public MnaSolverEigenSparse<VarType> {
 	protected:
+		/// Create the single system matrix that is recomputed
+		virtual void createEmptySystemMatrix() override;
 		/// Initialization of system matrices and source vector
 		virtual void initializeSystem() override;
 		///
@@ -29,6 +31,51 @@ namespace DPsim {
 		void updateVariableCompStatus();
 		/// Initialization of system matrices and source vector
 		void initializeSystemWithDynamicMatrix();
+		/// Extends the sparsity pattern of the base matrix by the entries of the given matrix
+		void extendBasePattern(const SparseMatrix& systemMatrix);
+		/// Recomputes the symbolic analysis of the system matrix
+		void analyzeSystemMatrixPattern();
+		/// Factorizes the system matrix and prepares the low-rank updates against it
+		void factorizeSystemMatrix();
+
+		// #### Low-rank updates ####
+		/// Maximum number of rows and columns of the system matrix touched by the
+		/// variable components for which their changes are applied as low-rank
+		/// updates instead of refactorizations, 0 disables the updates
+		UInt mMaxUpdateRank = 0;
+		/// Rows and columns of the system matrix stamped by the variable components
+		std::vector<UInt> mPortIndices;
+		/// Values of the factorized system matrix at the port indices
+		Matrix mFactorizedPortBlock;
+		/// Solutions of the factorized system for the unit vectors of the port indices
+		Matrix mPortSolutions;
+		/// Change of the system matrix at the port indices since the last factorization
+		Matrix mPortDelta;
+		/// Factorization of I + D * Z_P, where Z are the port solutions
+		Eigen::PartialPivLU<Matrix> mPortCapacitance;
+		/// Rows of the port solutions at the port indices
+		Matrix mPortSolutionRows;
+		/// Preallocated workspace of the size of the port count
+		Matrix mPortReduced;
+		/// Preallocated workspace of the size of the port count
+		Matrix mPortWeights;
+		/// Set if the current system matrix differs from the factorized one
+		Bool mPortUpdateActive = false;
+		/// Collects the port indices from the stamps of the variable components
+		void collectPortIndices();
+		/// Applies the changes of the variable components as a low-rank update of the
+		/// factorized system matrix, returns false if a refactorization is required
+		Bool updatePortCorrection();
+
+		// #### Refactorization statistics ####
+		/// Number of numeric refactorizations of the system matrix
+		Int mNumRefactorizations = 0;
+		/// Number of symbolic analyses of the system matrix
+		Int mNumPatternAnalyses = 0;
+		/// Number of low-rank updates of the system matrix
+		Int mNumLowRankUpdates = 0;
+		/// Accumulated time spent in restamping and refactorizing or updating in seconds
+		Real mRefactorizationTime = 0;
 
 	public:
 		///
@@ -39,6 +86,9 @@ namespace DPsim {
 		virtual ~MnaSolverSysRecomp() { };
 		///
 		virtual CPS::Task::List getTasks() override;
+		/// Applies changes of variable components as low-rank updates of the
+		/// factorized system matrix if they touch at most maxRank rows and columns
+		void setMaxUpdateRank(UInt maxRank) { mMaxUpdateRank = maxRank; }
 
 		// #### MNA Solver Tasks ####
 		///
@@ -0,0 +1,117 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+#include <dpsim/MNASolverEigenSparse.h>
+
+namespace DPsim {
+
+	/// Solver class using Modified Nodal Analysis (MNA) that factorizes only
+	/// the system matrix of the initial switch configuration.
+	///
+	/// Switch state changes are applied as low-rank corrections using the
+	/// Sherman-Morrison-Woodbury identity. The corrections of the most recently
+	/// used switch configurations are kept in a LRU cache. In contrast to the
+	/// precomputed solvers, memory and initialization time do not grow
+	/// exponentially with the number of switches and the number of switches is
+	/// not limited by SWITCH_NUM.
+	template <typename VarType>
+	class MnaSolverWoodbury : public MnaSolverEigenSparse<VarType> {
+	public:
+		/// Switch status with one entry per switch
+		using SwitchStatus = std::vector<bool>;
+
+	protected:
+		/// Low-rank correction of the base system matrix for a switch configuration
+		struct SwitchCorrection {
+			/// Matrix indices affected by the switches that differ from the base configuration
+			std::vector<UInt> indices;
+			/// Change of the system matrix restricted to the affected indices
+			Matrix delta;
+			/// Solutions of the base system for unit vectors at the affected indices
+			Matrix baseSolutions;
+			/// LU factorization of the capacitance matrix (I + delta * baseSolutions(indices, :))
+			CPS::LUFactorized capacitance;
+			/// Preallocated workspace of the size of the correction rank
+			Matrix reduced;
+			/// Preallocated workspace of the size of the correction rank
+			Matrix weights;
+		};
+
+		/// Switch status for which the base system matrix was factorized
+		SwitchStatus mBaseSwitchStatus;
+		/// Current switch status
+		SwitchStatus mSwitchStatus;
+		/// Change of the system matrix if a switch deviates from its base status
+		std::vector<SparseMatrix> mSwitchDeltas;
+		/// Correction for the current switch status or null if it equals the base status
+		std::shared_ptr<SwitchCorrection> mActiveCorrection;
+
+		/// Maximum number of cached switch configurations
+		UInt mSwitchCacheSize = 16;
+		/// Cached corrections ordered from most to least recently used
+		std::list< std::pair<SwitchStatus, std::shared_ptr<SwitchCorrection>> > mCorrectionCache;
+		/// Lookup of cached corrections by switch status
+		std::unordered_map<SwitchStatus,
+			typename std::list< std::pair<SwitchStatus, std::shared_ptr<SwitchCorrection>> >::iterator> mCorrectionCacheIndex;
+		/// Number of switch configuration changes served from the cache
+		Int mSwitchCacheHits = 0;
+		/// Number of switch configuration changes that required a new correction
+		Int mSwitchCacheMisses = 0;
+
+		using MnaSolverEigenSparse<VarType>::mSwitchedMatrices;
+		using MnaSolverEigenSparse<VarType>::mLuFactorizations;
+		using MnaSolverEigenSparse<VarType>::mSwitches;
+		using MnaSolverEigenSparse<VarType>::mMNAComponents;
+		using MnaSolverEigenSparse<VarType>::mRightSideVector;
+		using MnaSolverEigenSparse<VarType>::mLeftSideVector;
+		using MnaSolverEigenSparse<VarType>::mRightVectorStamps;
+		using MnaSolverEigenSparse<VarType>::mNumNetNodes;
+		using MnaSolverEigenSparse<VarType>::mNodes;
+		using MnaSolverEigenSparse<VarType>::mIsInInitialization;
+		using MnaSolverEigenSparse<VarType>::mFrequencyParallel;
+		using MnaSolverEigenSparse<VarType>::mSLog;
+
+		/// Create system matrix for the base switch configuration only
+		virtual void createEmptySystemMatrix() override;
+		/// Initialization of system matrices and source vector
+		virtual void initializeSystem() override;
+		/// Logging of system matrices and source vector
+		virtual void logSystemMatrices() override;
+		/// Collects the status of switches and selects the matching correction
+		void updateSwitchCorrection();
+		/// Returns the correction for the given switch status from the cache or computes it
+		std::shared_ptr<SwitchCorrection> switchCorrection(const SwitchStatus& status);
+		/// Computes the low-rank correction for the given switch status
+		std::shared_ptr<SwitchCorrection> computeSwitchCorrection(const SwitchStatus& status);
+
+		// #### Scheduler Task Methods ####
+		/// Solves system for single frequency
+		virtual void solve(Real time, Int timeStepCount) override;
+
+	public:
+		/// Constructor should not be called by users but by Simulation
+		MnaSolverWoodbury(String name,
+			CPS::Domain domain = CPS::Domain::DP,
+			CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+		/// Destructor
+		virtual ~MnaSolverWoodbury() { };
+
+		/// Sets the maximum number of switch configurations whose corrections are cached
+		void setSwitchCacheSize(UInt size) { mSwitchCacheSize = size; }
+		/// Corrections are computed on demand, so there is nothing to warm up
+		virtual void warmUpSwitchedMatrices(const std::vector<Event::Ptr>& events) override { }
+	};
+}
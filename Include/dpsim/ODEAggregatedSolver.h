@@ -0,0 +1,134 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Solver.h>
+
+#include <cps/Solver/ODEInterface.h>
+
+#include <arkode/arkode.h>              // prototypes for ARKode fcts., consts. and includes sundials_types.h
+#include <nvector/nvector_serial.h>     // access to serial N_Vector
+#ifdef WITH_SUNDIALS_KLU
+  #include <sunmatrix/sunmatrix_sparse.h> // access to sparse SUNMatrix
+  #include <sunlinsol/sunlinsol_klu.h>    // access to KLU SUNLinearSolver
+#else
+  #include <sunmatrix/sunmatrix_band.h>   // access to band SUNMatrix
+  #include <sunlinsol/sunlinsol_band.h>   // access to band SUNLinearSolver
+#endif
+#include <arkode/arkode_direct.h>       // access to ARKDls interface
+
+namespace DPsim {
+	/// Solver for the ODE systems of several components, e.g. all generators of a subnet.
+	///
+	/// In contrast to one ODESolver per component, the states of all components are
+	/// concatenated into a single N_Vector and integrated by one ARKode instance.
+	/// The instance is created once and re-initialized with the states of the
+	/// components in every step, instead of being allocated in each step like in
+	/// ODESolver. As the components are independent, the Jacobian is block diagonal
+	/// and stored as sparse matrix that is factorized by KLU, or as band matrix if
+	/// Sundials was built without KLU, so that the linear solves of the implicit
+	/// integration scale linearly with the number of components. The right-hand
+	/// sides of the components can be evaluated in parallel with OpenMP.
+	class ODEAggregatedSolver : public Solver {
+	protected:
+		/// Components to simulate
+		std::vector<CPS::ODEInterface::Ptr> mComponents;
+		/// States of each component before the step
+		std::vector<CPS::Attribute<Matrix>::Ptr> mPreStates;
+		/// States of each component after the step
+		std::vector<CPS::Attribute<Matrix>::Ptr> mPostStates;
+		/// Offset of the states of each component in the state vector, followed by the total size
+		std::vector<Int> mOffsets;
+		/// Number of states of the largest component, which determines the bandwidth
+		Int mMaxDim = 0;
+		/// Number of entries of the block diagonal Jacobian
+		Int mNonZeros = 0;
+		/// Number of differential variables (states) of all components
+		Int mProbDim = 0;
+		/// Number of threads evaluating the right-hand sides
+		Int mNumThreads = 1;
+
+		// ### ARKode-specific variables ###
+		/// Memory block allocated by ARKode
+		void* mArkode_mem {nullptr};
+		/// State vector
+		N_Vector mStates {nullptr};
+		/// Indicates whether the ODE shall be solved using an implicit scheme
+		bool mImplicitIntegration;
+		/// Sparse or band matrix holding the block diagonal Jacobian (implicit solver)
+		SUNMatrix A {nullptr};
+		/// KLU or band linear solver (implicit solver)
+		SUNLinearSolver LS {nullptr};
+#ifndef WITH_SUNDIALS_KLU
+		/// Buffer for the dense column-major Jacobian of a single component
+		Matrix mBlockJacobian;
+#endif
+
+		/// Constant time step
+		Real mTimestep;
+
+		/// Relative tolerance
+		realtype reltol = RCONST(1.0e-6);
+		/// Scalar absolute tolerance
+		realtype abstol = RCONST(1.0e-10);
+
+		/// reusable error-checking flag
+		int mFlag {0};
+
+		static int StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot, void *user_data);
+		int StateSpace(realtype t, N_Vector y, N_Vector ydot);
+
+		static int JacobianWrapper(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_data,
+		                           N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		int Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+		             N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+		/// ARKode standard error detection function
+		int check_flag(void *flagvalue, const std::string &funcname, int opt);
+		/// Copies the states of the components into the state vector
+		void loadStates();
+
+	public:
+		/// Create solve object with the given components and information on the integration type
+		ODEAggregatedSolver(String name, const std::vector<CPS::ODEInterface::Ptr> &comps,
+			bool implicit_integration, Real timestep);
+		/// Deallocate all memory
+		~ODEAggregatedSolver();
+
+		/// Sets the number of threads evaluating the right-hand sides of the components
+		void setNumThreads(Int threads) { mNumThreads = threads; }
+
+		class SolveTask : public CPS::Task {
+		public:
+			SolveTask(ODEAggregatedSolver& solver)
+			: Task(solver.mName + ".Solve"), mSolver(solver) {
+				for (UInt i = 0; i < solver.mComponents.size(); i++) {
+					mAttributeDependencies.push_back(solver.mPreStates[i]);
+					mModifiedAttributes.push_back(solver.mPostStates[i]);
+				}
+			}
+
+			void execute(Real time, Int timeStepCount);
+
+		private:
+			ODEAggregatedSolver& mSolver;
+		};
+
+		virtual CPS::Task::List getTasks() {
+			return CPS::Task::List{std::make_shared<SolveTask>(*this)};
+		}
+
+		/// Initialize ARKode-solve_environment
+		void initialize();
+		/// Solve system for the current time
+		Real step(Real initial_time);
+	};
+}
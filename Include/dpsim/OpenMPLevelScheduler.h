@@ -19,6 +19,7 @@ namespace DPsim {
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
 		void step(Real time, Int timeStepCount);
 		void stop();
+		Int threads() const { return mNumThreads; }
 
 	private:
 		Int mNumThreads;
@@ -48,6 +48,14 @@ namespace DPsim {
 
         /// Jacobian matrix
         CPS::Matrix mJ;
+        /// Sparse Jacobian matrix with the nonzero structure derived from the admittance matrix
+        CPS::SparseMatrix mJSparse;
+        /// LU factorization of the sparse Jacobian, whose symbolic analysis is reused
+        CPS::LUFactorizedSparse mJacobianLU;
+        /// Position of each bus in mPQPVBusIndices, -1 for VD buses
+        std::vector<CPS::Int> mPQPVBusPositions;
+        /// Assemble and factorize the Jacobian as sparse matrix instead of a dense one
+        CPS::Bool mSparseJacobian = true;
         /// Solution vector
         CPS::Vector mX;
 	    /// Vector of mismatch values
@@ -86,6 +94,8 @@ namespace DPsim {
         CPS::Bool solutionInitialized = false;
         /// Flag whether complex solution vectors are initialized
         CPS::Bool solutionComplexInitialized = false;
+        /// Start each time step from the solution of the previous time step
+        CPS::Bool mWarmStart = false;
 
         /// Generate initial solution for current time step
         virtual void generateInitialSolution(Real time, bool keep_last_solution = false) = 0;
@@ -93,6 +103,8 @@ namespace DPsim {
         virtual void calculateMismatch() = 0;
         /// Calculate the Jacobian
         virtual void calculateJacobian() = 0;
+        /// Calculate the Jacobian with a sparse structure derived from the admittance matrix
+        virtual void calculateSparseJacobian() = 0;
         /// Update solution in each iteration
         virtual void updateSolution() = 0;
         /// Set final solution
@@ -110,12 +122,16 @@ namespace DPsim {
         void determinePFBusType();
         /// Compose admittance matrix
 		void composeAdmittanceMatrix();
+        /// Create the structure of the sparse Jacobian and analyze its pattern once
+        void createSparseJacobian();
         /// Gets the real part of admittance matrix element
         CPS::Real G(int i, int j);
         /// Gets the imaginary part of admittance matrix element
         CPS::Real B(int i, int j);
         /// Solves the powerflow problem
-        Bool solvePowerflow();
+        virtual Bool solvePowerflow();
+        /// Solves the powerflow problem for the given time step
+        virtual void solve(Real time, Int timeStepCount);
         /// Check whether below tolerance
         CPS::Bool checkConvergence();
         /// Logging for integer vectors
@@ -138,6 +154,10 @@ namespace DPsim {
 
         /// Set a node to VD using its name
         void setVDNode(CPS::String name);
+        /// Use a sparse Jacobian (default) or the dense Jacobian
+        void doSparseJacobian(CPS::Bool value) { mSparseJacobian = value; }
+        /// Start each time step from the solution of the previous time step instead of a flat start
+        void doWarmStart(CPS::Bool value) { mWarmStart = value; }
         /// Allows to modify the powerflow bus type of a specific component
         void modifyPowerFlowBusComponent(CPS::String name, CPS::PowerflowBusType powerFlowBusType);
 
@@ -0,0 +1,134 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include <dpsim/PFSolverPowerPolar.h>
+
+namespace DPsim {
+    /// Powerflow solver class using the fast decoupled method.
+    ///
+    /// The matrices B' and B'' only depend on the admittance matrix and are
+    /// factorized once for the whole simulation. Each time step starts from
+    /// the solution of the previous one. For quasi-static time series, the
+    /// time steps can be solved in independent time windows by several threads.
+    /// If the fast decoupled iterations do not converge, the solver falls back
+    /// to the Newton-Raphson method.
+    class PFSolverFastDecoupled : public PFSolverPowerPolar {
+    public:
+        /// Approximations of the fast decoupled method
+        /// XB: B' from series reactances, B'' from the full susceptances
+        /// BX: B' from the full series susceptances, B'' from series reactances
+        enum class Variant { XB, BX };
+
+    protected:
+        /// Specified injections, start voltages and load powers of a time step
+        struct StepState {
+            CPS::Vector P;
+            CPS::Vector Q;
+            CPS::Vector V;
+            CPS::Vector D;
+            std::vector<CPS::Real> loadP;
+            std::vector<CPS::Real> loadQ;
+        };
+
+        /// Result of a time step that was solved in advance
+        struct StepSolution {
+            CPS::Vector V;
+            CPS::Vector D;
+            CPS::UInt iterations = 0;
+            CPS::Bool converged = false;
+        };
+
+        /// Approximation used for B' and B''
+        Variant mVariant = Variant::XB;
+        /// Matrix relating active power mismatches to voltage angle increments
+        CPS::SparseMatrix mBp;
+        /// Matrix relating reactive power mismatches to voltage magnitude increments
+        CPS::SparseMatrix mBpp;
+        /// Factorization of B'
+        CPS::LUFactorizedSparse mBpLU;
+        /// Factorization of B''
+        CPS::LUFactorizedSparse mBppLU;
+        /// Number of threads solving independent time windows
+        CPS::UInt mNumThreads = 1;
+        /// Number of time steps per time window
+        CPS::UInt mWindowSize = 96;
+        /// Time windows are not extended beyond the final time of the simulation
+        CPS::Real mFinalTime = std::numeric_limits<CPS::Real>::max();
+        /// Loads with a profile, whose powers are cached for each time step
+        std::vector<std::shared_ptr<CPS::SP::Ph1::Load>> mProfileLoads;
+        /// States of the time steps of the current time windows
+        std::vector<StepState> mStepStates;
+        /// Solutions of the time steps of the current time windows
+        std::vector<StepSolution> mStepSolutions;
+        /// First time step of the current time windows
+        Int mFirstStep = 0;
+        /// Number of time steps in the current time windows
+        CPS::UInt mNumSteps = 0;
+        /// Number of time steps per window in the current time windows
+        CPS::UInt mCurrentWindowSize = 0;
+
+        /// Worker threads solving the time windows, the calling thread solves the first one
+        std::vector<std::thread> mWorkers;
+        /// Releases the workers to solve the current time windows
+        std::unique_ptr<Barrier> mStartBarrier;
+        /// Waits until all workers solved their time window
+        std::unique_ptr<Barrier> mDoneBarrier;
+        /// Set to let the workers return at the next start barrier
+        std::atomic<Bool> mStopWorkers { false };
+
+        /// Initialization of the solver
+        void initialize() override;
+        /// Create and factorize B' and B''
+        void createFastDecoupledMatrices();
+        /// Calculates the active and reactive power at bus k for the given voltages
+        void calculatePower(const CPS::Vector& V, const CPS::Vector& D, CPS::UInt k, CPS::Real& P, CPS::Real& Q) const;
+        /// Fast decoupled iterations on the given voltages, returns true if converged
+        CPS::Bool solveFastDecoupled(CPS::Vector& V, CPS::Vector& D,
+            const CPS::Vector& Pesp, const CPS::Vector& Qesp, CPS::UInt& iterations) const;
+        /// Sets the specified voltages of slack and PV buses of the given time step, which
+        /// are kept from the previous solution with warm starts, or all start voltages otherwise
+        void applyStartVoltages(const StepState& state, CPS::Vector& V, CPS::Vector& D) const;
+        /// Solves the given time window of the current time windows
+        void solveTimeWindow(CPS::UInt window);
+        /// Solves the time windows starting at the given time step in parallel
+        void solveTimeWindows(Real time, Int timeStepCount);
+        /// Starts the worker threads that solve the time windows
+        void startWorkers();
+        /// Lets the worker threads return and joins them
+        void stopWorkers();
+
+        /// Solves the powerflow problem
+        Bool solvePowerflow() override;
+        /// Solves the powerflow problem for the given time step
+        void solve(Real time, Int timeStepCount) override;
+
+    public:
+        /// Constructor to be used in simulation examples.
+        PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel);
+        ///
+        virtual ~PFSolverFastDecoupled() { stopWorkers(); }
+
+        /// Set the approximation used for B' and B''
+        void setVariant(Variant variant) { mVariant = variant; }
+        /// Solve independent time windows of the given size with the given number of threads,
+        /// must be called before the simulation starts
+        void setTimeWindows(CPS::UInt numThreads, CPS::UInt windowSize) {
+            mNumThreads = numThreads;
+            mWindowSize = std::max<CPS::UInt>(1, windowSize);
+        }
+        /// Set the final time of the simulation, which limits the time windows
+        void setFinalTime(CPS::Real finalTime) { mFinalTime = finalTime; }
+    };
+}
@@ -35,6 +35,8 @@ namespace DPsim {
         void generateInitialSolution(Real time, bool keep_last_solution = false);
         /// Calculate the Jacobian
         void calculateJacobian();
+        /// Calculate the Jacobian using only the nonzeros of the admittance matrix
+        void calculateSparseJacobian();
         /// Update solution in each iteration
         void updateSolution();
         /// Set final solution
@@ -0,0 +1,76 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+	/// Lock-free ring buffer of fixed-width rows for a single producer and a single consumer.
+	///
+	/// The producer fills the row returned by pushBegin() and publishes it with pushEnd(),
+	/// the consumer reads the row returned by front() and releases it with pop().
+	class RowRingBuffer {
+	protected:
+		std::vector<Real> mData;
+		std::size_t mCapacity = 0;
+		std::size_t mWidth = 0;
+		/// Number of rows pushed, only written by the producer
+		alignas(64) std::atomic<std::size_t> mHead{0};
+		/// Number of rows popped, only written by the consumer
+		alignas(64) std::atomic<std::size_t> mTail{0};
+
+	public:
+		/// Allocates the rows, must not be called concurrently with other methods
+		void resize(std::size_t capacity, std::size_t width) {
+			mCapacity = capacity;
+			mWidth = width;
+			mData.assign(capacity * width, 0);
+			mHead.store(0, std::memory_order_relaxed);
+			mTail.store(0, std::memory_order_relaxed);
+		}
+
+		std::size_t capacity() const { return mCapacity; }
+		std::size_t width() const { return mWidth; }
+
+		/// Returns the next free row or nullptr if the buffer is full
+		Real* pushBegin() {
+			std::size_t head = mHead.load(std::memory_order_relaxed);
+			if (head - mTail.load(std::memory_order_acquire) >= mCapacity)
+				return nullptr;
+			return &mData[(head % mCapacity) * mWidth];
+		}
+		/// Publishes the row returned by pushBegin()
+		void pushEnd() {
+			mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		/// Number of rows pushed so far, can be used as limit for front()
+		std::size_t pushed() const {
+			return mHead.load(std::memory_order_acquire);
+		}
+		/// Returns the oldest row or nullptr if there is no row before the given push count
+		const Real* front(std::size_t limit) const {
+			std::size_t tail = mTail.load(std::memory_order_relaxed);
+			if (tail >= limit)
+				return nullptr;
+			return &mData[(tail % mCapacity) * mWidth];
+		}
+		const Real* front() const {
+			return front(pushed());
+		}
+		/// Releases the row returned by front()
+		void pop() {
+			mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+	};
+}
@@ -11,14 +11,17 @@
 #include <cps/Task.h>
 
 #include <dpsim/Definitions.h>
+#include <dpsim/Trace.h>
 #include <cps/Logger.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace DPsim {
 	// TODO extend / subclass
@@ -49,6 +52,17 @@ namespace DPsim {
 		virtual void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges) = 0;
 		/// Performs a single simulation step
 		virtual void step(Real time, Int timeStepCount) = 0;
+		/// Performs numSteps consecutive simulation steps without returning in between
+		virtual void steps(Real time, Real timeStep, Int timeStepCount, Int numSteps) {
+			for (Int i = 0; i < numSteps; i++) {
+				step(time, timeStepCount + i);
+				time += timeStep;
+			}
+		}
+		/// Maximum number of steps the simulation may pass to steps at once
+		virtual Int stepWindow() const { return 1; }
+		/// Number of threads executing the tasks, including the thread calling step
+		virtual Int threads() const { return 1; }
 		/// Called on simulation stop to reliably clean up e.g. running helper threads
 		virtual void stop() {}
 
@@ -56,6 +70,21 @@ namespace DPsim {
 		/// and inserts a root task
 		void resolveDeps(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
 
+		/// Configures the fusion of cheap tasks into super-tasks, so that the
+		/// synchronization per step depends on the number of groups rather than
+		/// on the number of components. Tasks with a cost of at most maxTaskCost
+		/// (in ns) are fused into chains and into at most groups super-tasks per level,
+		/// where 0 groups means one per thread.
+		/// The costs are read from inMeasurementFile or estimated from the task type.
+		void setTaskFusion(Int groups, CPS::String inMeasurementFile = CPS::String(), TaskTime::rep maxTaskCost = 1000) {
+			mFusionGroups = groups;
+			mFusionMeasurementFile = inMeasurementFile;
+			mFusionMaxTaskCost = maxTaskCost;
+		}
+		/// Replaces cheap tasks in the resolved dependency graph by super-tasks,
+		/// called by the simulation if the task fusion is enabled
+		void fuseTasks(CPS::Task::List& tasks, Edges& inEdges, Edges& outEdges);
+
 		// Special attribute that can be returned in the modified attributes of a task
 		// to mark that this task has external side-effects (like logging / interfacing)
 		// and thus has to be executed even though it doesn't modify any attribute.
@@ -96,6 +125,11 @@ namespace DPsim {
 		void readMeasurements(CPS::String filename, std::unordered_map<CPS::String, TaskTime::rep>& measurements);
 		///
 		TaskTime getAveragedMeasurement(CPS::Task* task);
+		/// Exponentially weighted online estimate of the task execution time in ns,
+		/// 0 if the task was not measured yet
+		Real getEstimatedCost(CPS::Task* task);
+		/// Static cost estimate in ns for tasks without measurements
+		static TaskTime::rep estimateCost(const CPS::Task::Ptr& task);
 
 		///
 		CPS::Task::Ptr mRoot;
@@ -103,13 +137,181 @@ namespace DPsim {
 		CPS::Logger::Level mLogLevel;
 		/// Logger
 		CPS::Logger::Log mSLog;
+		/// Weight of the latest measurement in the online cost estimate
+		Real mEstimateWeight = 0.1;
+
 	private:
-		// TODO more sophisticated measurement method might be necessary for
-		// longer simulations (risk of high memory requirements and integer
-		// overflow)
-		std::unordered_map<CPS::Task*, std::vector<TaskTime>> mMeasurements;
+		/// Measurements of a task, kept in fixed memory
+		struct TaskStatistics {
+			TaskTime total = TaskTime(0);
+			UInt count = 0;
+			/// Exponentially weighted moving average in ns
+			Real estimate = 0;
+		};
+		std::unordered_map<CPS::Task*, TaskStatistics> mMeasurements;
+
+		/// Maximum number of fused super-tasks per level, 0 means one per thread
+		Int mFusionGroups = 0;
+		CPS::String mFusionMeasurementFile;
+		TaskTime::rep mFusionMaxTaskCost = 1000;
 	};
 
+	/// Call of a task through a plain function pointer, resolved once when the
+	/// schedule is created instead of by a virtual call in each step
+	struct CompiledTask {
+		typedef void (*Function)(CPS::Task* task, Real time, Int timeStepCount);
+
+		CompiledTask() = default;
+		explicit CompiledTask(CPS::Task* task);
+
+		void operator()(Real time, Int timeStepCount) const {
+			function(task, time, timeStepCount);
+		}
+
+		Function function = nullptr;
+		CPS::Task* task = nullptr;
+	};
+
+	/// Contiguous array of task calls for a sequential or per-thread schedule
+	class CompiledSchedule {
+	public:
+		/// Replaces the schedule by the given tasks, in order
+		void compile(const CPS::Task::List& tasks);
+		void clear() { mTasks.clear(); }
+		size_t size() const { return mTasks.size(); }
+		const CompiledTask& operator[](size_t i) const { return mTasks[i]; }
+
+		/// Executes all tasks, prefetching the object of the next task
+		void execute(Real time, Int timeStepCount) const {
+			if (Trace::enabled()) {
+				executeTraced(time, timeStepCount);
+				return;
+			}
+			const CompiledTask* tasks = mTasks.data();
+			const size_t n = mTasks.size();
+			for (size_t i = 0; i < n; i++) {
+				if (i + 1 < n)
+					prefetch(tasks[i+1].task);
+				tasks[i](time, timeStepCount);
+			}
+		}
+
+		static void prefetch(const void* ptr) {
+#if defined(__GNUC__)
+			__builtin_prefetch(ptr);
+#endif
+		}
+
+	private:
+		void executeTraced(Real time, Int timeStepCount) const;
+
+		std::vector<CompiledTask> mTasks;
+	};
+
+	/// Task which executes a group of fused tasks in the given order. Its name
+	/// joins the names of the fused tasks, so that they stay visible in the
+	/// measurements and traces.
+	class FusedTask : public CPS::Task {
+	public:
+		typedef std::shared_ptr<FusedTask> Ptr;
+
+		FusedTask(const CPS::Task::List& tasks);
+
+		void execute(Real time, Int timeStepCount);
+
+		const CPS::Task::List& tasks() const { return mTasks; }
+
+	private:
+		CPS::Task::List mTasks;
+		CompiledSchedule mCompiled;
+	};
+
+	/// Strategy of threads waiting at a barrier or counter
+	enum class WaitMode {
+		/// Busy waiting, lowest wake-up latency but occupies the CPU
+		Spin,
+		/// Sleeping on a condition variable
+		Condition,
+		/// Spinning with pause instructions and exponential backoff for a
+		/// calibrated time window, then sleeping on a futex
+		Adaptive
+	};
+
+	namespace Sync {
+		/// Tells the CPU that the calling thread is spinning
+		inline void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+			asm volatile("yield");
+#endif
+		}
+
+		/// Number of pause instructions that take about the given time in us
+		Int spinBudget(Int microseconds);
+		/// Blocks while value equals expected, may return spuriously
+		void futexWait(std::atomic<Int>& value, Int expected);
+		/// Wakes all threads blocked on value
+		void futexWake(std::atomic<Int>& value);
+
+		/// Waits until done(value) holds. Spins for spinBudget pause instructions
+		/// with exponential backoff and then sleeps until woken by adaptiveWake.
+		template<typename Predicate>
+		void adaptiveWait(std::atomic<Int>& value, std::atomic<Int>& sleepers, Int spinBudget, Predicate done) {
+			Int backoff = 1;
+			while (spinBudget > 0) {
+				if (done(value.load(std::memory_order_acquire)))
+					return;
+				for (Int i = 0; i < backoff; i++)
+					pause();
+				spinBudget -= backoff;
+				backoff = std::min(2 * backoff, 64);
+			}
+			while (true) {
+				// The sequentially consistent accesses on both sides ensure that either
+				// the waiting thread sees the new value or the waking thread the sleeper
+				sleepers.fetch_add(1, std::memory_order_seq_cst);
+				Int current = value.load(std::memory_order_seq_cst);
+				if (!done(current))
+					futexWait(value, current);
+				sleepers.fetch_sub(1, std::memory_order_relaxed);
+				if (done(value.load(std::memory_order_acquire)))
+					return;
+			}
+		}
+
+		/// Wakes the threads in adaptiveWait, must follow a sequentially consistent change of value
+		inline void adaptiveWake(std::atomic<Int>& value, std::atomic<Int>& sleepers) {
+			if (sleepers.load(std::memory_order_seq_cst) > 0)
+				futexWake(value);
+		}
+
+		/// Waits on the condition variable until done(value) holds. The waiting
+		/// thread is counted in waiters so that conditionWake only locks when needed.
+		template<typename Predicate>
+		void conditionWait(std::atomic<Int>& value, std::atomic<Int>& waiters,
+			std::mutex& mutex, std::condition_variable& condition, Predicate done) {
+			if (done(value.load(std::memory_order_acquire)))
+				return;
+			std::unique_lock<std::mutex> lk(mutex);
+			// Either this thread sees the new value or the waking thread the waiter,
+			// and the waking thread cannot notify between the check and the sleep
+			waiters.fetch_add(1, std::memory_order_seq_cst);
+			condition.wait(lk, [&value, &done] { return done(value.load(std::memory_order_seq_cst)); });
+			waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		/// Wakes the threads in conditionWait, must follow a sequentially consistent change of value
+		inline void conditionWake(std::atomic<Int>& waiters, std::mutex& mutex, std::condition_variable& condition) {
+			if (waiters.load(std::memory_order_seq_cst) > 0) {
+				{
+					std::lock_guard<std::mutex> lk(mutex);
+				}
+				condition.notify_all();
+			}
+		}
+	}
+
 	/// A barrier is used to synchronize threads. Threads running into the barrier
 	/// have to wait until the barrier state is released when a defined number
 	/// of threads reaches the barrier.
@@ -120,38 +322,38 @@ namespace DPsim {
 		/// Limit sets the number of threads that need to reach the barrier
 		/// to release it.
 		Barrier(Int limit, Bool useCondition = false) :
-			mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+			Barrier(limit, useCondition ? WaitMode::Condition : WaitMode::Spin) {}
+		///
+		Barrier(Int limit, WaitMode mode) :
+			mLimit(limit), mCount(0), mGeneration(0) { setWaitMode(mode); }
+
+		/// Sets how threads wait at the barrier, where spinWindow is the time in us
+		/// spent spinning in the adaptive mode. Must not be called concurrently with wait().
+		void setWaitMode(WaitMode mode, Int spinWindow = 50) {
+			mMode = mode;
+			mSpinBudget = mode == WaitMode::Adaptive ? Sync::spinBudget(spinWindow) : 0;
+		}
 
 		/// Blocks until |limit| calls have been made, at which point all threads
 		/// return. Provides synchronization, i.e. all writes from before this call
 		/// are visible in all threads after this call.
 		void wait() {
-			if (mUseCondition) {
-				std::unique_lock<std::mutex> lk(mMutex);
-				Int gen = mGeneration;
-				mCount++;
-				if (mCount == mLimit) {
-					mCount = 0;
-					mGeneration++;
-					lk.unlock();
-					mCondition.notify_all();
-				} else {
-					// necessary because of spurious wakeups
-					while (gen == mGeneration)
-						mCondition.wait(lk);
-				}
+			Int gen = mGeneration.load(std::memory_order_acquire);
+			// We need at least one release from each thread to ensure that
+			// every write from before the wait() is visible in every other thread,
+			// and the fetch needs to be an acquire anyway, so use acq_rel instead of acquire.
+			// (This generates the same code on x86.)
+			if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
+				mCount.store(0, std::memory_order_relaxed);
+				release();
+			} else if (mMode == WaitMode::Condition) {
+				Sync::conditionWait(mGeneration, mSleepers, mMutex, mCondition,
+					[gen](Int generation) { return generation != gen; });
+			} else if (mMode == WaitMode::Adaptive) {
+				Sync::adaptiveWait(mGeneration, mSleepers, mSpinBudget,
+					[gen](Int generation) { return generation != gen; });
 			} else {
-				Int gen = mGeneration.load(std::memory_order_acquire);
-				// We need at least one release from each thread to ensure that
-				// every write from before the wait() is visible in every other thread,
-				// and the fetch needs to be an acquire anyway, so use acq_rel instead of acquire.
-				// (This generates the same code on x86.)
-				if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
-				} else {
-					while (mGeneration.load(std::memory_order_acquire) == gen);
-				}
+				while (mGeneration.load(std::memory_order_acquire) == gen);
 			}
 		}
 
@@ -160,32 +362,38 @@ namespace DPsim {
 		/// other threads). Can be used to eliminate unnecessary waits if
 		/// multiple barriers are used in sequence.
 		void signal() {
-			if (mUseCondition) {
-				std::unique_lock<std::mutex> lk(mMutex);
-				mCount++;
-				if (mCount == mLimit) {
-					mCount = 0;
-					mGeneration++;
-					lk.unlock();
-					mCondition.notify_all();
-				}
-			} else {
-				// No release here, as this call does not provide any synchronization anyway.
-				if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
-					mCount.store(0, std::memory_order_relaxed);
-					mGeneration.fetch_add(1, std::memory_order_release);
-				}
+			// No release here, as this call does not provide any synchronization anyway.
+			if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit-1) {
+				mCount.store(0, std::memory_order_relaxed);
+				release();
 			}
 		}
 
 	private:
+		/// Starts the next generation and wakes the waiting threads
+		void release() {
+			if (mMode == WaitMode::Adaptive) {
+				mGeneration.fetch_add(1, std::memory_order_seq_cst);
+				Sync::adaptiveWake(mGeneration, mSleepers);
+			} else if (mMode == WaitMode::Condition) {
+				mGeneration.fetch_add(1, std::memory_order_seq_cst);
+				Sync::conditionWake(mSleepers, mMutex, mCondition);
+			} else {
+				mGeneration.fetch_add(1, std::memory_order_release);
+			}
+		}
+
 		/// Barrier limit which has to be reached before the barrier is released.
 		Int mLimit;
 		/// Barrier counter which is tested against limit
 		std::atomic<Int> mCount;
 		/// Allows multiple use of the barrier
 		std::atomic<Int> mGeneration;
-		Bool mUseCondition;
+		WaitMode mMode;
+		/// Number of pause instructions before sleeping in the adaptive mode
+		Int mSpinBudget = 0;
+		/// Number of threads sleeping in the adaptive or condition mode
+		std::atomic<Int> mSleepers { 0 };
 
 		std::mutex mMutex;
 		std::condition_variable mCondition;
@@ -205,15 +413,50 @@ namespace DPsim {
 	public:
 		Counter() : mValue(0) {}
 
+		/// Must not be called concurrently with inc() or wait()
+		void set(Int value) {
+			mValue.store(value, std::memory_order_relaxed);
+		}
+
+		/// Sets how threads wait for the counter, see Barrier::setWaitMode.
+		/// Must not be called concurrently with inc() or wait()
+		void setWaitMode(WaitMode mode, Int spinWindow = 50) {
+			mMode = mode;
+			mSpinBudget = mode == WaitMode::Adaptive ? Sync::spinBudget(spinWindow) : 0;
+		}
+
 		void inc() {
-			mValue.fetch_add(1, std::memory_order_release);
+			if (mMode == WaitMode::Condition) {
+				mValue.fetch_add(1, std::memory_order_seq_cst);
+				Sync::conditionWake(mSleepers, mMutex, mCondition);
+			} else if (mMode == WaitMode::Adaptive) {
+				mValue.fetch_add(1, std::memory_order_seq_cst);
+				Sync::adaptiveWake(mValue, mSleepers);
+			} else {
+				mValue.fetch_add(1, std::memory_order_release);
+			}
 		}
 
 		void wait(Int value) {
-			while (mValue.load(std::memory_order_acquire) != value);
+			if (mMode == WaitMode::Condition) {
+				Sync::conditionWait(mValue, mSleepers, mMutex, mCondition,
+					[value](Int current) { return current == value; });
+			} else if (mMode == WaitMode::Adaptive) {
+				Sync::adaptiveWait(mValue, mSleepers, mSpinBudget,
+					[value](Int current) { return current == value; });
+			} else {
+				while (mValue.load(std::memory_order_acquire) != value);
+			}
 		}
 
 	private:
 		std::atomic<Int> mValue;
+		WaitMode mMode = WaitMode::Spin;
+		Int mSpinBudget = 0;
+		/// Number of threads sleeping in the adaptive or condition mode
+		std::atomic<Int> mSleepers { 0 };
+
+		std::mutex mMutex;
+		std::condition_variable mCondition;
 	};
 }
@@ -29,6 +29,8 @@ namespace DPsim {
 
 	private:
 		CPS::Task::List mSchedule;
+		/// Schedule executed in each step without measurements
+		CompiledSchedule mCompiledSchedule;
 
 		std::unordered_map<size_t, std::vector<std::chrono::nanoseconds>> mMeasurements;
 		std::vector<std::chrono::nanoseconds> mStepMeasurements;
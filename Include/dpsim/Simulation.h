@@ -61,6 +61,10 @@ namespace DPsim {
 		CPS::Logger::Level mLogLevel;
 		/// (Real) time needed for the timesteps
 		std::vector<Real> mStepTimes;
+		/// File of the timeline trace, taken from the environment variable DPSIM_TRACE if empty
+		String mTraceFile;
+		/// Capacity of the trace buffer of each thread
+		UInt mTraceEventsPerThread = 1 << 20;
 
 		// #### Solver Settings ####
 		///
@@ -75,6 +79,34 @@ namespace DPsim {
 		Bool mInitFromNodesAndTerminals = true;
 		/// Enable recomputation of system matrix during simulation
 		Bool mSystemMatrixRecomputation = false;
+		/// Maximum rank of the low-rank updates of the recomputed system matrix
+		UInt mMaxUpdateRank = 0;
+		/// Number of switch configurations cached by the Woodbury solver
+		UInt mSwitchCacheSize = 16;
+		/// Build the system matrices of all switch configurations during initialization
+		Bool mPrecomputeSwitchedMatrices = true;
+		/// Memory budget of the cached switch configurations in bytes, 0 means unlimited
+		std::size_t mSwitchCacheMemoryBudget = 0;
+		/// Build the switch configurations of queued switch events before the simulation starts
+		Bool mSwitchCacheWarmUp = false;
+		/// Execute the MNA steps of linear components of the same type in batches
+		Bool mBatchLinearComponents = false;
+		/// Integrate the rotor dynamics of generators of the same type in banks
+		Bool mBatchMachines = false;
+		/// Integrate the ODE components of each subnet with a single solver
+		Bool mAggregateODESolvers = false;
+		/// Fuse cheap tasks into super-tasks before creating the schedule
+		Bool mTaskFusion = false;
+		/// Number of threads evaluating the right-hand sides of the aggregated ODE components
+		Int mODEThreads = 1;
+		/// Integrate the ODE components with an implicit scheme
+		Bool mImplicitODEIntegration = false;
+		/// Use a sparse Jacobian in the powerflow solver
+		Bool mSparsePowerflowJacobian = true;
+		/// Number of threads solving independent time windows with the fast decoupled powerflow
+		UInt mPowerflowThreads = 1;
+		/// Number of time steps per time window of the fast decoupled powerflow
+		UInt mPowerflowWindowSize = 96;
 
 		/// Determines if the network should be split
 		/// into subnetworks at decoupling lines.
@@ -84,6 +116,9 @@ namespace DPsim {
 		/// If tearing components exist, the Diakoptics
 		/// solver is selected automatically.
 		CPS::IdentifiedObject::List mTearComponents = CPS::IdentifiedObject::List();
+		/// Number of parts the network is torn into for the Diakoptics
+		/// solver if no tearing components are given
+		UInt mTearParts = 1;
 		/// Determines if the system matrix is split into
 		/// several smaller matrices, one for each frequency.
 		/// This can only be done if the network is composed
@@ -167,6 +202,8 @@ namespace DPsim {
 		///
 		void setSolverType(Solver::Type solverType = Solver::Type::MNA) { mSolverType = solverType; }
 		///
+		void setMnaSolverImplementation(MnaSolverFactory::MnaSolverImpl mnaImpl) { mMnaImpl = mnaImpl; }
+		///
 		void doInitFromNodesAndTerminals(Bool f = true) { mInitFromNodesAndTerminals = f; }
 		///
 		void doSplitSubnets(Bool splitSubnets = true) { mSplitSubnets = splitSubnets; }
@@ -174,14 +211,57 @@ namespace DPsim {
 		void setTearingComponents(CPS::IdentifiedObject::List tearComponents = CPS::IdentifiedObject::List()) {
 			mTearComponents = tearComponents;
 		}
+		/// Tear the network into the given number of parts of similar size at lines and
+		/// other two-terminal components, which are then solved by the Diakoptics solver.
+		/// Has no effect if tearing components are set explicitly.
+		void setAutomaticTearing(UInt parts) { mTearParts = parts; }
 		/// Set the scheduling method
 		void setScheduler(const std::shared_ptr<Scheduler> &scheduler) {
 			mScheduler = scheduler;
 		}
+		/// Record a timeline of the steps, tasks, waits and refactorizations of all threads
+		/// and write it to the given file in the Chrome trace format when the simulation stops.
+		/// Alternatively, the file can be given by the environment variable DPSIM_TRACE.
+		void setTraceFile(String filename, UInt eventsPerThread = 1 << 20) {
+			mTraceFile = filename;
+			mTraceEventsPerThread = eventsPerThread;
+		}
 		/// Compute phasors of different frequencies in parallel
 		void doFrequencyParallelization(Bool value) { mFreqParallel = value; }
 		///
 		void doSystemMatrixRecomputation(Bool value) { mSystemMatrixRecomputation = value; }
+		/// Apply changes of variable components as low-rank updates instead of
+		/// refactorizations if they touch at most maxRank rows of the system matrix
+		void setMaxUpdateRank(UInt maxRank) { mMaxUpdateRank = maxRank; }
+		/// Set number of switch configurations cached by the Woodbury solver
+		void setSwitchCacheSize(UInt size) { mSwitchCacheSize = size; }
+		/// Build the system matrices of all switch configurations during initialization (default),
+		/// otherwise they are built in the solve task on first use
+		void doPrecomputeSwitchedMatrices(Bool value) { mPrecomputeSwitchedMatrices = value; }
+		/// Set memory budget of the cached switch configurations in bytes, 0 means unlimited
+		void setSwitchCacheMemoryBudget(std::size_t bytes) { mSwitchCacheMemoryBudget = bytes; }
+		/// Build the switch configurations of queued switch events before the simulation starts
+		/// if the switch configurations are not precomputed
+		void doSwitchCacheWarmUp(Bool value) { mSwitchCacheWarmUp = value; }
+		/// Execute the MNA steps of linear dynamic phasor components of the same type in batches
+		void doBatchLinearComponents(Bool value) { mBatchLinearComponents = value; }
+		/// Integrate the rotor dynamics of dynamic phasor generators of the same type in banks
+		void doBatchMachines(Bool value) { mBatchMachines = value; }
+		/// Integrate the ODE components of each subnet with a single solver instead of one per component
+		void doAggregateODESolvers(Bool value) { mAggregateODESolvers = value; }
+		/// Fuse cheap tasks into super-tasks as configured by Scheduler::setTaskFusion
+		void doTaskFusion(Bool value) { mTaskFusion = value; }
+		/// Set number of threads evaluating the right-hand sides of the aggregated ODE components
+		void setODEThreads(Int threads) { mODEThreads = threads; }
+		/// Integrate the ODE components with an implicit instead of an explicit scheme
+		void doImplicitODEIntegration(Bool value) { mImplicitODEIntegration = value; }
+		/// Use a sparse (default) or dense Jacobian in the powerflow solver
+		void doSparsePowerflowJacobian(Bool value) { mSparsePowerflowJacobian = value; }
+		/// Solve independent time windows of the fast decoupled powerflow with several threads
+		void setPowerflowTimeWindows(UInt numThreads, UInt windowSize = 96) {
+			mPowerflowThreads = numThreads;
+			mPowerflowWindowSize = windowSize;
+		}
 
 		// #### Initialization ####
 		/// activate steady state initialization
@@ -204,6 +284,9 @@ namespace DPsim {
 		void run();
 		/// Solve system A * x = z for x and current time
 		virtual Real step();
+		/// Performs as many steps as the scheduler accepts at once, up to the
+		/// final time or the next event
+		Real steps();
 		/// Synchronize simulation with remotes by exchanging intial state over interfaces
 		void sync();
 		/// Create the schedule for the independent tasks
@@ -241,6 +324,7 @@ namespace DPsim {
 		Int timeStepCount() const { return mTimeStepCount; }
 		Real timeStep() const { return mTimeStep; }
 		DataLogger::List& loggers() { return mLoggers; }
+		Solver::List& solvers() { return mSolvers; }
 		std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
 		std::vector<Real>& stepTimes() { return mStepTimes; }
 
@@ -66,8 +66,9 @@ namespace DPsim {
 
 		// #### Solver settings ####
 		/// Solver types:
-		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson
-		enum class Type { MNA, DAE, NRP };
+		/// Modified Nodal Analysis, Differential Algebraic, Newton Raphson,
+		/// Fast Decoupled Powerflow
+		enum class Type { MNA, DAE, NRP, FDP };
 		///
 		void setTimeStep(Real timeStep) {
 			mTimeStep = timeStep;
@@ -0,0 +1,59 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Scheduler for systems that are split into subnets by decoupling lines.
+	/// Each independent group of tasks, i.e. each subnet, is assigned to a thread
+	/// which performs a whole window of steps before synchronizing with the other
+	/// threads. Within a window, the subnets only synchronize through the
+	/// ringbuffers of the decoupling lines, so that a thread can run ahead by up
+	/// to the delay of its lines. Loggers or interfaces that access several
+	/// subnets join their groups, so one logger per subnet should be used.
+	class SubnetPipelineScheduler : public Scheduler {
+	public:
+		SubnetPipelineScheduler(Int threads = 1, Int window = 1000, String outMeasurementFile = String());
+		virtual ~SubnetPipelineScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void steps(Real time, Real timeStep, Int timeStepCount, Int numSteps);
+		Int stepWindow() const { return mWindow; }
+		void stop();
+		Int threads() const { return mNumThreads; }
+
+	private:
+		/// Performs the current window of steps for the given thread
+		void executeSteps(Int thread);
+		static void threadFunction(SubnetPipelineScheduler* sched, Int idx);
+
+		Int mNumThreads;
+		/// Maximum number of steps between two synchronizations of all threads
+		Int mWindow;
+		String mOutMeasurementFile;
+
+		/// Tasks of all groups assigned to each thread
+		std::vector<CPS::Task::List> mSchedules;
+		std::vector<CompiledSchedule> mCompiledSchedules;
+		std::vector<std::thread> mThreads;
+		/// Passed by all threads at the start and at the end of each window
+		Barrier mBarrier;
+		Bool mJoining = false;
+
+		Real mTime = 0;
+		Real mTimeStep = 0;
+		Int mTimeStepCount = 0;
+		Int mNumSteps = 0;
+	};
+}
@@ -9,15 +9,95 @@
 #pragma once
 
 #include <dpsim/ThreadScheduler.h>
+#include <cps/AttributeList.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace DPsim {
-	class ThreadListScheduler : public ThreadScheduler {
+	/// List scheduler which assigns the tasks to the threads by the HLFET heuristic.
+	///
+	/// With rebalancing enabled, the execution time of each task is measured
+	/// and an exponentially weighted estimate is kept. A helper thread computes
+	/// a new assignment from the estimates while the steps continue, and the new
+	/// schedule replaces the current one between two steps if the predicted
+	/// makespan of the current one exceeds the new one by more than the given threshold.
+	class ThreadListScheduler : public ThreadScheduler, public CPS::AttributeList {
 	public:
 		ThreadListScheduler(Int threads = 1, String outMeasurementFile = String(), String inMeasurementFile = String(), Bool useConditionVariables = false);
+		~ThreadListScheduler();
 
 		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+
+		/// Checks the assignment every interval steps and reassigns the tasks if
+		/// the predicted makespan can be reduced by more than the relative threshold.
+		/// Must be called before createSchedule, an interval of 0 disables the rebalancing.
+		void setRebalancing(UInt interval, Real threshold = 0.1) {
+			mRebalanceInterval = interval;
+			mRebalanceThreshold = threshold;
+		}
 
 	private:
+		/// Assigns the tasks to the threads for the given costs and returns the predicted makespan
+		Real assignTasks(const std::unordered_map<CPS::Task::Ptr, Real>& costs,
+			std::vector<CPS::Task::List>& assignment, Real& criticalPath);
+		/// Predicted makespan of an assignment for the given costs
+		Real predictMakespan(const std::unordered_map<CPS::Task::Ptr, Real>& costs,
+			const std::vector<CPS::Task::List>& assignment);
+		/// Passes the current cost estimates to the planner thread
+		void requestPlan();
+		/// Computes a new assignment and its schedule for the requested costs
+		void plan();
+		/// Applies the results of the planner thread between two steps
+		void applyPlan(Int timeStepCount);
+		/// Stops and joins the planner thread
+		void stopPlanner();
+		static void plannerFunction(ThreadListScheduler* sched);
+
 		String mInMeasurementFile;
+		UInt mRebalanceInterval = 0;
+		Real mRebalanceThreshold = 0.1;
+
+		CPS::Task::List mOrdered;
+		/// Position of the scheduled tasks in mOrdered
+		std::unordered_map<CPS::Task::Ptr, size_t> mTaskIndex;
+		Edges mInEdges;
+		Edges mOutEdges;
+		/// Current assignment of the tasks to the threads
+		std::vector<CPS::Task::List> mAssignment;
+
+		// #### Planner thread ####
+		enum class PlanState { Idle, Requested, Done };
+		/// Handed over between the simulation thread and the planner thread,
+		/// which only accesses the plan members while the state is Requested
+		std::atomic<PlanState> mPlanState { PlanState::Idle };
+		std::thread mPlanner;
+		std::mutex mPlanMutex;
+		std::condition_variable mPlanCondition;
+		Bool mPlannerStop = false;
+		/// Estimated task costs in ns in the order of mOrdered
+		std::vector<Real> mPlanCosts;
+		std::vector<CPS::Task::List> mPlanAssignment;
+		/// New schedule, or the replaced one after it has been swapped
+		ScheduleBuffer mPlanSchedule;
+		Bool mPlanSwap = false;
+		Real mPlanCriticalPath = 0;
+		Real mPlanCurrent = 0;
+		Real mPlanBalanced = 0;
+
+		/// Length of the critical path in s for the estimated costs
+		Real mCriticalPath = 0;
+		/// Predicted makespan of the current assignment in s
+		Real mMakespan = 0;
+		/// Exponentially weighted estimate of the duration of a step in s
+		Real mStepTime = 0;
+		/// Sum of the estimated task costs in s
+		Real mTotalCost = 0;
+		/// Number of reassignments since the start of the simulation
+		Int mRebalances = 0;
 	};
 };
@@ -21,32 +21,94 @@ namespace DPsim {
 
 		void step(Real time, Int timeStepCount);
 		virtual void stop();
+		Int threads() const { return mNumThreads; }
+
+		/// Pins thread i to the CPU cpus[i % cpus.size()], where thread 0 is the
+		/// thread calling step. Must be called before the schedule is created.
+		void setCpuAffinity(const std::vector<Int>& cpus) { mCpus = cpus; }
+		/// Runs all threads with the given SCHED_FIFO priority, 0 keeps the default policy.
+		/// Threads sharing a CPU should then use condition variables, as spinning threads
+		/// would starve each other. Must be called before the schedule is created.
+		void setRealTimePriority(Int priority) { mPriority = priority; }
+		/// Records a histogram of the time each thread spends in a step and writes it
+		/// to the given file when the simulation is stopped
+		void setStepTimeHistogram(String filename, Real binWidth = 1e-6, UInt bins = 1000);
+		/// Sets how the threads wait for each other, where spinWindow is the time in us
+		/// spent spinning in the adaptive mode. Must be called before the schedule is created.
+		void setWaitMode(WaitMode mode, Int spinWindow = 50);
 
 	protected:
+		struct ScheduleEntry {
+			CompiledTask task;
+			Counter endCounter;
+			std::vector<Counter*> reqCounters;
+		};
+		/// Tasks and linked entries of all threads for a schedule that is not active
+		struct ScheduleBuffer {
+			std::vector<CPS::Task::List> tasks;
+			std::vector<ScheduleEntry*> entries;
+		};
+
 		void finishSchedule(const Edges& inEdges);
 		void scheduleTask(int thread, CPS::Task::Ptr task);
+		/// Creates the entries of the given assignment on the calling thread, so that
+		/// the next schedule can be prepared while the threads execute the current one
+		void buildSchedule(const std::vector<CPS::Task::List>& assignment, const Edges& inEdges, ScheduleBuffer& buffer);
+		/// Activates the schedule in the buffer between two steps, starting with the step
+		/// of the given time step count. The buffer receives the previous schedule.
+		void swapSchedule(ScheduleBuffer& buffer, Int timeStepCount);
+		/// Frees the entries of a schedule that is not active
+		static void freeSchedule(ScheduleBuffer& buffer);
 
 		Int mNumThreads;
+		/// Measure the execution time of each task
+		Bool mMeasureTasks;
 
 	private:
 		void doStep(Int scheduleIdx);
+		void executeTasks(Int thread);
+		/// Records the tasks and the waits for their dependencies in the trace
+		void executeTasksTraced(Int thread);
 		static void threadFunction(ThreadScheduler* sched, Int idx);
+		/// Applies the affinity and priority settings to the calling thread
+		void configureThread(Int thread);
+		/// Allocates and links the schedule entries of the given thread. Each thread
+		/// sets up its own entries, so that they are placed on its NUMA node by the
+		/// first-touch policy of the kernel.
+		void setupThread(Int thread);
+		void writeStepTimeHistograms();
 
 		String mOutMeasurementFile;
 		Barrier mStartBarrier;
+		/// Synchronizes the threads while they set up their schedules
+		Barrier mSetupBarrier;
+		/// Set while the threads pass the start barrier to set up their schedules
+		Bool mSetupPending = false;
+		/// Dependencies of the schedule that is set up
+		const Edges* mSetupEdges = nullptr;
+
+		std::vector<Int> mCpus;
+		Int mPriority = 0;
+		/// Wait mode of the task counters
+		WaitMode mWaitMode;
+		Int mSpinWindow = 50;
+
+		String mHistogramFile;
+		Real mHistogramBinWidth = 1e-6;
+		/// Number of steps of each thread per step time bin
+		std::vector<std::vector<Int>> mStepTimeHistograms;
 
 		std::vector<std::thread> mThreads;
 
 		std::vector<CPS::Task::List> mTempSchedules;
-		struct ScheduleEntry {
-			CPS::Task* task;
-			Counter endCounter;
-			std::vector<Counter*> reqCounters;
-		};
 		std::vector<ScheduleEntry*> mSchedules;
 
 		Bool mJoining = false;
 		Real mTime = 0;
 		Int mTimeStepCount = 0;
+		/// Number of steps performed so far
+		Int mStepCount = 0;
+		/// Incremented by each helper thread after each step
+		Counter mThreadsDone;
 	};
 }
@@ -0,0 +1,82 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+#include <cps/Task.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#endif
+
+namespace DPsim {
+	/// Timeline of the simulation threads, which is written in the Chrome trace
+	/// event format that can be viewed with chrome://tracing or ui.perfetto.dev.
+	/// Each thread records its events into its own preallocated buffer, so that
+	/// recording does not take locks. When the buffer of a thread is full,
+	/// further events of the thread are dropped.
+	class Trace {
+	public:
+		enum class Category { Step, Task, Wait, Solver };
+
+		/// Starts recording with a buffer of eventsPerThread events for each thread.
+		/// The buffers of the given number of threads are allocated here, further
+		/// threads allocate theirs on their first event.
+		/// Must not be called while a simulation is running.
+		static void start(String filename, UInt eventsPerThread = 1 << 20, UInt threads = 1);
+		/// Stops recording and writes the events to the file given to start.
+		/// Events recorded after stop are discarded.
+		/// The traced tasks must still exist and all threads that recorded
+		/// events must have been joined, as their buffers are freed.
+		static void stop();
+
+		static Bool enabled() {
+			return sEnabled.load(std::memory_order_relaxed);
+		}
+
+		/// Timestamp in ticks of the time stamp counter if available
+		static std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+			return __rdtsc();
+#else
+			return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+		}
+
+		/// Records an event of the calling thread, name must stay valid until stop
+		static void record(Category category, const char* name, std::uint64_t begin, std::uint64_t end);
+		/// Records the execution of a task by the calling thread
+		static void record(const CPS::Task* task, std::uint64_t begin, std::uint64_t end);
+		/// Name of the calling thread in the trace
+		static void setThreadName(const String& name);
+
+		/// Records an event from its construction to its destruction if tracing is enabled
+		class Scope {
+		public:
+			Scope(Category category, const char* name) :
+				mCategory(category), mName(name), mBegin(enabled() ? now() : 0) { }
+			~Scope() {
+				if (mBegin != 0)
+					record(mCategory, mName, mBegin, now());
+			}
+
+		private:
+			Category mCategory;
+			const char* mName;
+			std::uint64_t mBegin;
+		};
+
+	private:
+		static std::atomic<Bool> sEnabled;
+	};
+}
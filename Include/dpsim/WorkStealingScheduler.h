@@ -0,0 +1,101 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+	/// Chase-Lev deque of task indices. Only the owning thread pushes and takes
+	/// at the bottom, all other threads steal from the top.
+	/// The capacity is fixed because every task is pushed at most once per step.
+	class WorkStealingDeque {
+	public:
+		void resize(std::size_t capacity);
+		/// Must only be called while no thread accesses the deque
+		void clear() {
+			mTop.store(0, std::memory_order_relaxed);
+			mBottom.store(0, std::memory_order_relaxed);
+		}
+		/// Called by the owner
+		void push(Int task);
+		/// Called by the owner, returns -1 if the deque is empty
+		Int take();
+		/// Called by other threads, returns -1 if the deque is empty or the steal failed
+		Int steal();
+
+	private:
+		alignas(64) std::atomic<std::int64_t> mTop{0};
+		alignas(64) std::atomic<std::int64_t> mBottom{0};
+		std::unique_ptr<std::atomic<Int>[]> mTasks;
+		std::int64_t mMask = 0;
+	};
+
+	/// Scheduler that distributes the tasks dynamically at every step.
+	/// A task becomes ready when the dependency counts of all its predecessors
+	/// reached zero and is pushed to the deque of the thread which completed
+	/// the last predecessor. Idle threads steal tasks from the other deques.
+	class WorkStealingScheduler : public Scheduler {
+	public:
+		/// With spinIterations > 0, idle threads spin this many times before they
+		/// park on a condition variable between steps. With 0, they only spin.
+		WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(), UInt spinIterations = 0);
+		virtual ~WorkStealingScheduler();
+
+		void createSchedule(const CPS::Task::List& tasks, const Edges& inEdges, const Edges& outEdges);
+		void step(Real time, Int timeStepCount);
+		void stop();
+		Int threads() const { return mNumThreads; }
+
+	private:
+		/// Executes tasks until all tasks of the current step are finished
+		void doStep(Int thread);
+		/// Waits for the start of the next step, returns false if the scheduler is stopped
+		Bool waitForStep(Int thread, Int& generation);
+		static void threadFunction(WorkStealingScheduler* sched, Int thread, Int generation);
+		/// Wakes up and joins the helper threads
+		void joinThreads();
+
+		Int mNumThreads;
+		String mOutMeasurementFile;
+		UInt mSpinIterations;
+
+		/// Scheduled tasks in topological order
+		std::vector<CPS::Task*> mTasks;
+		/// Successors of task i are mSuccessors[mSuccessorOffsets[i] .. mSuccessorOffsets[i+1]]
+		std::vector<Int> mSuccessorOffsets;
+		std::vector<Int> mSuccessors;
+		/// Number of predecessors of each task
+		std::vector<Int> mDependencyCounts;
+		/// Tasks without predecessors
+		std::vector<Int> mRootTasks;
+		/// Number of unfinished predecessors of each task in the current step
+		std::unique_ptr<std::atomic<Int>[]> mPending;
+		/// Number of unfinished tasks in the current step
+		std::atomic<Int> mRemaining{0};
+
+		std::vector<std::unique_ptr<WorkStealingDeque>> mDeques;
+		std::vector<std::thread> mThreads;
+
+		/// Incremented to start a step
+		std::atomic<Int> mGeneration{0};
+		/// Number of helper threads which finished the current step
+		std::atomic<Int> mFinished{0};
+		std::atomic<Bool> mJoining{false};
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+
+		Real mTime = 0;
+		Int mTimeStepCount = 0;
+	};
+}
@@ -7,27 +7,51 @@
  *********************************************************************************/
 
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <fcntl.h>
+
+#ifdef _WIN32
+  #include <io.h>
+#else
+  #include <unistd.h>
+#endif
 
 #include <dpsim/DataLogger.h>
 #include <cps/Logger.h>
 
 using namespace DPsim;
 
+/// Size of the buffer collecting rows of binary log files before they are written
+static const std::size_t binaryBufferSize = 1 << 20;
+/// The rows of binary log files start at a multiple of this offset
+static const std::size_t binaryHeaderAlignment = 64;
+
 DataLogger::DataLogger(Bool enabled) :
 	mLogFile(),
 	mEnabled(enabled),
 	mDownsampling(1) {
 	mLogFile.setstate(std::ios_base::badbit);
+
+	AttributeList::addAttribute<Int>("overruns", nullptr, [this](){ return mOverruns.load(); }, CPS::Flags::read);
+	AttributeList::addAttribute<Int>("dropped", nullptr, [this](){ return mDropped.load(); }, CPS::Flags::read);
 }
 
-DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
+DataLogger::DataLogger(String name, Bool enabled, UInt downsampling, Format format) :
 	mName(name),
 	mEnabled(enabled),
-	mDownsampling(downsampling) {
+	mDownsampling(downsampling),
+	mFormat(format) {
+
+	AttributeList::addAttribute<Int>("overruns", nullptr, [this](){ return mOverruns.load(); }, CPS::Flags::read);
+	AttributeList::addAttribute<Int>("dropped", nullptr, [this](){ return mDropped.load(); }, CPS::Flags::read);
+
 	if (!mEnabled)
 		return;
 
-	mFilename = CPS::Logger::logDir() + "/" + name + ".csv";
+	mFilename = CPS::Logger::logDir() + "/" + name + (mFormat == Format::Binary ? ".bin" : ".csv");
 
 	if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
 		fs::create_directory(mFilename.parent_path());
@@ -35,7 +59,30 @@ DataLogger::DataLogger(String name, Bool enabled, UInt downsampling) :
 	open();
 }
 
+DataLogger::~DataLogger() {
+	close();
+}
+
 void DataLogger::open() {
+	mColumnsReady = false;
+	mColumns.clear();
+
+	if (mFormat == Format::Binary) {
+#ifdef _WIN32
+		mFd = ::_open(mFilename.string().c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+		mFd = ::open(mFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+		mFileOffset = 0;
+		mBufferUsed = 0;
+		mBuffer.resize(binaryBufferSize);
+		if (mFd < 0) {
+			std::cerr << "Cannot open log file " << mFilename << std::endl;
+			mEnabled = false;
+		}
+		return;
+	}
+
 	mLogFile = std::ofstream(mFilename, std::ios_base::out|std::ios_base::trunc);
 	if (!mLogFile.is_open()) {
 		// TODO: replace by exception
@@ -45,10 +92,119 @@ void DataLogger::open() {
 }
 
 void DataLogger::close() {
+	stopWriter();
+
+	if (mFd >= 0) {
+		flushBinary();
+#ifdef _WIN32
+		::_close(mFd);
+#else
+		::close(mFd);
+#endif
+		mFd = -1;
+	}
 	mLogFile.close();
 }
 
+Bool DataLogger::isEmpty() {
+	if (mFormat == Format::Binary)
+		return mFileOffset == 0 && mBufferUsed == 0;
+
+	return mLogFile.tellp() == std::ofstream::pos_type(0);
+}
+
+// Layout of binary log files, all numbers in little endian:
+//   char[8]  magic "DPSIMLOG"
+//   uint32   version
+//   uint32   number of columns including the time
+//   uint32   downsampling
+//   uint32   offset of the first row
+//   per column: char type ('f' float64, 'i' int64), uint8 padding,
+//               uint16 length of the name, name without terminating zero
+//   zero padding up to the offset of the first row
+//   rows of 8 byte values, the first column is the time
+void DataLogger::writeBinaryHeader(const std::vector<String> &names, const std::vector<char> &types) {
+	if (!mEnabled)
+		return;
+
+	std::vector<char> header(8);
+	std::memcpy(header.data(), "DPSIMLOG", 8);
+
+	auto append = [&header](const void *data, std::size_t size) {
+		const char *bytes = static_cast<const char *>(data);
+		header.insert(header.end(), bytes, bytes + size);
+	};
+	auto appendColumn = [&append](const String &name, char type) {
+		std::uint8_t padding = 0;
+		std::uint16_t length = static_cast<std::uint16_t>(name.size());
+		append(&type, 1);
+		append(&padding, 1);
+		append(&length, 2);
+		append(name.data(), length);
+	};
+
+	std::uint32_t version = 1;
+	std::uint32_t numColumns = static_cast<std::uint32_t>(names.size() + 1);
+	std::uint32_t downsampling = mDownsampling;
+	std::uint32_t dataOffset = 0;
+	append(&version, 4);
+	append(&numColumns, 4);
+	append(&downsampling, 4);
+	append(&dataOffset, 4);
+
+	appendColumn("time", 'f');
+	for (std::size_t i = 0; i < names.size(); ++i)
+		appendColumn(names[i], types[i]);
+
+	header.resize((header.size() + binaryHeaderAlignment - 1) / binaryHeaderAlignment * binaryHeaderAlignment, 0);
+	dataOffset = static_cast<std::uint32_t>(header.size());
+	std::memcpy(header.data() + 20, &dataOffset, 4);
+
+	writeBinary(header.data(), header.size());
+}
+
+void DataLogger::writeBinary(const void *data, std::size_t size) {
+	if (mBufferUsed + size > mBuffer.size()) {
+		flushBinary();
+		if (size > mBuffer.size())
+			mBuffer.resize(size);
+	}
+	std::memcpy(mBuffer.data() + mBufferUsed, data, size);
+	mBufferUsed += size;
+}
+
+void DataLogger::flushBinary() {
+	const char *data = mBuffer.data();
+	std::size_t remaining = mBufferUsed;
+	mBufferUsed = 0;
+	if (mFd < 0)
+		return;
+
+	while (remaining > 0) {
+#ifdef _WIN32
+		::_lseeki64(mFd, mFileOffset, SEEK_SET);
+		auto written = ::_write(mFd, data, static_cast<unsigned int>(remaining));
+#else
+		auto written = ::pwrite(mFd, data, remaining, mFileOffset);
+#endif
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			throw CPS::SystemError("Cannot write log file " + mFilename.string(), errno);
+		}
+		data += written;
+		remaining -= written;
+		mFileOffset += written;
+	}
+}
+
 void DataLogger::setColumnNames(std::vector<String> names) {
+	if (mFormat == Format::Binary) {
+		if (isEmpty())
+			writeBinaryHeader(names, std::vector<char>(names.size(), 'f'));
+		return;
+	}
+
 	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
 		mLogFile << std::right << std::setw(14) << "time";
 		for (auto name : names) {
@@ -62,6 +218,12 @@ void DataLogger::logDataLine(Real time, Real data) {
 	if (!mEnabled)
 		return;
 
+	if (mFormat == Format::Binary) {
+		writeBinary(&time, sizeof(Real));
+		writeBinary(&data, sizeof(Real));
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	mLogFile << ", " << std::right << std::setw(13) << data;
 	mLogFile << '\n';
@@ -71,6 +233,13 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 	if (!mEnabled)
 		return;
 
+	if (mFormat == Format::Binary) {
+		// Only the first column is logged, which is contiguous in memory
+		writeBinary(&time, sizeof(Real));
+		writeBinary(data.data(), data.rows() * sizeof(Real));
+		return;
+	}
+
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -81,6 +250,13 @@ void DataLogger::logDataLine(Real time, const Matrix& data) {
 void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 	if (!mEnabled)
 		return;
+
+	if (mFormat == Format::Binary) {
+		// Real and imaginary part of each entry as two columns
+		writeBinary(&time, sizeof(Real));
+		writeBinary(data.data(), data.rows() * sizeof(Complex));
+		return;
+	}
 	mLogFile << std::scientific << std::right << std::setw(14) << time;
 	for (Int i = 0; i < data.rows(); ++i) {
 		mLogFile << ", " << std::right << std::setw(13) << data(i, 0);
@@ -89,7 +265,7 @@ void DataLogger::logDataLine(Real time, const MatrixComp& data) {
 }
 
 void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (isEmpty()) {
 		std::vector<String> names;
 
 		Int harmonicOffset = data.rows() / freqNum;
@@ -115,7 +291,7 @@ void DataLogger::logPhasorNodeValues(Real time, const Matrix& data, Int freqNum)
 }
 
 void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	if (isEmpty()) {
 		std::vector<String> names;
 		for (Int i = 0; i < data.rows(); ++i) {
 			std::stringstream name;
@@ -127,23 +303,190 @@ void DataLogger::logEMTNodeValues(Real time, const Matrix& data) {
 	logDataLine(time, data);
 }
 
-void DataLogger::log(Real time, Int timeStepCount) {
-	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+void DataLogger::start() {
+	if (!mEnabled || mColumnsReady)
 		return;
 
-	if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
+	std::vector<String> names;
+	std::vector<char> types;
+	mColumns.clear();
+	mRealAddresses.clear();
+	mIntAddresses.clear();
+	mGetterColumns.clear();
+	for (auto it : mAttributes) {
+		Column column;
+		column.integer = std::dynamic_pointer_cast<CPS::Attribute<Int>>(it.second);
+		column.real = std::dynamic_pointer_cast<CPS::Attribute<Real>>(it.second);
+		if (!column.integer && !column.real)
+			throw CPS::InvalidAttributeException();
+
+		// Resolve derived attributes like matrix coefficients to the underlying memory once
+		std::size_t index = mColumns.size() + 1;
+		const Real *realAddress = column.real ? column.real->address() : nullptr;
+		const Int *intAddress = column.integer ? column.integer->address() : nullptr;
+		if (realAddress)
+			mRealAddresses.emplace_back(index, realAddress);
+		else if (intAddress)
+			mIntAddresses.emplace_back(index, intAddress);
+		else
+			mGetterColumns.push_back(index);
+
+		mColumns.push_back(column);
+		names.push_back(it.first);
+		types.push_back(column.integer ? 'i' : 'f');
+	}
+	mRow.resize(mColumns.size() + 1);
+	mIntegerColumns = std::find(types.begin(), types.end(), 'i') != types.end();
+
+	if (mFormat == Format::Binary) {
+		writeBinaryHeader(names, types);
+	}
+	else {
 		mLogFile << std::right << std::setw(14) << "time";
-		for (auto it : mAttributes)
-			mLogFile << ", " << std::right << std::setw(13) << it.first;
+		for (auto &name : names)
+			mLogFile << ", " << std::right << std::setw(13) << name;
 		mLogFile << '\n';
 	}
 
-	mLogFile << std::scientific << std::right << std::setw(14) << time;
-	for (auto it : mAttributes)
-		mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
+	if (mAsync) {
+		mRing.resize(mRingCapacity, mRow.size());
+		mOverflowRows.clear();
+		mOverflowing = false;
+		mStopWriter = false;
+		mWriter = std::thread(&DataLogger::runWriter, this);
+	}
+	mColumnsReady = true;
+}
+
+void DataLogger::captureRow(Real time, Real *row) {
+	row[0] = time;
+	for (auto &value : mRealAddresses)
+		row[value.first] = *value.second;
+	for (auto &value : mIntAddresses)
+		row[value.first] = *value.second;
+	for (auto index : mGetterColumns) {
+		auto &column = mColumns[index - 1];
+		if (column.integer)
+			row[index] = column.integer->getByValue();
+		else
+			row[index] = column.real->getByValue();
+	}
+}
+
+void DataLogger::writeRow(const Real *row) {
+	if (mFormat == Format::Binary) {
+		if (!mIntegerColumns) {
+			writeBinary(row, mRow.size() * sizeof(Real));
+			return;
+		}
+		writeBinary(&row[0], sizeof(Real));
+		for (std::size_t i = 0; i < mColumns.size(); ++i) {
+			if (mColumns[i].integer) {
+				std::int64_t value = static_cast<std::int64_t>(row[i + 1]);
+				writeBinary(&value, sizeof(value));
+			}
+			else {
+				writeBinary(&row[i + 1], sizeof(Real));
+			}
+		}
+		return;
+	}
+
+	mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+	for (std::size_t i = 0; i < mColumns.size(); ++i) {
+		// Same text as AttributeBase::toString()
+		String value = mColumns[i].integer
+			? std::to_string(static_cast<Int>(row[i + 1]))
+			: std::to_string(row[i + 1]);
+		mLogFile << ", " << std::right << std::setw(13) << value;
+	}
 	mLogFile << '\n';
 }
 
+void DataLogger::log(Real time, Int timeStepCount) {
+	if (!mEnabled || !(timeStepCount % mDownsampling == 0))
+		return;
+
+	if (!mColumnsReady)
+		start();
+
+	if (!mAsync) {
+		captureRow(time, mRow.data());
+		writeRow(mRow.data());
+		return;
+	}
+
+	Real *row = mOverflowing.load(std::memory_order_acquire) ? nullptr : mRing.pushBegin();
+	if (row) {
+		captureRow(time, row);
+		mRing.pushEnd();
+		return;
+	}
+
+	mOverruns.fetch_add(1, std::memory_order_relaxed);
+	switch (mOverflowPolicy) {
+	case OverflowPolicy::Drop:
+		mDropped.fetch_add(1, std::memory_order_relaxed);
+		break;
+	case OverflowPolicy::Block:
+		while (!(row = mRing.pushBegin()))
+			std::this_thread::yield();
+		captureRow(time, row);
+		mRing.pushEnd();
+		break;
+	case OverflowPolicy::Grow: {
+		captureRow(time, mRow.data());
+		std::lock_guard<std::mutex> lock(mOverflowMutex);
+		mOverflowRows.insert(mOverflowRows.end(), mRow.begin(), mRow.end());
+		mOverflowing.store(true, std::memory_order_release);
+		break;
+	}
+	}
+}
+
+std::size_t DataLogger::drainRows() {
+	std::vector<Real> overflow;
+	std::size_t limit;
+	{
+		// Rows in the ring up to this point are older than all overflow rows
+		std::lock_guard<std::mutex> lock(mOverflowMutex);
+		limit = mRing.pushed();
+		overflow.swap(mOverflowRows);
+		mOverflowing.store(false, std::memory_order_release);
+	}
+
+	std::size_t count = 0;
+	while (const Real *row = mRing.front(limit)) {
+		writeRow(row);
+		mRing.pop();
+		++count;
+	}
+	for (std::size_t i = 0; i < overflow.size(); i += mRing.width()) {
+		writeRow(&overflow[i]);
+		++count;
+	}
+	return count;
+}
+
+void DataLogger::runWriter() {
+	while (true) {
+		Bool stop = mStopWriter.load(std::memory_order_acquire);
+		if (drainRows() == 0) {
+			if (stop)
+				break;
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+}
+
+void DataLogger::stopWriter() {
+	if (!mWriter.joinable())
+		return;
+
+	mStopWriter.store(true, std::memory_order_release);
+	mWriter.join();
+}
+
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
 	mLogger.log(time, timeStepCount);
 }
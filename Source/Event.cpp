@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <limits>
+
 #include <dpsim/Event.h>
 
 using namespace DPsim;
@@ -31,3 +33,20 @@ void EventQueue::handleEvents(Real currentTime) {
 		}
 	}
 }
+
+std::vector<Event::Ptr> EventQueue::events() const {
+	std::vector<Event::Ptr> events;
+	auto queue = mEvents;
+
+	while (!queue.empty()) {
+		events.push_back(queue.top());
+		queue.pop();
+	}
+	return events;
+}
+
+Real EventQueue::nextEventTime() const {
+	if (mEvents.empty())
+		return std::numeric_limits<Real>::infinity();
+	return mEvents.top()->mTime;
+}
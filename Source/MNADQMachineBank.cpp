@@ -0,0 +1,320 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cmath>
+
+#include <dpsim/MNADQMachineBank.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+typedef MNADQMachineBatchInterface::DQMachineBatchModel DQMachineBatchModel;
+
+/// Checks if I - dt/2 A is diagonally dominant for rotor speeds between 0 and 2.
+/// As the diagonal is affine and the off-diagonal row sums are convex in the
+/// rotor speed, it is sufficient to check both bounds.
+static Bool diagonallyDominant(const DQMachineBatchModel& model) {
+	const Int states = MNADQMachineBatchInterface::NumStates;
+	if (model.fluxStateMat->rows() != states || model.fluxStateMat->cols() != states
+		|| model.omegaFluxMat->rows() != states || model.omegaFluxMat->cols() != states)
+		return false;
+
+	for (Int i = 0; i < states; i++) {
+		Real diag[2], offDiag[2];
+		for (Int bound = 0; bound < 2; bound++) {
+			Matrix row = -(model.timeStep / 2.) * model.baseOmElec
+				* (model.fluxStateMat->row(i) + 2. * bound * model.omegaFluxMat->row(i));
+			row(0, i) += 1.;
+			diag[bound] = row(0, i);
+			offDiag[bound] = row.cwiseAbs().sum() - std::abs(row(0, i));
+		}
+		if (diag[0] * diag[1] <= 0
+			|| std::min(std::abs(diag[0]), std::abs(diag[1])) <= std::max(offDiag[0], offDiag[1]))
+			return false;
+	}
+	return true;
+}
+
+Bool MnaDQMachineBank::addMachine(MNAInterface::Ptr machine) {
+	auto batchMachine = std::dynamic_pointer_cast<MNADQMachineBatchInterface>(machine);
+	if (!batchMachine)
+		return false;
+
+	DQMachineBatchModel model;
+	if (!batchMachine->mnaBatchMachine(model))
+		return false;
+	if (!mModels.empty() && model.trapezoidal != mTrapezoidal)
+		return false;
+	if (model.trapezoidal && (*model.omega < 0 || *model.omega > 2 || !diagonallyDominant(model)))
+		return false;
+
+	mTrapezoidal = model.trapezoidal;
+	batchMachine->mnaRemoveBatchedTasks();
+	mMachines.push_back(machine);
+	mBatchMachines.push_back(batchMachine);
+	mModels.push_back(model);
+	return true;
+}
+
+void MnaDQMachineBank::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	MNAInterface::mnaInitialize(omega, timeStep);
+	mTimeStep = timeStep;
+	mRightVector = Matrix::Zero(0, 0);
+
+	UInt n = size();
+	mBaseOmElec.resize(n); mBaseOmMech.resize(n); mBaseVoltage.resize(n); mBaseCurrent.resize(n);
+	mInertia.resize(n); mMechTorque.resize(n);
+	mFluxStateMat.resize(S * S * n); mOmegaFluxMat.resize(S * S * n); mFluxToCurrentMat.resize(S * S * n);
+	mNodes.resize(3 * n);
+	mOmega.resize(n); mTheta.resize(n); mElecTorque.resize(n);
+	mFluxes.resize(S * n); mCurrents.resize(S * n); mVoltages.resize(S * n);
+	mVoltRe.resize(3 * n); mVoltIm.resize(3 * n); mCurrRe.resize(3 * n); mCurrIm.resize(3 * n);
+	mStateMat.resize(S * S * n); mLu.resize(S * S * n); mRhs.resize(S * n);
+
+	for (UInt k = 0; k < n; k++) {
+		auto& model = mModels[k];
+		mBaseOmElec[k] = model.baseOmElec;
+		mBaseOmMech[k] = model.baseOmMech;
+		mBaseVoltage[k] = model.baseVoltage;
+		mBaseCurrent[k] = model.baseCurrent;
+		for (Int i = 0; i < S; i++) {
+			for (Int j = 0; j < S; j++) {
+				entry(mFluxStateMat, i, j)[k] = (*model.fluxStateMat)(i, j);
+				entry(mOmegaFluxMat, i, j)[k] = (*model.omegaFluxMat)(i, j);
+				entry(mFluxToCurrentMat, i, j)[k] = (*model.fluxToCurrentMat)(i, j);
+			}
+			entry(mFluxes, i)[k] = (*model.fluxes)(i, 0);
+			entry(mCurrents, i)[k] = (*model.currents)(i, 0);
+			entry(mVoltages, i)[k] = (*model.voltages)(i, 0);
+		}
+		for (Int phase = 0; phase < 3; phase++) {
+			entry(mNodes, phase)[k] = model.nodes[phase];
+			entry(mVoltRe, phase)[k] = (*model.intfVoltage)(phase, 0).real();
+			entry(mVoltIm, phase)[k] = (*model.intfVoltage)(phase, 0).imag();
+		}
+		mOmega[k] = *model.omega;
+		mTheta[k] = *model.theta;
+		mElecTorque[k] = *model.elecTorque;
+	}
+
+	// The complex solution vector contains all real parts followed by all imaginary parts
+	mImagOffset = static_cast<Int>(leftVector->get().rows() / 2);
+	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
+	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
+}
+
+void MnaDQMachineBank::mnaPreStep(Real time, Int timeStepCount) {
+	const UInt n = size();
+	const Real dt = mTimeStep;
+	const Real sqrt3Half = std::sqrt(3.) / 2.;
+
+	// Parameters that may have been changed through attributes
+	for (UInt k = 0; k < n; k++) {
+		mInertia[k] = *mModels[k].inertia;
+		mMechTorque[k] = *mModels[k].mechTorque;
+	}
+
+	// Per unit dq0 voltages from the positive sequence of the terminal voltages
+	const Real *vaRe = entry(mVoltRe, 0), *vbRe = entry(mVoltRe, 1), *vcRe = entry(mVoltRe, 2);
+	const Real *vaIm = entry(mVoltIm, 0), *vbIm = entry(mVoltIm, 1), *vcIm = entry(mVoltIm, 2);
+	Real *vd = entry(mVoltages, 0), *vq = entry(mVoltages, 3), *v0 = entry(mVoltages, 6);
+	for (UInt k = 0; k < n; k++) {
+		Real posRe = (vaRe[k] - 0.5 * (vbRe[k] + vcRe[k]) - sqrt3Half * (vbIm[k] - vcIm[k])) / 3.;
+		Real posIm = (vaIm[k] - 0.5 * (vbIm[k] + vcIm[k]) + sqrt3Half * (vbRe[k] - vcRe[k])) / 3.;
+		Real cosTheta = std::cos(mTheta[k]), sinTheta = std::sin(mTheta[k]);
+		vd[k] = (posRe * cosTheta + posIm * sinTheta) / mBaseVoltage[k];
+		vq[k] = (posIm * cosTheta - posRe * sinTheta) / mBaseVoltage[k];
+		v0[k] = 0;
+	}
+
+	// Electrical torque, rotor angle and rotor speed with forward Euler
+	const Real *psiD = entry(mFluxes, 0), *psiQ = entry(mFluxes, 3);
+	Real *iD = entry(mCurrents, 0), *iQ = entry(mCurrents, 3);
+	for (UInt k = 0; k < n; k++) {
+		mElecTorque[k] = psiQ[k] * iD[k] - psiD[k] * iQ[k];
+		mTheta[k] = mTheta[k] + dt * ((mOmega[k] - 1) * mBaseOmMech[k]);
+		mOmega[k] = mOmega[k] + dt * (1. / (2. * mInertia[k]) * (mMechTorque[k] - mElecTorque[k]));
+	}
+
+	// State matrices A = w_base (F + W w_r)
+	for (Int i = 0; i < S; i++) {
+		for (Int j = 0; j < S; j++) {
+			Real *a = entry(mStateMat, i, j);
+			const Real *f = entry(mFluxStateMat, i, j), *w = entry(mOmegaFluxMat, i, j);
+			for (UInt k = 0; k < n; k++)
+				a[k] = mBaseOmElec[k] * (f[k] + w[k] * mOmega[k]);
+		}
+	}
+
+	if (mTrapezoidal)
+		stepTrapezoidal();
+	else
+		stepEuler();
+
+	// Currents from the fluxes
+	for (Int i = 0; i < S; i++) {
+		Real *current = entry(mCurrents, i);
+		for (UInt k = 0; k < n; k++)
+			current[k] = 0;
+		for (Int j = 0; j < S; j++) {
+			const Real *c = entry(mFluxToCurrentMat, i, j), *psi = entry(mFluxes, j);
+			for (UInt k = 0; k < n; k++)
+				current[k] += c[k] * psi[k];
+		}
+	}
+
+	// Interface currents from the dq currents, the zero sequence is ignored
+	Real *iaRe = entry(mCurrRe, 0), *ibRe = entry(mCurrRe, 1), *icRe = entry(mCurrRe, 2);
+	Real *iaIm = entry(mCurrIm, 0), *ibIm = entry(mCurrIm, 1), *icIm = entry(mCurrIm, 2);
+	for (UInt k = 0; k < n; k++) {
+		Real cosTheta = std::cos(mTheta[k]), sinTheta = std::sin(mTheta[k]);
+		Real posRe = mBaseCurrent[k] * (iD[k] * cosTheta - iQ[k] * sinTheta);
+		Real posIm = mBaseCurrent[k] * (iD[k] * sinTheta + iQ[k] * cosTheta);
+		iaRe[k] = posRe;
+		iaIm[k] = posIm;
+		ibRe[k] = -0.5 * posRe + sqrt3Half * posIm;
+		ibIm[k] = -0.5 * posIm - sqrt3Half * posRe;
+		icRe[k] = -0.5 * posRe - sqrt3Half * posIm;
+		icIm[k] = -0.5 * posIm + sqrt3Half * posRe;
+	}
+
+	for (UInt k = 0; k < n; k++) {
+		auto& model = mModels[k];
+		*model.omega = mOmega[k];
+		*model.theta = mTheta[k];
+		*model.elecTorque = mElecTorque[k];
+		for (Int i = 0; i < S; i++) {
+			(*model.fluxes)(i, 0) = entry(mFluxes, i)[k];
+			(*model.currents)(i, 0) = entry(mCurrents, i)[k];
+		}
+		(*model.voltages)(0, 0) = vd[k];
+		(*model.voltages)(3, 0) = vq[k];
+		(*model.voltages)(6, 0) = v0[k];
+		*model.voltageDq0 << vd[k], vq[k], v0[k];
+		*model.currentDq0 << iD[k], iQ[k], entry(mCurrents, 6)[k];
+		for (Int phase = 0; phase < 3; phase++)
+			(*model.intfCurrent)(phase, 0) = Complex(entry(mCurrRe, phase)[k], entry(mCurrIm, phase)[k]);
+		mBatchMachines[k]->mnaBatchUpdateRightVector();
+	}
+}
+
+void MnaDQMachineBank::stepTrapezoidal() {
+	const UInt n = size();
+	const Real dt = mTimeStep;
+
+	// Right side (I + dt/2 A) psi + dt w_base v
+	for (Int i = 0; i < S; i++) {
+		Real *rhs = entry(mRhs, i);
+		const Real *psi = entry(mFluxes, i), *v = entry(mVoltages, i);
+		for (UInt k = 0; k < n; k++)
+			rhs[k] = psi[k] + dt * mBaseOmElec[k] * v[k];
+		for (Int j = 0; j < S; j++) {
+			const Real *a = entry(mStateMat, i, j), *psiJ = entry(mFluxes, j);
+			for (UInt k = 0; k < n; k++)
+				rhs[k] += (dt / 2.) * a[k] * psiJ[k];
+		}
+	}
+
+	// Matrix I - dt/2 A
+	for (Int i = 0; i < S; i++) {
+		for (Int j = 0; j < S; j++) {
+			Real *lu = entry(mLu, i, j);
+			const Real *a = entry(mStateMat, i, j);
+			const Real diag = i == j ? 1. : 0.;
+			for (UInt k = 0; k < n; k++)
+				lu[k] = diag - (dt / 2.) * a[k];
+		}
+	}
+
+	// Gaussian elimination of all machines at once, which needs no pivoting
+	// as the matrices are diagonally dominant
+	for (Int p = 0; p < S; p++) {
+		const Real *pivot = entry(mLu, p, p), *rhsP = entry(mRhs, p);
+		for (Int i = p + 1; i < S; i++) {
+			Real *factor = entry(mLu, i, p), *rhsI = entry(mRhs, i);
+			for (UInt k = 0; k < n; k++)
+				factor[k] /= pivot[k];
+			for (Int j = p + 1; j < S; j++) {
+				Real *luIJ = entry(mLu, i, j);
+				const Real *luPJ = entry(mLu, p, j);
+				for (UInt k = 0; k < n; k++)
+					luIJ[k] -= factor[k] * luPJ[k];
+			}
+			for (UInt k = 0; k < n; k++)
+				rhsI[k] -= factor[k] * rhsP[k];
+		}
+	}
+
+	// Back substitution into the fluxes
+	for (Int i = S - 1; i >= 0; i--) {
+		Real *psi = entry(mFluxes, i);
+		const Real *rhs = entry(mRhs, i), *diag = entry(mLu, i, i);
+		for (UInt k = 0; k < n; k++)
+			psi[k] = rhs[k];
+		for (Int j = i + 1; j < S; j++) {
+			const Real *luIJ = entry(mLu, i, j), *psiJ = entry(mFluxes, j);
+			for (UInt k = 0; k < n; k++)
+				psi[k] -= luIJ[k] * psiJ[k];
+		}
+		for (UInt k = 0; k < n; k++)
+			psi[k] /= diag[k];
+	}
+}
+
+void MnaDQMachineBank::stepEuler() {
+	const UInt n = size();
+	const Real dt = mTimeStep;
+
+	// psi + dt (A psi + w_base v)
+	for (Int i = 0; i < S; i++) {
+		Real *rhs = entry(mRhs, i);
+		const Real *psi = entry(mFluxes, i), *v = entry(mVoltages, i);
+		for (UInt k = 0; k < n; k++)
+			rhs[k] = psi[k] + dt * mBaseOmElec[k] * v[k];
+		for (Int j = 0; j < S; j++) {
+			const Real *a = entry(mStateMat, i, j), *psiJ = entry(mFluxes, j);
+			for (UInt k = 0; k < n; k++)
+				rhs[k] += dt * a[k] * psiJ[k];
+		}
+	}
+	mFluxes = mRhs;
+}
+
+void MnaDQMachineBank::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	const Matrix& solution = leftVector->get();
+	const UInt n = size();
+
+	for (Int phase = 0; phase < 3; phase++) {
+		const Int *node = entry(mNodes, phase);
+		Real *voltRe = entry(mVoltRe, phase), *voltIm = entry(mVoltIm, phase);
+		for (UInt k = 0; k < n; k++) {
+			voltRe[k] = node[k] >= 0 ? solution(node[k], 0) : 0;
+			voltIm[k] = node[k] >= 0 ? solution(node[k] + mImagOffset, 0) : 0;
+		}
+	}
+
+	for (UInt k = 0; k < n; k++) {
+		for (Int phase = 0; phase < 3; phase++)
+			(*mModels[k].intfVoltage)(phase, 0) = Complex(entry(mVoltRe, phase)[k], entry(mVoltIm, phase)[k]);
+	}
+}
+
+MnaDQMachineBank::MnaPreStep::MnaPreStep(MnaDQMachineBank& bank) :
+	Task(bank.name() + ".MnaBankPreStep"), mBank(bank) {
+	for (auto machine : bank.mMachines) {
+		mPrevStepDependencies.push_back(machine->attribute("v_intf"));
+		mModifiedAttributes.push_back(machine->attribute("right_vector"));
+	}
+}
+
+MnaDQMachineBank::MnaPostStep::MnaPostStep(MnaDQMachineBank& bank, Attribute<Matrix>::Ptr leftVector) :
+	Task(bank.name() + ".MnaBankPostStep"), mBank(bank), mLeftVector(leftVector) {
+	mAttributeDependencies.push_back(leftVector);
+	for (auto machine : bank.mMachines)
+		mModifiedAttributes.push_back(machine->attribute("v_intf"));
+}
@@ -0,0 +1,202 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/MNALinearBatch.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+Bool MnaLinearBatch::addComponent(MNAInterface::Ptr comp) {
+	auto batchComp = std::dynamic_pointer_cast<MNABatchInterface>(comp);
+	if (!batchComp)
+		return false;
+
+	MNABatchInterface::MnaBatchModel model;
+	if (!batchComp->mnaBatchModel(model))
+		return false;
+
+	mComponents.push_back(comp);
+	mModels.push_back(model);
+	return true;
+}
+
+void MnaLinearBatch::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	MNAInterface::mnaInitialize(omega, timeStep);
+
+	// Components with history current first, so that the pre step only loops over them
+	std::vector<UInt> order(mComponents.size());
+	for (UInt k = 0; k < order.size(); k++)
+		order[k] = k;
+	std::stable_partition(order.begin(), order.end(), [this](UInt k) {
+		return mModels[k].hasHistory;
+	});
+	MNAInterface::List components;
+	std::vector<MNABatchInterface::MnaBatchModel> models;
+	for (auto k : order) {
+		components.push_back(mComponents[k]);
+		models.push_back(mModels[k]);
+	}
+	mComponents = components;
+	mModels = models;
+
+	UInt n = size();
+	mNode0.resize(n);
+	mNode1.resize(n);
+	mCondRe.resize(n); mCondIm.resize(n);
+	mVoltCoeffRe.resize(n); mVoltCoeffIm.resize(n);
+	mCurrCoeffRe.resize(n); mCurrCoeffIm.resize(n);
+	mHistRe.assign(n, 0); mHistIm.assign(n, 0);
+	mVoltRe.resize(n); mVoltIm.resize(n);
+	mCurrRe.resize(n); mCurrIm.resize(n);
+
+	mNumHistory = 0;
+	for (UInt k = 0; k < n; k++) {
+		auto& model = mModels[k];
+		if (model.hasHistory)
+			mNumHistory++;
+		mNode0[k] = model.node0;
+		mNode1[k] = model.node1;
+		mCondRe[k] = model.conductance.real();
+		mCondIm[k] = model.conductance.imag();
+		mVoltCoeffRe[k] = model.voltageCoeff.real();
+		mVoltCoeffIm[k] = model.voltageCoeff.imag();
+		mCurrCoeffRe[k] = model.currentCoeff.real();
+		mCurrCoeffIm[k] = model.currentCoeff.imag();
+		mVoltRe[k] = model.voltage->real();
+		mVoltIm[k] = model.voltage->imag();
+		mCurrRe[k] = model.current->real();
+		mCurrIm[k] = model.current->imag();
+	}
+
+	// The complex vectors contain all real parts followed by all imaginary parts
+	mImagOffset = static_cast<Int>(leftVector->get().rows() / 2);
+	if (mNumHistory > 0) {
+		std::vector<UInt> rows;
+		for (UInt k = 0; k < mNumHistory; k++) {
+			for (Int node : { mNode0[k], mNode1[k] }) {
+				if (node < 0)
+					continue;
+				rows.push_back(node);
+				rows.push_back(node + mImagOffset);
+			}
+		}
+		std::sort(rows.begin(), rows.end());
+		rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+		mnaInitializeRightVector(leftVector->get().rows());
+		mnaSetRightVectorRows(rows);
+
+		// Positions of the node rows in the stored source vector stamp
+		auto position = [&rows](Int row) {
+			return static_cast<Int>(std::lower_bound(rows.begin(), rows.end(), row) - rows.begin());
+		};
+		mPos0.assign(mNumHistory, -1);
+		mPos1.assign(mNumHistory, -1);
+		mPos0Im.assign(mNumHistory, -1);
+		mPos1Im.assign(mNumHistory, -1);
+		for (UInt k = 0; k < mNumHistory; k++) {
+			if (mNode0[k] >= 0) {
+				mPos0[k] = position(mNode0[k]);
+				mPos0Im[k] = position(mNode0[k] + mImagOffset);
+			}
+			if (mNode1[k] >= 0) {
+				mPos1[k] = position(mNode1[k]);
+				mPos1Im[k] = position(mNode1[k] + mImagOffset);
+			}
+		}
+		mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
+	}
+	else {
+		mRightVector = Matrix::Zero(0, 0);
+	}
+	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
+}
+
+void MnaLinearBatch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
+	for (auto comp : mComponents)
+		comp->mnaApplySystemMatrixStamp(systemMatrix);
+}
+
+void MnaLinearBatch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
+	for (auto comp : mComponents)
+		comp->mnaApplyRightSideVectorStamp(rightVector);
+}
+
+void MnaLinearBatch::mnaPreStep(Real time, Int timeStepCount) {
+	const UInt n = mNumHistory;
+
+	// History currents from the voltages and currents of the previous step
+	for (UInt k = 0; k < n; k++) {
+		mHistRe[k] = (mVoltCoeffRe[k] * mVoltRe[k] - mVoltCoeffIm[k] * mVoltIm[k])
+			+ (mCurrCoeffRe[k] * mCurrRe[k] - mCurrCoeffIm[k] * mCurrIm[k]);
+		mHistIm[k] = (mVoltCoeffRe[k] * mVoltIm[k] + mVoltCoeffIm[k] * mVoltRe[k])
+			+ (mCurrCoeffRe[k] * mCurrIm[k] + mCurrCoeffIm[k] * mCurrRe[k]);
+	}
+
+	mRightVector.setZero();
+	for (UInt k = 0; k < n; k++) {
+		if (mPos0[k] >= 0) {
+			mRightVector(mPos0[k], 0) += mHistRe[k];
+			mRightVector(mPos0Im[k], 0) += mHistIm[k];
+		}
+		if (mPos1[k] >= 0) {
+			mRightVector(mPos1[k], 0) -= mHistRe[k];
+			mRightVector(mPos1Im[k], 0) -= mHistIm[k];
+		}
+	}
+}
+
+void MnaLinearBatch::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	const Matrix& solution = leftVector->get();
+	const UInt n = size();
+
+	// v1 - v0
+	for (UInt k = 0; k < n; k++) {
+		Real re = 0, im = 0;
+		if (mNode1[k] >= 0) {
+			re = solution(mNode1[k], 0);
+			im = solution(mNode1[k] + mImagOffset, 0);
+		}
+		if (mNode0[k] >= 0) {
+			re = re - solution(mNode0[k], 0);
+			im = im - solution(mNode0[k] + mImagOffset, 0);
+		}
+		mVoltRe[k] = re;
+		mVoltIm[k] = im;
+	}
+
+	// Components without history current have a zero history term
+	for (UInt k = 0; k < n; k++) {
+		mCurrRe[k] = (mCondRe[k] * mVoltRe[k] - mCondIm[k] * mVoltIm[k]) + mHistRe[k];
+		mCurrIm[k] = (mCondRe[k] * mVoltIm[k] + mCondIm[k] * mVoltRe[k]) + mHistIm[k];
+	}
+
+	for (UInt k = 0; k < n; k++) {
+		*mModels[k].voltage = Complex(mVoltRe[k], mVoltIm[k]);
+		*mModels[k].current = Complex(mCurrRe[k], mCurrIm[k]);
+	}
+}
+
+MnaLinearBatch::MnaPreStep::MnaPreStep(MnaLinearBatch& batch) :
+	Task(batch.name() + ".MnaBatchPreStep"), mBatch(batch) {
+	for (UInt k = 0; k < batch.mNumHistory; k++) {
+		mPrevStepDependencies.push_back(batch.mComponents[k]->attribute("v_intf"));
+		mPrevStepDependencies.push_back(batch.mComponents[k]->attribute("i_intf"));
+	}
+	mModifiedAttributes.push_back(batch.attribute("right_vector"));
+}
+
+MnaLinearBatch::MnaPostStep::MnaPostStep(MnaLinearBatch& batch, Attribute<Matrix>::Ptr leftVector) :
+	Task(batch.name() + ".MnaBatchPostStep"), mBatch(batch), mLeftVector(leftVector) {
+	mAttributeDependencies.push_back(leftVector);
+	for (auto comp : batch.mComponents) {
+		mModifiedAttributes.push_back(comp->attribute("v_intf"));
+		mModifiedAttributes.push_back(comp->attribute("i_intf"));
+	}
+}
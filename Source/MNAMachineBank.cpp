@@ -0,0 +1,148 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cmath>
+
+#include <dpsim/MNAMachineBank.h>
+#include <cps/TopologicalPowerComp.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+Bool MnaMachineBank::addMachine(MNAInterface::Ptr machine) {
+	auto batchMachine = std::dynamic_pointer_cast<MNAMachineBatchInterface>(machine);
+	if (!batchMachine)
+		return false;
+
+	MNAMachineBatchInterface::MachineBatchModel model;
+	if (!batchMachine->mnaBatchMachine(model))
+		return false;
+
+	mMachines.push_back(machine);
+	mModels.push_back(model);
+	return true;
+}
+
+void MnaMachineBank::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
+	MNAInterface::mnaInitialize(omega, timeStep);
+	mTimeStep = timeStep;
+	mRightVector = Matrix::Zero(0, 0);
+
+	UInt n = size();
+	mNomOmega.resize(n); mNomPower.resize(n); mDamping.resize(n); mEmfAbs.resize(n);
+	mConvert.resize(n);
+	mInertia.resize(n); mMechPower.resize(n); mIntegrate.resize(n);
+	mOmega.resize(n); mDelta.resize(n); mElecPower.resize(n); mOmegaDeriv.resize(n);
+	mEmfRe.resize(n); mEmfIm.resize(n);
+	mVoltRe.resize(n); mVoltIm.resize(n);
+	mCurrRe.resize(n); mCurrIm.resize(n);
+
+	for (UInt k = 0; k < n; k++) {
+		auto& model = mModels[k];
+		mNomOmega[k] = model.nomOmega;
+		mNomPower[k] = model.nomPower;
+		mDamping[k] = model.damping;
+		mEmfAbs[k] = model.emfAbs;
+		mConvert[k] = model.convertWithOmegaMech ? 1 : 0;
+		mOmega[k] = *model.omega;
+		mDelta[k] = *model.delta;
+		mElecPower[k] = *model.elecPower;
+		mEmfRe[k] = model.emf->real();
+		mEmfIm[k] = model.emf->imag();
+		mVoltRe[k] = model.voltage->real();
+		mVoltIm[k] = model.voltage->imag();
+		mCurrRe[k] = model.current->real();
+		mCurrIm[k] = model.current->imag();
+	}
+
+	// The complex solution vector contains all real parts followed by all imaginary parts
+	mImagOffset = static_cast<Int>(leftVector->get().rows() / 2);
+	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
+	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
+}
+
+void MnaMachineBank::mnaPreStep(Real time, Int timeStepCount) {
+	const UInt n = size();
+
+	// Parameters that may have been changed through attributes
+	for (UInt k = 0; k < n; k++) {
+		mInertia[k] = *mModels[k].inertia;
+		mMechPower[k] = *mModels[k].mechPower;
+		mIntegrate[k] = *mModels[k].behaviour == TopologicalPowerComp::Behaviour::Simulation ? 1 : 0;
+	}
+
+	// Electrical power and rotor speed at step k+1 with forward Euler
+	for (UInt k = 0; k < n; k++) {
+		mElecPower[k] = mVoltRe[k] * (-mCurrRe[k]) - mVoltIm[k] * mCurrIm[k];
+		Real scale = mConvert[k] != 0
+			? mNomOmega[k] * mNomOmega[k] / (2. * mInertia[k] * mNomPower[k] * mOmega[k])
+			: mNomOmega[k] / (2. * mInertia[k] * mNomPower[k]);
+		mOmegaDeriv[k] = scale * (mMechPower[k] - mElecPower[k] - mDamping[k] * (mOmega[k] - mNomOmega[k]));
+		if (mIntegrate[k] != 0)
+			mOmega[k] = mOmega[k] + mTimeStep * mOmegaDeriv[k];
+	}
+
+	// Rotor angle at step k+1 with backward Euler, only the phase of the emf changes
+	for (UInt k = 0; k < n; k++) {
+		if (mIntegrate[k] == 0)
+			continue;
+		mDelta[k] = mDelta[k] + mTimeStep * (mOmega[k] - mNomOmega[k]);
+		mEmfRe[k] = mEmfAbs[k] * std::cos(mDelta[k]);
+		mEmfIm[k] = mEmfAbs[k] * std::sin(mDelta[k]);
+	}
+
+	for (UInt k = 0; k < n; k++) {
+		auto& model = mModels[k];
+		*model.omega = mOmega[k];
+		*model.delta = mDelta[k];
+		*model.elecPower = mElecPower[k];
+		*model.emf = Complex(mEmfRe[k], mEmfIm[k]);
+		model.emfReference->set(*model.emf);
+		if (model.states)
+			*model.states << std::abs(*model.emf), Math::phaseDeg(*model.emf), mElecPower[k], mMechPower[k],
+				mDelta[k], mOmega[k], mOmegaDeriv[k], mOmega[k] - mNomOmega[k], mVoltRe[k], mVoltIm[k];
+	}
+}
+
+void MnaMachineBank::mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector) {
+	const Matrix& solution = leftVector->get();
+	const UInt n = size();
+
+	for (UInt k = 0; k < n; k++) {
+		Int node = mModels[k].node;
+		mVoltRe[k] = node >= 0 ? solution(node, 0) : 0;
+		mVoltIm[k] = node >= 0 ? solution(node + mImagOffset, 0) : 0;
+		Complex current = mModels[k].innerCurrent->get()(0, 0);
+		mCurrRe[k] = current.real();
+		mCurrIm[k] = current.imag();
+	}
+
+	for (UInt k = 0; k < n; k++) {
+		*mModels[k].voltage = Complex(mVoltRe[k], mVoltIm[k]);
+		*mModels[k].current = Complex(mCurrRe[k], mCurrIm[k]);
+	}
+}
+
+MnaMachineBank::MnaPreStep::MnaPreStep(MnaMachineBank& bank) :
+	Task(bank.name() + ".MnaBankPreStep"), mBank(bank) {
+	for (UInt k = 0; k < bank.size(); k++) {
+		mPrevStepDependencies.push_back(bank.mMachines[k]->attribute("v_intf"));
+		mModifiedAttributes.push_back(bank.mModels[k].omegaAttribute);
+		mModifiedAttributes.push_back(bank.mModels[k].deltaAttribute);
+		mModifiedAttributes.push_back(bank.mModels[k].emfReference);
+	}
+}
+
+MnaMachineBank::MnaPostStep::MnaPostStep(MnaMachineBank& bank, Attribute<Matrix>::Ptr leftVector) :
+	Task(bank.name() + ".MnaBankPostStep"), mBank(bank), mLeftVector(leftVector) {
+	mAttributeDependencies.push_back(leftVector);
+	for (UInt k = 0; k < bank.size(); k++) {
+		mAttributeDependencies.push_back(bank.mModels[k].innerCurrent);
+		mModifiedAttributes.push_back(bank.mMachines[k]->attribute("v_intf"));
+	}
+}
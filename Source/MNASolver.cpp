@@ -9,7 +9,13 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/MNALinearBatch.h>
+#include <dpsim/MNAMachineBank.h>
+#include <dpsim/MNADQMachineBank.h>
+#include <dpsim/Trace.h>
 #include <memory>
+#include <map>
+#include <algorithm>
 
 using namespace DPsim;
 using namespace CPS;
@@ -24,6 +30,9 @@ MnaSolver<VarType>::MnaSolver(String name, CPS::Domain domain, CPS::Logger::Leve
 	// Raw source and solution vector logging
 	mLeftVectorLog = std::make_shared<DataLogger>(name + "_LeftVector", logLevel != CPS::Logger::Level::off);
 	mRightVectorLog = std::make_shared<DataLogger>(name + "_RightVector", logLevel != CPS::Logger::Level::off);
+
+	addAttribute<Int>("switched_matrix_builds", &mNumSwitchedMatrixBuilds, Flags::read);
+	addAttribute<Int>("switched_matrix_evictions", &mNumSwitchedMatrixEvictions, Flags::read);
 }
 
 template <typename VarType>
@@ -96,6 +105,79 @@ void MnaSolver<VarType>::initialize() {
 	mSLog->flush();
 }
 
+template <>
+void MnaSolver<Complex>::batchLinearComponents() {
+	std::map<String, MnaLinearBatch::Ptr> batches;
+	MNAInterface::List components;
+
+	for (auto comp : mMNAComponents) {
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		if (idObj && std::dynamic_pointer_cast<MNABatchInterface>(comp)) {
+			auto& batch = batches[idObj->type()];
+			if (!batch)
+				batch = MnaLinearBatch::make(mName + ".Batch." + idObj->type());
+			if (batch->addComponent(comp))
+				continue;
+		}
+		components.push_back(comp);
+	}
+
+	// Batches with a single component only add overhead
+	for (auto& batch : batches) {
+		if (batch.second->size() == 0)
+			continue;
+		if (batch.second->size() == 1) {
+			components.push_back(batch.second->components().front());
+			continue;
+		}
+		batch.second->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		components.push_back(batch.second);
+		mSLog->info("Batched {} components of type {:s}", batch.second->size(), batch.first);
+	}
+	mMNAComponents = components;
+}
+
+template <>
+void MnaSolver<Complex>::batchMachines() {
+	std::map<String, MnaMachineBank::Ptr> banks;
+	std::map<String, MnaDQMachineBank::Ptr> dqBanks;
+
+	for (auto comp : mMNAComponents) {
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		if (!idObj)
+			continue;
+		if (std::dynamic_pointer_cast<MNAMachineBatchInterface>(comp)) {
+			auto& bank = banks[idObj->type()];
+			if (!bank)
+				bank = MnaMachineBank::make(mName + ".Bank." + idObj->type());
+			bank->addMachine(comp);
+		}
+		else if (std::dynamic_pointer_cast<MNADQMachineBatchInterface>(comp)) {
+			auto& bank = dqBanks[idObj->type()];
+			if (!bank)
+				bank = MnaDQMachineBank::make(mName + ".Bank." + idObj->type());
+			bank->addMachine(comp);
+		}
+	}
+
+	// The machines keep their inner components and right side vector stamps,
+	// so the banks are added to the components instead of replacing them
+	for (auto& bank : banks) {
+		if (bank.second->size() == 0)
+			continue;
+		bank.second->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		mMNAComponents.push_back(bank.second);
+		mSLog->info("Batched {} machines of type {:s}", bank.second->size(), bank.first);
+	}
+	for (auto& bank : dqBanks) {
+		if (bank.second->size() == 0)
+			continue;
+		bank.second->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
+		mMNAComponents.push_back(bank.second);
+		mSLog->info("Batched {} machines of type {:s}", bank.second->size(), bank.first);
+	}
+}
+
 template <>
 void MnaSolver<Real>::initializeComponents() {
 	mSLog->info("-- Initialize components from power flow");
@@ -113,10 +195,8 @@ void MnaSolver<Real>::initializeComponents() {
 	// Initialize MNA specific parts of components.
 	for (auto comp : mMNAComponents) {
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-		const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-		if (stamp.size() != 0) {
-			mRightVectorStamps.push_back(&stamp);
-		}
+		initializeRightVectorRows(comp);
+		addRightVectorStamp(comp);
 	}
 	for (auto comp : mSwitches)
 		comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
@@ -144,8 +224,7 @@ void MnaSolver<Complex>::initializeComponents() {
 		for (auto comp : mMNAComponents) {
 			// Initialize MNA specific parts of components.
 			comp->mnaInitializeHarm(mSystem.mSystemOmega, mTimeStep, mLeftVectorHarmAttributes);
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) mRightVectorStamps.push_back(&stamp);
+			addRightVectorStamp(comp);
 		}
 		// Initialize nodes
 		for (UInt nodeIdx = 0; nodeIdx < mNodes.size(); ++nodeIdx) {
@@ -156,16 +235,79 @@ void MnaSolver<Complex>::initializeComponents() {
 		// Initialize MNA specific parts of components.
 		for (auto comp : mMNAComponents) {
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
-			const Matrix& stamp = comp->template attribute<Matrix>("right_vector")->get();
-			if (stamp.size() != 0) {
-				mRightVectorStamps.push_back(&stamp);
-			}
+			initializeRightVectorRows(comp);
 		}
+		if (mBatchLinearComponents)
+			batchLinearComponents();
+		if (mBatchMachines)
+			batchMachines();
+		for (auto comp : mMNAComponents)
+			addRightVectorStamp(comp);
 		for (auto comp : mSwitches)
 			comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, attribute<Matrix>("left_vector"));
 	}
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamp(CPS::MNAInterface::Ptr comp) {
+	if (comp->mnaRightVector().size() != 0)
+		mRightVectorStamps.push_back(comp.get());
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::initializeRightVectorRows(CPS::MNAInterface::Ptr comp) {
+	auto pComp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+	if (pComp)
+		assignRightVectorRows(pComp);
+}
+
+template <typename VarType>
+std::set<UInt> MnaSolver<VarType>::assignRightVectorRows(typename SimPowerComp<VarType>::Ptr comp) {
+	std::set<UInt> indices;
+	for (auto terminal : comp->terminals()) {
+		auto node = terminal->node();
+		if (!node || node->isGround())
+			continue;
+		auto nodeIndices = node->matrixNodeIndices();
+		indices.insert(nodeIndices.begin(), nodeIndices.end());
+	}
+	for (auto node : comp->virtualNodes()) {
+		if (!node || node->isGround())
+			continue;
+		auto nodeIndices = node->matrixNodeIndices();
+		indices.insert(nodeIndices.begin(), nodeIndices.end());
+	}
+	for (auto subComp : comp->subComponents()) {
+		auto subIndices = assignRightVectorRows(subComp);
+		indices.insert(subIndices.begin(), subIndices.end());
+	}
+
+	// Only stamps of the full system size with a single column are stored sparsely
+	auto mnaComp = std::dynamic_pointer_cast<MNAInterface>(comp);
+	if (!mnaComp || mnaComp->mnaRightVector().cols() != 1
+		|| mnaComp->mnaRightVector().rows() != mRightSideVector.rows())
+		return indices;
+
+	// Complex vectors contain the real and imaginary parts of all frequencies
+	// in blocks of the size of the number of matrix node indices
+	std::vector<UInt> rows;
+	for (UInt block = 0; block * mNumMatrixNodeIndices < mRightSideVector.rows(); ++block) {
+		for (auto index : indices)
+			rows.push_back(index + block * mNumMatrixNodeIndices);
+	}
+	std::sort(rows.begin(), rows.end());
+	if (!rows.empty())
+		mnaComp->mnaSetRightVectorRows(rows);
+	return indices;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::sumRightVectorStamps() {
+	mRightSideVector.setZero();
+	for (auto stamp : mRightVectorStamps)
+		stamp->mnaAddRightVector(mRightSideVector);
+}
+
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystem() {
 	mSLog->info("-- Initialize MNA system matrices and source vector");
@@ -205,20 +347,27 @@ void MnaSolver<VarType>::initializeSystemWithParallelFrequencies() {
 
 template <typename VarType>
 void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
-	// iterate over all possible switch state combinations
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		switchedMatrixEmpty(i);
-	}
-
-	if (mSwitches.size() < 1) {
-		switchedMatrixStamp(0, mMNAComponents);
+	if (!precomputesSwitchedMatrices()) {
+		// Only the current switch configuration is built, all others on first use
+		clearSwitchedMatrices();
+		updateSwitchStatus();
 	}
 	else {
-		// Generate switching state dependent system matrices
+		// iterate over all possible switch state combinations
 		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-			switchedMatrixStamp(i, mMNAComponents);
+			switchedMatrixEmpty(i);
+		}
+
+		if (mSwitches.size() < 1) {
+			switchedMatrixStamp(0, mMNAComponents);
+		}
+		else {
+			// Generate switching state dependent system matrices
+			for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
+				switchedMatrixStamp(i, mMNAComponents);
+			}
+			updateSwitchStatus();
 		}
-		updateSwitchStatus();
 	}
 
 	// Initialize source vector for debugging
@@ -240,6 +389,114 @@ void MnaSolver<VarType>::updateSwitchStatus() {
 	for (UInt i = 0; i < mSwitches.size(); ++i) {
 		mCurrentSwitchStatus.set(i, mSwitches[i]->mnaIsClosed());
 	}
+
+	if (!precomputesSwitchedMatrices()
+		&& !(mRequiredSwitchStatusValid && mRequiredSwitchStatus == mCurrentSwitchStatus))
+		requireSwitchedMatrix(mCurrentSwitchStatus);
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::requireSwitchedMatrix(std::bitset<SWITCH_NUM> status) {
+	mRequiredSwitchStatus = status;
+	auto it = mSwitchCacheIndex.find(status);
+	if (it == mSwitchCacheIndex.end()) {
+		mSLog->info("Build system matrix for switch status {:s}", status.to_string());
+		buildSwitchedMatrix(status);
+	}
+	else {
+		mSwitchCacheOrder.splice(mSwitchCacheOrder.begin(), mSwitchCacheOrder, it->second);
+	}
+	mRequiredSwitchStatusValid = true;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::buildSwitchedMatrix(std::bitset<SWITCH_NUM> status) {
+	std::size_t index = status.to_ullong();
+	if (mSwitchCacheIndex.count(status))
+		return;
+
+	{
+		Trace::Scope scope(Trace::Category::Solver, "Switched matrix factorization");
+		switchedMatrixCreate(index);
+		switchedMatrixEmpty(index);
+		switchedMatrixStamp(index, mMNAComponents);
+	}
+
+	mSwitchCacheOrder.push_front(status);
+	mSwitchCacheIndex[status] = mSwitchCacheOrder.begin();
+	mSwitchCacheEntryMemory[status] = switchedMatrixMemory(index);
+	mSwitchCacheMemory += mSwitchCacheEntryMemory[status];
+	++mNumSwitchedMatrixBuilds;
+	evictSwitchedMatrices();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::evictSwitchedMatrices() {
+	if (mSwitchCacheMemoryBudget == 0)
+		return;
+
+	auto it = mSwitchCacheOrder.end();
+	while (mSwitchCacheMemory > mSwitchCacheMemoryBudget && it != mSwitchCacheOrder.begin()) {
+		--it;
+		// The configuration used by the solve task is kept
+		if (*it == mRequiredSwitchStatus)
+			continue;
+
+		auto status = *it;
+		it = mSwitchCacheOrder.erase(it);
+		mSwitchCacheIndex.erase(status);
+		mSwitchCacheMemory -= mSwitchCacheEntryMemory[status];
+		mSwitchCacheEntryMemory.erase(status);
+		switchedMatrixErase(status.to_ullong());
+		++mNumSwitchedMatrixEvictions;
+	}
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::clearSwitchedMatrices() {
+	for (auto status : mSwitchCacheOrder)
+		switchedMatrixErase(status.to_ullong());
+	mSwitchCacheOrder.clear();
+	mSwitchCacheIndex.clear();
+	mSwitchCacheEntryMemory.clear();
+	mSwitchCacheMemory = 0;
+	mRequiredSwitchStatusValid = false;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::warmUpSwitchedMatrices(const std::vector<Event::Ptr>& events) {
+	if (precomputesSwitchedMatrices() || mSwitches.size() == 0)
+		return;
+
+	// Replay the switch events to find the configurations that will be visited
+	std::vector< std::bitset<SWITCH_NUM> > configurations;
+	std::unordered_set< std::bitset<SWITCH_NUM> > visited = { mCurrentSwitchStatus };
+	auto status = mCurrentSwitchStatus;
+	for (std::size_t e = 0; e < events.size(); ++e) {
+		auto event1Ph = std::dynamic_pointer_cast<SwitchEvent>(events[e]);
+		auto event3Ph = std::dynamic_pointer_cast<SwitchEvent3Ph>(events[e]);
+		for (UInt i = 0; i < mSwitches.size(); ++i) {
+			if (event1Ph && event1Ph->switchComponent() == std::dynamic_pointer_cast<Base::Ph1::Switch>(mSwitches[i]))
+				status.set(i, event1Ph->newState());
+			if (event3Ph && event3Ph->switchComponent() == std::dynamic_pointer_cast<Base::Ph3::Switch>(mSwitches[i]))
+				status.set(i, event3Ph->newState());
+		}
+		// Events with the same time are applied together
+		if (e + 1 < events.size() && events[e + 1]->time() == events[e]->time())
+			continue;
+		if (visited.insert(status).second)
+			configurations.push_back(status);
+	}
+	if (configurations.size() == 0)
+		return;
+
+	// The configurations are built before the simulation starts, as stamping
+	// accesses the components that are updated by the step tasks
+	mSLog->info("Warm up {:d} switch configurations", configurations.size());
+	for (auto config : configurations)
+		buildSwitchedMatrix(config);
+	// The configuration of the first step is the most recently used one
+	requireSwitchedMatrix(mCurrentSwitchStatus);
 }
 
 template <typename VarType>
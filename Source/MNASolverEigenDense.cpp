@@ -62,15 +62,52 @@ void MnaSolverEigenDense<VarType>::switchedMatrixStamp(std::size_t swIdx, Int fr
 	mLuFactorizations[bit][freqIdx].compute(sys);
 }
 
+template <>
+void MnaSolverEigenDense<Real>::switchedMatrixCreate(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	mSwitchedMatrices[bit].push_back(Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
+	mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());
+}
+
+template <>
+void MnaSolverEigenDense<Complex>::switchedMatrixCreate(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	if (mFrequencyParallel) {
+		for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
+			mSwitchedMatrices[bit].push_back(Matrix::Zero(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices)));
+			mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());
+		}
+	}
+	else {
+		mSwitchedMatrices[bit].push_back(Matrix::Zero(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
+		mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());
+	}
+}
+
+template <typename VarType>
+void MnaSolverEigenDense<VarType>::switchedMatrixErase(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	mSwitchedMatrices.erase(bit);
+	mLuFactorizations.erase(bit);
+}
+
+template <typename VarType>
+std::size_t MnaSolverEigenDense<VarType>::switchedMatrixMemory(std::size_t index) {
+	std::size_t bytes = 0;
+	// System matrix, LU factors and row permutation
+	for (auto& sys : mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)])
+		bytes += 2 * sys.size() * sizeof(Real) + sys.rows() * sizeof(Int);
+	return bytes;
+}
+
 template <>
 void MnaSolverEigenDense<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-		auto bit = std::bitset<SWITCH_NUM>(i);
-		mSwitchedMatrices[bit].push_back(Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
-		mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());
+	if (precomputesSwitchedMatrices()) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			switchedMatrixCreate(i);
 	}
 	mBaseSystemMatrix = Matrix::Zero(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 }
@@ -80,23 +117,12 @@ void MnaSolverEigenDense<Complex>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	if (mFrequencyParallel) {
-		for (UInt i = 0; i < std::pow(2,mSwitches.size()); ++i) {
-			for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
-				auto bit = std::bitset<SWITCH_NUM>(i);
-				mSwitchedMatrices[bit].push_back(Matrix::Zero(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices)));
-				mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());
-			}
-		}
+	if (precomputesSwitchedMatrices()) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			switchedMatrixCreate(i);
 	}
-	else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-			auto bit = std::bitset<SWITCH_NUM>(i);
-			mSwitchedMatrices[bit].push_back(Matrix::Zero(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
-			mLuFactorizations[bit].push_back(Eigen::PartialPivLU<Matrix>());			
-		}
+	if (!mFrequencyParallel)
 		mBaseSystemMatrix = Matrix::Zero(2 * (mNumTotalMatrixNodeIndices), 2 * (mNumTotalMatrixNodeIndices));
-	}	
 }
 
 template <typename VarType>
@@ -119,19 +145,19 @@ std::shared_ptr<CPS::Task> MnaSolverEigenDense<VarType>::createLogTask()
 
 template <typename VarType>
 void MnaSolverEigenDense<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
 
-	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus][0].solve(mRightSideVector);
+	if (mSwitchedMatrices.size() > 0) {
+		auto lu = mLuFactorizations.find(mCurrentSwitchStatus);
+		if (lu == mLuFactorizations.end() || lu->second.size() == 0)
+			throw SolverException();
+		mLeftSideVector = lu->second[0].solve(mRightSideVector);
+	}
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
 	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
@@ -146,7 +172,7 @@ void MnaSolverEigenDense<VarType>::solveWithHarmonics(Real time, Int timeStepCou
 
 	// Sum of right side vectors (computed by the components' pre-step tasks)
 	for (auto stamp : mRightVectorStamps)
-		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+		mRightSideVectorHarm[freqIdx] += stamp->mnaRightVector().col(freqIdx);
 
 	mLeftSideVectorHarm[freqIdx] =	mLuFactorizations[mCurrentSwitchStatus][freqIdx].solve(mRightSideVectorHarm[freqIdx]);
 }
@@ -36,24 +36,75 @@ void MnaSolverEigenSparse<VarType>::switchedMatrixStamp(std::size_t index, std::
 {
 	auto bit = std::bitset<SWITCH_NUM>(index);
 	auto& sys = mSwitchedMatrices[bit][0];
+	reserveSystemMatrix(sys);
 	for (auto comp : comp) {
 		comp->mnaApplySystemMatrixStamp(sys);
 	}
 	for (UInt i = 0; i < mSwitches.size(); ++i)
 		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+	sys.makeCompressed();
 	// Compute LU-factorization for system matrix
 	mLuFactorizations[bit][0]->analyzePattern(sys);
 	mLuFactorizations[bit][0]->factorize(sys);
 }
 
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::reserveSystemMatrix(SparseMatrix& systemMatrix) {
+	systemMatrix.reserve(Eigen::VectorXi::Constant(systemMatrix.outerSize(), mNumReservedRowEntries));
+}
+
+template <>
+void MnaSolverEigenSparse<Real>::switchedMatrixCreate(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	mSwitchedMatrices[bit].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
+	mLuFactorizations[bit].push_back(std::make_shared<LUFactorizedSparse>());
+}
+
+template <>
+void MnaSolverEigenSparse<Complex>::switchedMatrixCreate(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	if (mFrequencyParallel) {
+		for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
+			mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices)));
+			mLuFactorizations[bit].push_back(std::make_shared<LUFactorizedSparse>());
+		}
+	}
+	else {
+		mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
+		mLuFactorizations[bit].push_back(std::make_shared<LUFactorizedSparse>());
+	}
+}
+
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::switchedMatrixErase(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	mSwitchedMatrices.erase(bit);
+	mLuFactorizations.erase(bit);
+}
+
+template <typename VarType>
+std::size_t MnaSolverEigenSparse<VarType>::switchedMatrixMemory(std::size_t index) {
+	auto bit = std::bitset<SWITCH_NUM>(index);
+	std::size_t bytes = 0;
+	std::size_t entryBytes = sizeof(Real) + sizeof(SparseMatrix::StorageIndex);
+	for (std::size_t freq = 0; freq < mSwitchedMatrices[bit].size(); ++freq) {
+		auto& sys = mSwitchedMatrices[bit][freq];
+		auto& lu = mLuFactorizations[bit][freq];
+		bytes += sys.nonZeros() * entryBytes + sys.outerSize() * sizeof(SparseMatrix::StorageIndex);
+		bytes += (lu->nnzL() + lu->nnzU()) * entryBytes;
+	}
+	return bytes;
+}
+
 template <>
 void MnaSolverEigenSparse<Real>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
-		mSwitchedMatrices[std::bitset<SWITCH_NUM>(i)].push_back(SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
-
+	if (precomputesSwitchedMatrices()) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			switchedMatrixCreate(i);
+	}
 	mBaseSystemMatrix.resize(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
 }
 
@@ -62,23 +113,12 @@ void MnaSolverEigenSparse<Complex>::createEmptySystemMatrix() {
 	if (mSwitches.size() > SWITCH_NUM)
 		throw SystemError("Too many Switches.");
 
-	if (mFrequencyParallel) {
-		for (UInt i = 0; i < std::pow(2,mSwitches.size()); ++i) {
-			for(Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
-				auto bit = std::bitset<SWITCH_NUM>(i);
-				mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumMatrixNodeIndices), 2*(mNumMatrixNodeIndices)));
-				mLuFactorizations[bit].push_back(std::make_shared<LUFactorizedSparse>());
-			}
-		}
+	if (precomputesSwitchedMatrices()) {
+		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++)
+			switchedMatrixCreate(i);
 	}
-	else {
-		for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
-			auto bit = std::bitset<SWITCH_NUM>(i);
-			mSwitchedMatrices[bit].push_back(SparseMatrix(2*(mNumTotalMatrixNodeIndices), 2*(mNumTotalMatrixNodeIndices)));
-			mLuFactorizations[bit].push_back(std::make_shared<LUFactorizedSparse>());
-		}
+	if (!mFrequencyParallel)
 		mBaseSystemMatrix.resize(2 * (mNumTotalMatrixNodeIndices), 2 * (mNumTotalMatrixNodeIndices));
-	}
 }
 
 template <typename VarType>
@@ -101,19 +141,19 @@ std::shared_ptr<CPS::Task> MnaSolverEigenSparse<VarType>::createLogTask()
 
 template <typename VarType>
 void MnaSolverEigenSparse<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	mRightSideVector.setZero();
-
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : mRightVectorStamps)
-		mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!mIsInInitialization)
 		MnaSolver<VarType>::updateSwitchStatus();
 
-	if (mSwitchedMatrices.size() > 0)
-		mLeftSideVector = mLuFactorizations[mCurrentSwitchStatus][0]->solve(mRightSideVector);
+	if (mSwitchedMatrices.size() > 0) {
+		auto lu = mLuFactorizations.find(mCurrentSwitchStatus);
+		if (lu == mLuFactorizations.end() || lu->second.size() == 0)
+			throw SolverException();
+		solveInPlace(*lu->second[0]);
+	}
 
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
@@ -123,13 +163,59 @@ void MnaSolverEigenSparse<VarType>::solve(Real time, Int timeStepCount) {
 	// Components' states will be updated by the post-step tasks
 }
 
+template <typename VarType>
+void MnaSolverEigenSparse<VarType>::solveInPlace(const CPS::LUFactorizedSparse& lu) {
+	// Same steps as SparseLU::solve, which allocates the workspace of the forward
+	// substitution and the masks of in-place permutations in every call
+	if (mPermutedRightSideVector.rows() != mRightSideVector.rows()) {
+		mPermutedRightSideVector = CPS::Vector::Zero(mRightSideVector.rows());
+		mForwardSubstitutionWorkspace = CPS::Vector::Zero(mRightSideVector.rows());
+	}
+	CPS::Vector& x = mPermutedRightSideVector;
+	x = lu.rowsPermutation() * mRightSideVector;
+
+	// Forward substitution with the supernodes of L
+	const auto& L = lu.matrixL().m_mapL;
+	typedef typename std::decay<decltype(L)>::type SupernodalMatrix;
+	typedef Eigen::Map<const Matrix, 0, Eigen::OuterStride<>> SupernodeBlock;
+	for (Eigen::Index k = 0; k <= L.nsuper(); ++k) {
+		Eigen::Index firstCol = L.supToCol()[k];
+		Eigen::Index firstRow = L.rowIndexPtr()[firstCol];
+		Eigen::Index numCols = L.supToCol()[k + 1] - firstCol;
+		Eigen::Index numRows = L.rowIndexPtr()[firstCol + 1] - firstRow - numCols;
+
+		if (numCols == 1) {
+			typename SupernodalMatrix::InnerIterator it(L, firstCol);
+			// Skip the diagonal element
+			for (++it; it; ++it)
+				x(it.row()) -= x(firstCol) * it.value();
+			continue;
+		}
+
+		Eigen::Index offset = L.colIndexPtr()[firstCol];
+		Eigen::Index stride = L.colIndexPtr()[firstCol + 1] - offset;
+		auto xSupernode = x.segment(firstCol, numCols);
+		SupernodeBlock diagonal(L.valuePtr() + offset, numCols, numCols, Eigen::OuterStride<>(stride));
+		diagonal.template triangularView<Eigen::UnitLower>().solveInPlace(xSupernode);
+
+		SupernodeBlock below(L.valuePtr() + offset + numCols, numRows, numCols, Eigen::OuterStride<>(stride));
+		auto update = mForwardSubstitutionWorkspace.head(numRows);
+		update.noalias() = below * xSupernode;
+		for (Eigen::Index i = 0; i < numRows; ++i)
+			x(L.rowIndex()[firstRow + numCols + i]) -= update(i);
+	}
+
+	lu.matrixU().solveInPlace(x);
+	mLeftSideVector = lu.colsPermutation().inverse() * x;
+}
+
 template <typename VarType>
 void MnaSolverEigenSparse<VarType>::solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) {
 	mRightSideVectorHarm[freqIdx].setZero();
 
 	// Sum of right side vectors (computed by the components' pre-step tasks)
 	for (auto stamp : mRightVectorStamps)
-		mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+		mRightSideVectorHarm[freqIdx] += stamp->mnaRightVector().col(freqIdx);
 
 	mLeftSideVectorHarm[freqIdx] = mLuFactorizations[mCurrentSwitchStatus][freqIdx]->solve(mRightSideVectorHarm[freqIdx]);
 }
@@ -44,6 +44,8 @@ MnaSolverGpuDense<VarType>::~MnaSolverGpuDense() {
 
 template <typename VarType>
 void MnaSolverGpuDense<VarType>::initialize() {
+    // The device copy is taken from the precomputed system matrices
+    this->mLazySwitchedMatrices = false;
     MnaSolver<VarType>::initialize();
 
     mDeviceCopy.size = this->mRightSideVector.rows();
@@ -154,13 +156,9 @@ Task::List MnaSolverGpuDense<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolverGpuDense<VarType>::solve(Real time, Int timeStepCount) {
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
     if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
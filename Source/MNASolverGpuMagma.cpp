@@ -37,6 +37,8 @@ MnaSolverGpuMagma<VarType>::~MnaSolverGpuMagma() {
 
 template <typename VarType>
 void MnaSolverGpuMagma<VarType>::initialize() {
+    // The device copy is taken from the precomputed system matrices
+    this->mLazySwitchedMatrices = false;
     MnaSolver<VarType>::initialize();
 
     int size = this->mRightSideVector.rows();
@@ -143,13 +145,9 @@ template <typename VarType>
 void MnaSolverGpuMagma<VarType>::solve(Real time, Int timeStepCount) {
 	int size = this->mRightSideVector.rows();
 	int one = 0;
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
@@ -45,6 +45,8 @@ inline void MnaSolverGpuSparse<VarType>::checkCusparseStatus(cusparseStatus_t st
 
 template <typename VarType>
 void MnaSolverGpuSparse<VarType>::initialize() {
+    // The device copy is taken from the precomputed system matrices
+    this->mLazySwitchedMatrices = false;
     MnaSolver<VarType>::initialize();
 
 	cusparseStatus_t csp_status;
@@ -234,13 +236,9 @@ void MnaSolverGpuSparse<VarType>::solve(Real time, Int timeStepCount) {
 	cudaError_t status;
 	cusparseStatus_t csp_status;
 	int size = this->mRightSideVector.rows();
-    // Reset source vector
-	this->mRightSideVector.setZero();
-
     // Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (const auto &stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (!this->mIsInInitialization)
 		this->updateSwitchStatus();
@@ -7,7 +7,10 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <chrono>
+
 #include <dpsim/MNASolverSysRecomp.h>
+#include <dpsim/Trace.h>
 
 using namespace DPsim;
 using namespace CPS;
@@ -17,7 +20,18 @@ namespace DPsim {
 template <typename VarType>
 MnaSolverSysRecomp<VarType>::MnaSolverSysRecomp(String name,
 	CPS::Domain domain, CPS::Logger::Level logLevel) :
-    MnaSolverEigenSparse<VarType>(name, domain, logLevel) { }
+    MnaSolverEigenSparse<VarType>(name, domain, logLevel) {
+
+	this->template addAttribute<Int>("refactorizations", &mNumRefactorizations, Flags::read);
+	this->template addAttribute<Int>("pattern_analyses", &mNumPatternAnalyses, Flags::read);
+	this->template addAttribute<Int>("low_rank_updates", &mNumLowRankUpdates, Flags::read);
+	this->template addAttribute<Real>("refactorization_time", &mRefactorizationTime, Flags::read);
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::createEmptySystemMatrix() {
+	this->switchedMatrixCreate(0);
+}
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::initializeSystem() {
@@ -30,25 +44,34 @@ void MnaSolverSysRecomp<VarType>::initializeSystem() {
 		this->mMNAComponents.size());
 
 	this->mSLog->info("Stamping MNA fixed components");
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	sys.setZero();
+	this->reserveSystemMatrix(sys);
 	for (auto comp : this->mMNAComponents) {
 		// Do not stamp variable elements yet
 		auto varcomp = std::dynamic_pointer_cast<MNAVariableCompInterface>(comp);
 		if (varcomp) continue;
- 		comp->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
-		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+		comp->mnaApplySystemMatrixStamp(sys);
 	}
 
 	// Save base matrix with only static elements
 	this->mSLog->info("Save base matrix");
-	this->mBaseSystemMatrix = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	sys.makeCompressed();
+	this->mBaseSystemMatrix = sys;
 
 	// Now stamp variable elements
 	this->mSLog->info("Stamping variable elements");
 	for (auto varElem : this->mMNAIntfVariableComps) {
-		varElem->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+		varElem->mnaApplySystemMatrixStamp(sys);
 	}
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+	sys.makeCompressed();
+
+	// The base matrix shares the sparsity pattern of the full system matrix
+	// so that updates only need to copy values and refactorize numerically
+	extendBasePattern(sys);
+	analyzeSystemMatrixPattern();
+	collectPortIndices();
+	factorizeSystemMatrix();
 	// Initialize source vector for debugging
 	for (auto comp : this->mMNAComponents) {
 		comp->mnaApplyRightSideVectorStamp(this->mRightSideVector);
@@ -68,37 +91,166 @@ void MnaSolverSysRecomp<VarType>::updateVariableCompStatus() {
 	}
 }
 
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::extendBasePattern(const SparseMatrix& systemMatrix) {
+	SparseMatrix pattern = systemMatrix;
+	pattern.coeffs().setZero();
+	this->mBaseSystemMatrix = this->mBaseSystemMatrix + pattern;
+	this->mBaseSystemMatrix.makeCompressed();
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::analyzeSystemMatrixPattern() {
+	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+	mNumPatternAnalyses++;
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::collectPortIndices() {
+	mPortIndices.clear();
+	if (mMaxUpdateRank == 0)
+		return;
+
+	auto size = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0].rows();
+	SparseMatrix stamps(size, size);
+	for (auto comp : this->mMNAIntfVariableComps)
+		comp->mnaApplySystemMatrixStamp(stamps);
+
+	std::vector<Bool> isPort(size, false);
+	for (Int col = 0; col < stamps.outerSize(); ++col) {
+		for (SparseMatrix::InnerIterator it(stamps, col); it; ++it) {
+			isPort[it.row()] = true;
+			isPort[it.col()] = true;
+		}
+	}
+	for (Int idx = 0; idx < size; ++idx) {
+		if (isPort[idx])
+			mPortIndices.push_back(static_cast<UInt>(idx));
+	}
+
+	if (mPortIndices.size() > mMaxUpdateRank) {
+		this->mSLog->info("Variable components touch {:d} rows, which exceeds the maximum update rank {:d}"
+			" -> Refactorize on changes", mPortIndices.size(), mMaxUpdateRank);
+		mPortIndices.clear();
+	} else {
+		this->mSLog->info("Applying changes of variable components as updates of rank {:d}", mPortIndices.size());
+	}
+}
+
+template <typename VarType>
+void MnaSolverSysRecomp<VarType>::factorizeSystemMatrix() {
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	auto& lu = this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0];
+	lu->factorize(sys);
+	mPortUpdateActive = false;
+	if (mPortIndices.empty())
+		return;
+
+	// Solve the factorized system once for every port index
+	auto rank = mPortIndices.size();
+	Matrix unitVectors = Matrix::Zero(sys.rows(), rank);
+	for (UInt j = 0; j < rank; ++j)
+		unitVectors(mPortIndices[j], j) = 1;
+	mPortSolutions = lu->solve(unitVectors);
+	mPortSolutionRows = Matrix(rank, rank);
+	for (UInt j = 0; j < rank; ++j)
+		mPortSolutionRows.row(j) = mPortSolutions.row(mPortIndices[j]);
+	mPortReduced = Matrix::Zero(rank, 1);
+	mPortWeights = Matrix::Zero(rank, 1);
+
+	mFactorizedPortBlock = Matrix::Zero(rank, rank);
+	for (UInt i = 0; i < rank; ++i) {
+		for (UInt j = 0; j < rank; ++j)
+			mFactorizedPortBlock(i, j) = sys.coeff(mPortIndices[i], mPortIndices[j]);
+	}
+}
+
+template <typename VarType>
+Bool MnaSolverSysRecomp<VarType>::updatePortCorrection() {
+	if (mPortIndices.empty())
+		return false;
+
+	// The variable components only stamp entries between the port indices,
+	// so the change of the system matrix is confined to the port block
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	auto rank = mPortIndices.size();
+	mPortDelta = -mFactorizedPortBlock;
+	for (UInt i = 0; i < rank; ++i) {
+		for (UInt j = 0; j < rank; ++j)
+			mPortDelta(i, j) += sys.coeff(mPortIndices[i], mPortIndices[j]);
+	}
+
+	mPortUpdateActive = !mPortDelta.isZero(0);
+	if (mPortUpdateActive) {
+		Matrix capacitance = Matrix::Identity(rank, rank)
+			+ mPortDelta * mPortSolutionRows;
+		mPortCapacitance.compute(capacitance);
+	}
+	return true;
+}
+
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::updateSystemMatrix(Real time) {
 	this->mSLog->info("Updating System Matrix at {}\n", time);
-	// Start from base matrix
-	this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0] = this->mBaseSystemMatrix;
+	auto start = std::chrono::steady_clock::now();
+	Trace::Scope scope(Trace::Category::Solver, "System matrix update");
+
+	// Start from base matrix values, the sparsity pattern is kept
+	auto& sys = this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	std::copy(this->mBaseSystemMatrix.valuePtr(),
+		this->mBaseSystemMatrix.valuePtr() + this->mBaseSystemMatrix.nonZeros(),
+		sys.valuePtr());
 
 	// Create system matrix with changed variable elements
 	for (auto comp : this->mMNAIntfVariableComps) {
-		comp->mnaApplySystemMatrixStamp(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+		comp->mnaApplySystemMatrixStamp(sys);
 		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
 		this->mSLog->debug("Updating {:s} {:s} in system matrix (variabel component)",
 			idObj->type(), idObj->name());
 	}
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->analyzePattern(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
-	this->mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->factorize(this->mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+
+	// Stamps that introduced new entries require a new symbolic analysis
+	if (!sys.isCompressed() || sys.nonZeros() != this->mBaseSystemMatrix.nonZeros()) {
+		this->mSLog->info("Sparsity pattern of system matrix changed -> Analyze pattern");
+		sys.makeCompressed();
+		extendBasePattern(sys);
+		analyzeSystemMatrixPattern();
+		collectPortIndices();
+		factorizeSystemMatrix();
+		mNumRefactorizations++;
+	} else if (updatePortCorrection()) {
+		mNumLowRankUpdates++;
+	} else {
+		factorizeSystemMatrix();
+		mNumRefactorizations++;
+	}
 	mUpdateSysMatrix = false;
+
+	std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+	mRefactorizationTime += diff.count();
+	this->mSLog->debug("System matrix update took {:f} s (total {:f} s)",
+		diff.count(), mRefactorizationTime);
 }
 
 template <typename VarType>
 void MnaSolverSysRecomp<VarType>::solve(Real time, Int timeStepCount) {
-	// Reset source vector
-	this->mRightSideVector.setZero();
 	mUpdateSysMatrix = false;
 
 	// Add together the right side vector (computed by the components'
 	// pre-step tasks)
-	for (auto stamp : this->mRightVectorStamps)
-		this->mRightSideVector += *stamp;
+	this->sumRightVectorStamps();
 
 	if (this->mSwitchedMatrices.size() > 0)
-		this->mLeftSideVector = this->mLuFactorizations[this->mCurrentSwitchStatus][0]->solve(this->mRightSideVector);
+		this->solveInPlace(*this->mLuFactorizations[this->mCurrentSwitchStatus][0]);
+
+	// Woodbury identity: x = x0 - Z * (I + D * Z_P)^-1 * D * x0_P
+	if (mPortUpdateActive) {
+		for (UInt j = 0; j < mPortIndices.size(); ++j)
+			mPortReduced(j, 0) = this->mLeftSideVector(mPortIndices[j], 0);
+		mPortWeights.noalias() = mPortDelta * mPortReduced;
+		mPortReduced = mPortCapacitance.solve(mPortWeights);
+		this->mLeftSideVector.noalias() -= mPortSolutions * mPortReduced;
+	}
 
 	// TODO split into separate task? (dependent on x, updating all v attributes)
 	for (UInt nodeIdx = 0; nodeIdx < this->mNumNetNodes; ++nodeIdx)
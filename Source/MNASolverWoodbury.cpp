@@ -0,0 +1,230 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MNASolverWoodbury.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+namespace DPsim {
+
+template <typename VarType>
+MnaSolverWoodbury<VarType>::MnaSolverWoodbury(String name,
+	CPS::Domain domain, CPS::Logger::Level logLevel) :
+	MnaSolverEigenSparse<VarType>(name, domain, logLevel) {
+
+	this->template addAttribute<Int>("switch_cache_hits", &mSwitchCacheHits, Flags::read);
+	this->template addAttribute<Int>("switch_cache_misses", &mSwitchCacheMisses, Flags::read);
+}
+
+template <typename VarType>
+void MnaSolverWoodbury<VarType>::createEmptySystemMatrix() {
+	if (mFrequencyParallel)
+		throw SystemError("Woodbury solver does not support frequency parallelization.");
+
+	this->switchedMatrixCreate(0);
+}
+
+template <typename VarType>
+void MnaSolverWoodbury<VarType>::initializeSystem() {
+	mSLog->info("-- Initialize MNA system matrices and source vector");
+	mRightSideVector.setZero();
+
+	// Only switch changes are applied as corrections, other changes of the system matrix would be lost
+	for (auto varComp : this->mMNAIntfVariableComps) {
+		auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(varComp);
+		if (!std::dynamic_pointer_cast<MNASwitchInterface>(varComp))
+			throw SystemError("Woodbury solver does not support variable component " + idObj->name() + ".");
+		mSLog->warn("Variable switch {:s} is applied with its open and closed resistance only", idObj->name());
+	}
+
+	mBaseSwitchStatus.resize(mSwitches.size());
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		mBaseSwitchStatus[i] = mSwitches[i]->mnaIsClosed();
+	mSwitchStatus = mBaseSwitchStatus;
+
+	// Only the system matrix of the current switch configuration is factorized
+	auto& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	sys.setZero();
+	this->reserveSystemMatrix(sys);
+	for (auto comp : mMNAComponents)
+		comp->mnaApplySystemMatrixStamp(sys);
+	for (UInt i = 0; i < mSwitches.size(); ++i)
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(mBaseSwitchStatus[i], sys, 0);
+	sys.makeCompressed();
+	this->mBaseSystemMatrix = sys;
+
+	auto lu = mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0];
+	lu->analyzePattern(sys);
+	lu->factorize(sys);
+	if (lu->info() != Eigen::Success)
+		throw SystemError("Factorization of base system matrix failed.");
+
+	// Changes of the system matrix if a single switch toggles
+	mSwitchDeltas.clear();
+	for (UInt i = 0; i < mSwitches.size(); ++i) {
+		SparseMatrix toggled(sys.rows(), sys.cols());
+		SparseMatrix base(sys.rows(), sys.cols());
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(!mBaseSwitchStatus[i], toggled, 0);
+		mSwitches[i]->mnaApplySwitchSystemMatrixStamp(mBaseSwitchStatus[i], base, 0);
+		SparseMatrix delta = toggled - base;
+		delta.prune(0.0);
+		mSwitchDeltas.push_back(delta);
+	}
+
+	mCorrectionCache.clear();
+	mCorrectionCacheIndex.clear();
+	mActiveCorrection = nullptr;
+
+	// Initialize source vector for debugging
+	for (auto comp : mMNAComponents)
+		comp->mnaApplyRightSideVectorStamp(mRightSideVector);
+}
+
+template <typename VarType>
+void MnaSolverWoodbury<VarType>::updateSwitchCorrection() {
+	Bool changed = false;
+	for (UInt i = 0; i < mSwitches.size(); ++i) {
+		Bool closed = mSwitches[i]->mnaIsClosed();
+		if (mSwitchStatus[i] != closed) {
+			mSwitchStatus[i] = closed;
+			changed = true;
+		}
+	}
+	if (!changed)
+		return;
+
+	if (mSwitchStatus == mBaseSwitchStatus)
+		mActiveCorrection = nullptr;
+	else
+		mActiveCorrection = switchCorrection(mSwitchStatus);
+}
+
+template <typename VarType>
+std::shared_ptr<typename MnaSolverWoodbury<VarType>::SwitchCorrection>
+MnaSolverWoodbury<VarType>::switchCorrection(const SwitchStatus& status) {
+	auto it = mCorrectionCacheIndex.find(status);
+	if (it != mCorrectionCacheIndex.end()) {
+		// Move entry to the front of the LRU list
+		mCorrectionCache.splice(mCorrectionCache.begin(), mCorrectionCache, it->second);
+		++mSwitchCacheHits;
+		return it->second->second;
+	}
+
+	++mSwitchCacheMisses;
+	auto correction = computeSwitchCorrection(status);
+	if (mSwitchCacheSize == 0)
+		return correction;
+
+	mCorrectionCache.emplace_front(status, correction);
+	mCorrectionCacheIndex[status] = mCorrectionCache.begin();
+	if (mCorrectionCache.size() > mSwitchCacheSize) {
+		mCorrectionCacheIndex.erase(mCorrectionCache.back().first);
+		mCorrectionCache.pop_back();
+	}
+	return correction;
+}
+
+template <typename VarType>
+std::shared_ptr<typename MnaSolverWoodbury<VarType>::SwitchCorrection>
+MnaSolverWoodbury<VarType>::computeSwitchCorrection(const SwitchStatus& status) {
+	auto& sys = mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0];
+	auto size = sys.rows();
+
+	SparseMatrix delta(size, size);
+	for (UInt i = 0; i < mSwitches.size(); ++i) {
+		if (status[i] != mBaseSwitchStatus[i])
+			delta += mSwitchDeltas[i];
+	}
+	delta.prune(0.0);
+
+	// Collect the indices affected by the switch changes
+	std::vector<Int> localIndex(size, -1);
+	auto correction = std::make_shared<SwitchCorrection>();
+	for (Int row = 0; row < delta.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(delta, row); it; ++it) {
+			for (auto idx : { it.row(), it.col() }) {
+				if (localIndex[idx] < 0) {
+					localIndex[idx] = static_cast<Int>(correction->indices.size());
+					correction->indices.push_back(static_cast<UInt>(idx));
+				}
+			}
+		}
+	}
+	auto rank = correction->indices.size();
+
+	correction->delta = Matrix::Zero(rank, rank);
+	for (Int row = 0; row < delta.outerSize(); ++row) {
+		for (SparseMatrix::InnerIterator it(delta, row); it; ++it)
+			correction->delta(localIndex[it.row()], localIndex[it.col()]) = it.value();
+	}
+
+	// Solve the base system once for every affected index
+	Matrix unitVectors = Matrix::Zero(size, rank);
+	for (UInt j = 0; j < rank; ++j)
+		unitVectors(correction->indices[j], j) = 1;
+	correction->baseSolutions = mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]->solve(unitVectors);
+
+	// Rows of the base solutions at the affected indices
+	Matrix indexedSolutions(rank, rank);
+	for (UInt j = 0; j < rank; ++j)
+		indexedSolutions.row(j) = correction->baseSolutions.row(correction->indices[j]);
+	Matrix capacitance = Matrix::Identity(rank, rank)
+		+ correction->delta * indexedSolutions;
+	correction->capacitance = capacitance.partialPivLu();
+	correction->reduced = Matrix::Zero(rank, 1);
+	correction->weights = Matrix::Zero(rank, 1);
+
+	mSLog->info("Computed switch correction of rank {:d}", rank);
+	return correction;
+}
+
+template <typename VarType>
+void MnaSolverWoodbury<VarType>::solve(Real time, Int timeStepCount) {
+	// Add together the right side vector (computed by the components'
+	// pre-step tasks)
+	this->sumRightVectorStamps();
+
+	if (!mIsInInitialization)
+		updateSwitchCorrection();
+
+	this->solveInPlace(*mLuFactorizations[std::bitset<SWITCH_NUM>(0)][0]);
+
+	// Woodbury identity: x = x0 - Z * (I + D * Z_J)^-1 * D * x0_J
+	if (mActiveCorrection) {
+		// All intermediate results are stored in the preallocated workspace of the correction
+		auto& corr = *mActiveCorrection;
+		for (UInt j = 0; j < corr.indices.size(); ++j)
+			corr.reduced(j, 0) = mLeftSideVector(corr.indices[j], 0);
+		corr.weights.noalias() = corr.delta * corr.reduced;
+		// The capacitance matrix is solved in place with its LU factors P^-1 * L * U
+		auto& permutation = corr.capacitance.permutationP().indices();
+		for (UInt j = 0; j < corr.indices.size(); ++j)
+			corr.reduced(permutation(j), 0) = corr.weights(j, 0);
+		corr.capacitance.matrixLU().template triangularView<Eigen::UnitLower>().solveInPlace(corr.reduced);
+		corr.capacitance.matrixLU().template triangularView<Eigen::Upper>().solveInPlace(corr.reduced);
+		mLeftSideVector.noalias() -= corr.baseSolutions * corr.reduced;
+	}
+
+	for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
+		mNodes[nodeIdx]->mnaUpdateVoltage(mLeftSideVector);
+
+	// Components' states will be updated by the post-step tasks
+}
+
+template <typename VarType>
+void MnaSolverWoodbury<VarType>::logSystemMatrices() {
+	mSLog->info("Number of switches: {:d}", mSwitches.size());
+	mSLog->info("Base system matrix: \n{}", mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+	mSLog->info("Right side vector: \n{}", mRightSideVector);
+}
+
+}
+
+template class DPsim::MnaSolverWoodbury<Real>;
+template class DPsim::MnaSolverWoodbury<Complex>;
@@ -0,0 +1,227 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/Config.h>
+#include <dpsim/ODEAggregatedSolver.h>
+
+using namespace DPsim;
+
+ODEAggregatedSolver::ODEAggregatedSolver(String name, const std::vector<CPS::ODEInterface::Ptr> &comps,
+	bool implicit_integration, Real timestep) :
+	Solver(name, CPS::Logger::Level::info),
+	mComponents(comps),
+	mImplicitIntegration(implicit_integration),
+	mTimestep(timestep) {
+	for (auto comp : mComponents) {
+		mPreStates.push_back(comp->attribute<Matrix>("ode_pre_state"));
+		mPostStates.push_back(comp->attribute<Matrix>("ode_post_state"));
+		Int dim = mPreStates.back()->get().rows();
+		mOffsets.push_back(mProbDim);
+		mProbDim += dim;
+		mMaxDim = std::max(mMaxDim, dim);
+		mNonZeros += dim * dim;
+	}
+	mOffsets.push_back(mProbDim);
+	initialize();
+}
+
+void ODEAggregatedSolver::initialize() {
+	mStates = N_VNew_Serial(mProbDim);
+	if (check_flag((void *)mStates, "N_VNew_Serial", 0)) throw CPS::Exception();
+	loadStates();
+
+	// The integrator memory is only created here and re-initialized in every step
+	mArkode_mem = ARKodeCreate();
+	if (check_flag(mArkode_mem, "ARKodeCreate", 0)) throw CPS::Exception();
+
+	mFlag = ARKodeSetUserData(mArkode_mem, this);
+	if (check_flag(&mFlag, "ARKodeSetUserData", 1)) throw CPS::Exception();
+
+	if (mImplicitIntegration) {
+		mFlag = ARKodeInit(mArkode_mem, NULL, &ODEAggregatedSolver::StateSpaceWrapper, 0, mStates);
+		if (check_flag(&mFlag, "ARKodeInit", 1)) throw CPS::Exception();
+
+#ifdef WITH_SUNDIALS_KLU
+		// The block diagonal Jacobian is stored in compressed columns
+		A = SUNSparseMatrix(mProbDim, mProbDim, mNonZeros, CSC_MAT);
+		if (check_flag((void *)A, "SUNSparseMatrix", 0)) throw CPS::Exception();
+
+		LS = SUNKLU(mStates, A);
+		if (check_flag((void *)LS, "SUNKLU", 0)) throw CPS::Exception();
+#else
+		// The block diagonal Jacobian fits into a band of the size of the largest block
+		sunindextype bandwidth = mMaxDim - 1;
+		sunindextype storageUpper = std::min<sunindextype>(mProbDim - 1, 2 * bandwidth);
+		A = SUNBandMatrix(mProbDim, bandwidth, bandwidth, storageUpper);
+		if (check_flag((void *)A, "SUNBandMatrix", 0)) throw CPS::Exception();
+
+		LS = SUNBandLinearSolver(mStates, A);
+		if (check_flag((void *)LS, "SUNBandLinearSolver", 0)) throw CPS::Exception();
+
+		mBlockJacobian = Matrix::Zero(mMaxDim * mMaxDim, 1);
+#endif
+
+		mFlag = ARKDlsSetLinearSolver(mArkode_mem, LS, A);
+		if (check_flag(&mFlag, "ARKDlsSetLinearSolver", 1)) throw CPS::Exception();
+
+		mFlag = ARKDlsSetJacFn(mArkode_mem, &ODEAggregatedSolver::JacobianWrapper);
+		if (check_flag(&mFlag, "ARKDlsSetJacFn", 1)) throw CPS::Exception();
+	}
+	else {
+		mFlag = ARKodeInit(mArkode_mem, &ODEAggregatedSolver::StateSpaceWrapper, NULL, 0, mStates);
+		if (check_flag(&mFlag, "ARKodeInit", 1)) throw CPS::Exception();
+	}
+
+	mFlag = ARKodeSStolerances(mArkode_mem, reltol, abstol);
+	if (check_flag(&mFlag, "ARKodeSStolerances", 1)) throw CPS::Exception();
+
+	mSLog->info("Aggregated {} ODE components with {} states", mComponents.size(), mProbDim);
+}
+
+void ODEAggregatedSolver::loadStates() {
+	realtype* states = NV_DATA_S(mStates);
+	for (UInt i = 0; i < mComponents.size(); i++) {
+		const Matrix& pre = mPreStates[i]->get();
+		std::copy(pre.data(), pre.data() + pre.rows(), states + mOffsets[i]);
+	}
+}
+
+int ODEAggregatedSolver::StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot, void *user_data) {
+	ODEAggregatedSolver *self = reinterpret_cast<ODEAggregatedSolver *>(user_data);
+	return self->StateSpace(t, y, ydot);
+}
+
+int ODEAggregatedSolver::StateSpace(realtype t, N_Vector y, N_Vector ydot) {
+	const realtype* states = NV_DATA_S(y);
+	realtype* derivatives = NV_DATA_S(ydot);
+	Int numComps = static_cast<Int>(mComponents.size());
+
+	// The components are independent, so their right-hand sides can be evaluated in parallel
+#ifdef WITH_OPENMP
+	#pragma omp parallel for schedule(static) num_threads(mNumThreads) if(mNumThreads > 1)
+#endif
+	for (Int i = 0; i < numComps; i++)
+		mComponents[i]->odeStateSpace(t, states + mOffsets[i], derivatives + mOffsets[i]);
+	return 0;
+}
+
+int ODEAggregatedSolver::JacobianWrapper(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_data,
+               N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+	ODEAggregatedSolver *self = reinterpret_cast<ODEAggregatedSolver *>(user_data);
+	return self->Jacobian(t, y, fy, J, tmp1, tmp2, tmp3);
+}
+
+int ODEAggregatedSolver::Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+               N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+#ifdef WITH_SUNDIALS_KLU
+	sunindextype* colPtrs = SM_INDEXPTRS_S(J);
+	sunindextype* rowIndices = SM_INDEXVALS_S(J);
+	realtype* data = SM_DATA_S(J);
+	sunindextype entry = 0;
+	for (UInt i = 0; i < mComponents.size(); i++) {
+		Int offset = mOffsets[i];
+		Int dim = mOffsets[i+1] - offset;
+
+		// The dense column-major block of each component is also its compressed
+		// column storage, so the component fills the matrix data directly
+		realtype* block = data + entry;
+		std::fill(block, block + dim * dim, 0.);
+		mComponents[i]->odeJacobian(t, NV_DATA_S(y) + offset, NV_DATA_S(fy) + offset,
+			block, NV_DATA_S(tmp1) + offset, NV_DATA_S(tmp2) + offset,
+			NV_DATA_S(tmp3) + offset);
+		for (Int col = 0; col < dim; col++) {
+			colPtrs[offset + col] = entry;
+			for (Int row = 0; row < dim; row++)
+				rowIndices[entry++] = offset + row;
+		}
+	}
+	colPtrs[mProbDim] = entry;
+#else
+	SUNMatZero(J);
+	for (UInt i = 0; i < mComponents.size(); i++) {
+		Int offset = mOffsets[i];
+		Int dim = mOffsets[i+1] - offset;
+
+		// Each component fills its own dense column-major block
+		mBlockJacobian.setZero();
+		mComponents[i]->odeJacobian(t, NV_DATA_S(y) + offset, NV_DATA_S(fy) + offset,
+			mBlockJacobian.data(), NV_DATA_S(tmp1) + offset, NV_DATA_S(tmp2) + offset,
+			NV_DATA_S(tmp3) + offset);
+		for (Int col = 0; col < dim; col++) {
+			for (Int row = 0; row < dim; row++)
+				SM_ELEMENT_B(J, offset + row, offset + col) = mBlockJacobian(col * dim + row, 0);
+		}
+	}
+#endif
+	return 0;
+}
+
+Real ODEAggregatedSolver::step(Real initial_time) {
+	realtype T0 = (realtype) initial_time;
+	realtype Tf = (realtype) initial_time+mTimestep;
+
+	// The components may have changed their states since the last step, so the
+	// integrator restarts from them like a newly created one. The linear solver
+	// and the tolerances are kept.
+	loadStates();
+	if (mImplicitIntegration)
+		mFlag = ARKodeReInit(mArkode_mem, NULL, &ODEAggregatedSolver::StateSpaceWrapper, T0, mStates);
+	else
+		mFlag = ARKodeReInit(mArkode_mem, &ODEAggregatedSolver::StateSpaceWrapper, NULL, T0, mStates);
+	if (check_flag(&mFlag, "ARKodeReInit", 1)) throw CPS::Exception();
+
+	// Main integrator loop
+	realtype t = T0;
+	while (Tf-t > 1.0e-15) {
+		mFlag = ARKode(mArkode_mem, Tf, mStates, &t, ARK_NORMAL);
+		if (check_flag(&mFlag, "ARKode", 1))	break;
+	}
+
+	realtype* states = NV_DATA_S(mStates);
+	for (UInt i = 0; i < mComponents.size(); i++) {
+		Matrix& post = mPostStates[i]->operator Matrix&();
+		Int dim = mOffsets[i+1] - mOffsets[i];
+		std::copy(states + mOffsets[i], states + mOffsets[i] + dim, post.data());
+	}
+	return Tf;
+}
+
+void ODEAggregatedSolver::SolveTask::execute(Real time, Int timeStepCount) {
+	mSolver.step(time);
+}
+
+// ARKode-Error checking functions, see ODESolver::check_flag
+int ODEAggregatedSolver::check_flag(void *flagvalue, const std::string &funcname, int opt) {
+	if (opt == 0 && flagvalue == NULL) {
+		mSLog->error("SUNDIALS_ERROR: {} failed - returned NULL pointer", funcname);
+		return 1;
+	}
+	else if (opt == 1) {
+		int *errflag = (int *) flagvalue;
+		if (*errflag < 0) {
+			mSLog->error("SUNDIALS_ERROR: {} failed with flag = {}", funcname, *errflag);
+			return 1;
+		}
+	}
+	else if (opt == 2 && flagvalue == NULL) {
+		mSLog->error("MEMORY_ERROR: {} failed - returned NULL pointer", funcname);
+		return 1;
+	}
+	return 0;
+}
+
+ODEAggregatedSolver::~ODEAggregatedSolver() {
+	ARKodeFree(&mArkode_mem);
+	if (LS)
+		SUNLinSolFree(LS);
+	if (A)
+		SUNMatDestroy(A);
+	N_VDestroy(mStates);
+}
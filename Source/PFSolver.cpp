@@ -47,7 +47,10 @@ void PFSolver::initialize(){
     determinePFBusType();
     composeAdmittanceMatrix();
 
-	mJ.setZero(mNumUnknowns,mNumUnknowns);
+	if (mSparseJacobian)
+		createSparseJacobian();
+	else
+		mJ.setZero(mNumUnknowns,mNumUnknowns);
 	mX.setZero(mNumUnknowns);
 	mF.setZero(mNumUnknowns);
 }
@@ -214,6 +217,10 @@ void PFSolver::determinePFBusType() {
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPQBusIndices.begin(), mPQBusIndices.end());
     mPQPVBusIndices.insert(mPQPVBusIndices.end(), mPVBusIndices.begin(), mPVBusIndices.end());
 
+	mPQPVBusPositions.assign(mSystem.mNodes.size(), -1);
+	for (UInt a = 0; a < mPQPVBusIndices.size(); ++a)
+		mPQPVBusPositions[mPQPVBusIndices[a]] = a;
+
 	mSLog->info("#### Create index vectors for power flow solver:");
     mSLog->info("PQ Buses: {}", logVector(mPQBusIndices));
     mSLog->info("PV Buses: {}", logVector(mPVBusIndices));
@@ -270,6 +277,44 @@ void PFSolver::composeAdmittanceMatrix() {
 	if(mLines.empty() && mTransformers.empty()) {
 		throw std::invalid_argument("There are no bus");
 	}
+	mY.makeCompressed();
+}
+
+void PFSolver::createSparseJacobian() {
+	UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+	// The Jacobian blocks have nonzeros where the admittance matrix
+	// couples two PQ or PV buses and on their diagonals
+	std::vector<Eigen::Triplet<Real>> entries;
+	for (UInt a = 0; a < npqpv; ++a) {
+		Bool pqRow = a < mNumPQBuses;
+		entries.emplace_back(a, a, 0);
+		if (pqRow) {
+			entries.emplace_back(a, a + npqpv, 0);
+			entries.emplace_back(a + npqpv, a, 0);
+			entries.emplace_back(a + npqpv, a + npqpv, 0);
+		}
+		for (SparseMatrixCompRow::InnerIterator it(mY, mPQPVBusIndices[a]); it; ++it) {
+			Int b = mPQPVBusPositions[it.col()];
+			if (b < 0 || b == (Int) a)
+				continue;
+			Bool pqCol = b < (Int) mNumPQBuses;
+			entries.emplace_back(a, b, 0);
+			if (pqCol)
+				entries.emplace_back(a, b + npqpv, 0);
+			if (pqRow)
+				entries.emplace_back(a + npqpv, b, 0);
+			if (pqRow && pqCol)
+				entries.emplace_back(a + npqpv, b + npqpv, 0);
+		}
+	}
+	mJSparse = CPS::SparseMatrix(mNumUnknowns, mNumUnknowns);
+	mJSparse.setFromTriplets(entries.begin(), entries.end());
+	mJSparse.makeCompressed();
+
+	// The structure does not change between iterations and time steps
+	mJacobianLU.analyzePattern(mJSparse);
+	mSLog->info("Sparse Jacobian with {} nonzeros for {} unknowns", mJSparse.nonZeros(), mNumUnknowns);
 }
 
 CPS::Real PFSolver::G(int i, int j) {
@@ -299,13 +344,18 @@ Bool PFSolver::solvePowerflow() {
     mIterations = 0;
     for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
-        calculateJacobian();
-		auto sparseJ = mJ.sparseView();
-
 		// Solve system mJ*mX = mF
-        Eigen::SparseLU<SparseMatrix>lu(sparseJ);
-
-		mX = lu.solve(mF);	/* code */
+		if (mSparseJacobian) {
+			calculateSparseJacobian();
+			mJacobianLU.factorize(mJSparse);
+			mX = mJacobianLU.solve(mF);
+		}
+		else {
+			calculateJacobian();
+			auto sparseJ = mJ.sparseView();
+			Eigen::SparseLU<SparseMatrix>lu(sparseJ);
+			mX = lu.solve(mF);
+		}
 
 		// Calculate new solution based on mX increments obtained from equation system
 		updateSolution();
@@ -323,11 +373,14 @@ Bool PFSolver::solvePowerflow() {
 	return isConverged;
 }
 
+void PFSolver::solve(Real time, Int timeStepCount) {
+	generateInitialSolution(time, mWarmStart);
+	solvePowerflow();
+	setSolution();
+}
+
 void PFSolver::SolveTask::execute(Real time, Int timeStepCount) {
-	// apply keepLastSolution to save computation time
-    mSolver.generateInitialSolution(time);
-	mSolver.solvePowerflow();
-	mSolver.setSolution();
+	mSolver.solve(time, timeStepCount);
 }
 
 Task::List PFSolver::getTasks() {
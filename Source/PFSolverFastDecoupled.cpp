@@ -0,0 +1,305 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <cmath>
+
+#include <dpsim/PFSolverFastDecoupled.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+PFSolverFastDecoupled::PFSolverFastDecoupled(CPS::String name, const CPS::SystemTopology &system, CPS::Real timeStep, CPS::Logger::Level logLevel)
+    : PFSolverPowerPolar(name, system, timeStep, logLevel) {
+    // The fast decoupled method needs more but much cheaper iterations
+    mMaxIterations = 30;
+    mWarmStart = true;
+}
+
+void PFSolverFastDecoupled::initialize() {
+    PFSolver::initialize();
+    createFastDecoupledMatrices();
+
+    mProfileLoads.clear();
+    for (auto load : mLoads) {
+        if (load->use_profile)
+            mProfileLoads.push_back(load);
+    }
+}
+
+void PFSolverFastDecoupled::createFastDecoupledMatrices() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    UInt npq = mNumPQBuses;
+
+    std::vector<Eigen::Triplet<Real>> entriesBp, entriesBpp;
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        Real diagBp = 0, diagBpp = 0;
+        Complex rowSum = 0;
+
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            UInt j = it.col();
+            Complex y = it.value();
+            rowSum += y;
+            if (j == k)
+                continue;
+
+            // Susceptance of the series reactance, neglecting the resistance
+            Real series = 0;
+            if (y != Complex(0, 0) && (-1. / y).imag() != 0)
+                series = -1. / (-1. / y).imag();
+            Real full = -y.imag();
+
+            Real offBp = mVariant == Variant::XB ? series : full;
+            Real offBpp = mVariant == Variant::XB ? full : series;
+            diagBp -= offBp;
+            diagBpp -= offBpp;
+
+            Int b = mPQPVBusPositions[j];
+            if (b < 0)
+                continue;
+            entriesBp.emplace_back(a, b, offBp);
+            if (a < npq && b < (Int) npq)
+                entriesBpp.emplace_back(a, b, offBpp);
+        }
+
+        // B' neglects shunts, B'' includes them
+        entriesBp.emplace_back(a, a, diagBp);
+        if (a < npq)
+            entriesBpp.emplace_back(a, a, diagBpp - rowSum.imag());
+    }
+
+    mBp = CPS::SparseMatrix(npqpv, npqpv);
+    mBp.setFromTriplets(entriesBp.begin(), entriesBp.end());
+    mBp.makeCompressed();
+    mBpp = CPS::SparseMatrix(npq, npq);
+    mBpp.setFromTriplets(entriesBpp.begin(), entriesBpp.end());
+    mBpp.makeCompressed();
+
+    // Both matrices are constant and factorized once for the whole simulation
+    if (npqpv > 0) {
+        mBpLU.compute(mBp);
+        if (mBpLU.info() != Eigen::Success)
+            throw SystemError("Factorization of B' failed.");
+    }
+    if (npq > 0) {
+        mBppLU.compute(mBpp);
+        if (mBppLU.info() != Eigen::Success)
+            throw SystemError("Factorization of B'' failed.");
+    }
+    mSLog->info("Fast decoupled matrices: B' with {} nonzeros, B'' with {} nonzeros",
+        mBp.nonZeros(), mBpp.nonZeros());
+}
+
+void PFSolverFastDecoupled::calculatePower(const CPS::Vector& V, const CPS::Vector& D, UInt k, Real& P, Real& Q) const {
+    P = 0;
+    Q = 0;
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
+        Real dSin = sin(D.coeff(k) - D.coeff(j));
+        Real dCos = cos(D.coeff(k) - D.coeff(j));
+        P += V.coeff(j) * (it.value().real() * dCos + it.value().imag() * dSin);
+        Q += V.coeff(j) * (it.value().real() * dSin - it.value().imag() * dCos);
+    }
+    P *= V.coeff(k);
+    Q *= V.coeff(k);
+}
+
+Bool PFSolverFastDecoupled::solveFastDecoupled(CPS::Vector& V, CPS::Vector& D,
+    const CPS::Vector& Pesp, const CPS::Vector& Qesp, UInt& iterations) const {
+
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+    UInt npq = mNumPQBuses;
+    CPS::Vector dP(npqpv), dQ(npq);
+    Real P, Q;
+
+    iterations = 0;
+    for (UInt i = 0; ; ++i) {
+        // Check convergence on the active and reactive power mismatches
+        Real maxMismatch = 0;
+        for (UInt a = 0; a < npqpv; ++a) {
+            UInt k = mPQPVBusIndices[a];
+            calculatePower(V, D, k, P, Q);
+            dP(a) = (Pesp.coeff(k) - P) / V.coeff(k);
+            maxMismatch = std::max(maxMismatch, std::abs(Pesp.coeff(k) - P));
+            if (a < npq)
+                maxMismatch = std::max(maxMismatch, std::abs(Qesp.coeff(k) - Q));
+        }
+        if (maxMismatch < mTolerance)
+            return true;
+        if (i == mMaxIterations)
+            return false;
+
+        // Half iteration for the voltage angles
+        CPS::Vector dTheta = mBpLU.solve(dP);
+        for (UInt a = 0; a < npqpv; ++a)
+            D(mPQPVBusIndices[a]) += dTheta.coeff(a);
+
+        // Half iteration for the voltage magnitudes of PQ buses
+        if (npq > 0) {
+            for (UInt a = 0; a < npq; ++a) {
+                UInt k = mPQPVBusIndices[a];
+                calculatePower(V, D, k, P, Q);
+                dQ(a) = (Qesp.coeff(k) - Q) / V.coeff(k);
+            }
+            CPS::Vector dV = mBppLU.solve(dQ);
+            for (UInt a = 0; a < npq; ++a)
+                V(mPQPVBusIndices[a]) += dV.coeff(a);
+        }
+        iterations = i + 1;
+    }
+}
+
+Bool PFSolverFastDecoupled::solvePowerflow() {
+    CPS::Vector startV = sol_V;
+    CPS::Vector startD = sol_D;
+
+    isConverged = solveFastDecoupled(sol_V, sol_D, Pesp, Qesp, mIterations);
+    if (!isConverged) {
+        mSLog->warn("Fast decoupled powerflow did not converge within {} iterations, falling back to Newton-Raphson", mMaxIterations);
+        sol_V = startV;
+        sol_D = startD;
+        PFSolver::solvePowerflow();
+    }
+    return isConverged;
+}
+
+void PFSolverFastDecoupled::applyStartVoltages(const StepState& state, CPS::Vector& V, CPS::Vector& D) const {
+    if (mWarmStart) {
+        // Keep the set points of slack and PV buses of this time step
+        for (auto k : mVDBusIndices) {
+            V(k) = state.V.coeff(k);
+            D(k) = state.D.coeff(k);
+        }
+        for (auto k : mPVBusIndices)
+            V(k) = state.V.coeff(k);
+    }
+    else {
+        V = state.V;
+        D = state.D;
+    }
+}
+
+void PFSolverFastDecoupled::solveTimeWindow(UInt window) {
+    UInt first = window * mCurrentWindowSize;
+    UInt last = std::min(first + mCurrentWindowSize, mNumSteps);
+    if (first >= last)
+        return;
+
+    // Every window warm starts from its own previous time step
+    CPS::Vector V = mStepStates[first].V;
+    CPS::Vector D = mStepStates[first].D;
+    for (UInt i = first; i < last; ++i) {
+        auto& state = mStepStates[i];
+        auto& solution = mStepSolutions[i];
+        applyStartVoltages(state, V, D);
+        solution.converged = solveFastDecoupled(V, D, state.P, state.Q, solution.iterations);
+        solution.V = V;
+        solution.D = D;
+    }
+}
+
+void PFSolverFastDecoupled::startWorkers() {
+    mStopWorkers = false;
+    mStartBarrier = std::make_unique<Barrier>(mNumThreads, WaitMode::Condition);
+    mDoneBarrier = std::make_unique<Barrier>(mNumThreads, WaitMode::Condition);
+    for (UInt window = 1; window < mNumThreads; ++window) {
+        mWorkers.emplace_back([this, window]() {
+            while (true) {
+                mStartBarrier->wait();
+                if (mStopWorkers)
+                    return;
+                solveTimeWindow(window);
+                mDoneBarrier->wait();
+            }
+        });
+    }
+}
+
+void PFSolverFastDecoupled::stopWorkers() {
+    if (mWorkers.empty())
+        return;
+    mStopWorkers = true;
+    mStartBarrier->wait();
+    for (auto& worker : mWorkers)
+        worker.join();
+    mWorkers.clear();
+}
+
+void PFSolverFastDecoupled::solveTimeWindows(Real time, Int timeStepCount) {
+    // Number of time steps until the final time of the simulation
+    Real remaining = std::ceil((mFinalTime - time) / mTimeStep - 1e-9);
+    mNumSteps = mNumThreads * mWindowSize;
+    if (remaining < mNumSteps)
+        mNumSteps = std::max<UInt>(1, (UInt) remaining);
+    mCurrentWindowSize = (mNumSteps + mNumThreads - 1) / mNumThreads;
+    mFirstStep = timeStepCount;
+
+    // Collect the specified injections of all time steps sequentially
+    // because the components are updated to the time of the step
+    if (mStepStates.size() < mNumSteps) {
+        mStepStates.resize(mNumSteps);
+        mStepSolutions.resize(mNumSteps);
+    }
+    for (UInt i = 0; i < mNumSteps; ++i) {
+        generateInitialSolution(time + i * mTimeStep, mWarmStart);
+        auto& state = mStepStates[i];
+        state.P = Pesp;
+        state.Q = Qesp;
+        state.V = sol_V;
+        state.D = sol_D;
+        state.loadP.resize(mProfileLoads.size());
+        state.loadQ.resize(mProfileLoads.size());
+        for (UInt l = 0; l < mProfileLoads.size(); ++l) {
+            state.loadP[l] = mProfileLoads[l]->attribute<Real>("P")->get();
+            state.loadQ[l] = mProfileLoads[l]->attribute<Real>("Q")->get();
+        }
+    }
+
+    // The workers are kept for the whole simulation and wait between the time windows
+    if (mWorkers.empty())
+        startWorkers();
+    mStartBarrier->wait();
+    solveTimeWindow(0);
+    mDoneBarrier->wait();
+}
+
+void PFSolverFastDecoupled::solve(Real time, Int timeStepCount) {
+    if (mNumThreads <= 1) {
+        PFSolver::solve(time, timeStepCount);
+        return;
+    }
+
+    if (timeStepCount < mFirstStep || timeStepCount >= mFirstStep + (Int) mNumSteps)
+        solveTimeWindows(time, timeStepCount);
+
+    // Restore the cached state of this time step instead of updating the components again
+    auto& state = mStepStates[timeStepCount - mFirstStep];
+    for (UInt l = 0; l < mProfileLoads.size(); ++l) {
+        mProfileLoads[l]->attribute<Real>("P")->set(state.loadP[l]);
+        mProfileLoads[l]->attribute<Real>("Q")->set(state.loadQ[l]);
+        mProfileLoads[l]->calculatePerUnitParameters(mBaseApparentPower, mSystem.mSystemOmega);
+    }
+    sol_P = state.P;
+    sol_Q = state.Q;
+    Pesp = state.P;
+    Qesp = state.Q;
+    applyStartVoltages(state, sol_V, sol_D);
+
+    auto& solution = mStepSolutions[timeStepCount - mFirstStep];
+    if (solution.converged) {
+        sol_V = solution.V;
+        sol_D = solution.D;
+        mIterations = solution.iterations;
+        isConverged = true;
+    }
+    else {
+        solvePowerflow();
+    }
+
+    setSolution();
+}
@@ -16,9 +16,22 @@ PFSolverPowerPolar::PFSolverPowerPolar(CPS::String name, const CPS::SystemTopolo
     : PFSolver(name, system, timeStep, logLevel){ }
 
 void PFSolverPowerPolar::generateInitialSolution(Real time, bool keep_last_solution) {
+	// Voltages of the last solution are the starting point if requested
+	keep_last_solution = keep_last_solution && solutionInitialized;
+	CPS::Vector lastV, lastD;
+	if (keep_last_solution) {
+		lastV = sol_V;
+		lastD = sol_D;
+	}
+
 	resize_sol(mSystem.mNodes.size());
 	resize_complex_sol(mSystem.mNodes.size());
 
+	if (keep_last_solution) {
+		sol_V = lastV;
+		sol_D = lastD;
+	}
+
     // update all components for the new time
     for (auto comp : mSystem.mComponents) {
         if (std::shared_ptr<CPS::SP::Ph1::Load> load = std::dynamic_pointer_cast<CPS::SP::Ph1::Load>(comp)) {
@@ -239,6 +252,49 @@ void PFSolverPowerPolar::calculateJacobian() {
     }
 }
 
+void PFSolverPowerPolar::calculateSparseJacobian() {
+    UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+    mJSparse.coeffs().setZero();
+
+    for (UInt a = 0; a < npqpv; ++a) {
+        UInt k = mPQPVBusIndices[a];
+        Real Vk = sol_V.coeff(k);
+        Bool pqRow = a < mNumPQBuses;
+
+        //diagonal elements of J1 to J4
+        mJSparse.coeffRef(a, a) = -Q(k) - B(k, k) * Vk * Vk;
+        if (pqRow) {
+            mJSparse.coeffRef(a, a + npqpv) = P(k) + G(k, k) * Vk * Vk;
+            mJSparse.coeffRef(a + npqpv, a) = P(k) - G(k, k) * Vk * Vk;
+            mJSparse.coeffRef(a + npqpv, a + npqpv) = Q(k) - B(k, k) * Vk * Vk;
+        }
+
+        //non diagonal elements only where buses are coupled by the admittance matrix
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            UInt j = it.col();
+            Int b = mPQPVBusPositions[j];
+            if (b < 0 || b == (Int) a)
+                continue;
+            Bool pqCol = b < (Int) mNumPQBuses;
+
+            Real VkVj = Vk * sol_V.coeff(j);
+            Real dSin = sin(sol_D.coeff(k) - sol_D.coeff(j));
+            Real dCos = cos(sol_D.coeff(k) - sol_D.coeff(j));
+            Real g = it.value().real();
+            Real bb = it.value().imag();
+
+            mJSparse.coeffRef(a, b) = VkVj * (g * dSin - bb * dCos);
+            if (pqCol)
+                mJSparse.coeffRef(a, b + npqpv) = VkVj * (g * dCos + bb * dSin);
+            if (pqRow)
+                mJSparse.coeffRef(a + npqpv, b) = -VkVj * (g * dCos + bb * dSin);
+            if (pqRow && pqCol)
+                mJSparse.coeffRef(a + npqpv, b + npqpv) = VkVj * (g * dSin - bb * dCos);
+        }
+    }
+}
+
 void PFSolverPowerPolar::updateSolution() {
     UInt npqpv = mNumPQBuses + mNumPVBuses;
     UInt k;
@@ -366,20 +422,22 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j))
-                + B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j))
+                + it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
     Real val = 0.0;
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+        UInt j = it.col();
         val += sol_V.coeff(j)
-                *(G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j))
-                - B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+                *(it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j))
+                - it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
     }
     return sol_V.coeff(k) * val;
 }
@@ -387,8 +445,8 @@ Real PFSolverPowerPolar::Q(UInt k) {
 void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
     for (auto k: mVDBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
@@ -412,8 +470,8 @@ void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
 void PFSolverPowerPolar::calculateQAtPVBuses() {
         for (auto k: mPVBusIndices) {
         CPS::Complex I(0.0, 0.0);
-        for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-            I += mY.coeff(k, j) * sol_Vcx(j);
+        for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+            I += it.value() * sol_Vcx(it.col());
         }
         CPS::Complex S(0.0, 0.0);
         S = sol_Vcx(k) * conj(I);
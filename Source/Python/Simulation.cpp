@@ -17,8 +17,10 @@
 #include <dpsim/Python/Component.h>
 #include <dpsim/RealTimeSimulation.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/SubnetPipelineScheduler.h>
 #include <dpsim/ThreadLevelScheduler.h>
 #include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
 #include <cps/DP/DP_Ph1_Switch.h>
 
 #ifdef WITH_OPENMP
@@ -189,8 +191,9 @@ int Python::Simulation::init(Simulation* self, PyObject *args, PyObject *kwds)
 		case 0: solverType = DPsim::Solver::Type::MNA; break;
 		case 1: solverType = DPsim::Solver::Type::DAE; break;
 		case 2: solverType = DPsim::Solver::Type::NRP; break;
+		case 3: solverType = DPsim::Solver::Type::FDP; break;
 		default:
-			PyErr_SetString(PyExc_TypeError, "Invalid solver_type argument (must be one of 0, 1, 2)");
+			PyErr_SetString(PyExc_TypeError, "Invalid solver_type argument (must be one of 0, 1, 2, 3)");
 			return -1;
 	}
 
@@ -584,12 +587,44 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 	int threads = -1;
 	bool useConditionVariable = false;
 	bool sortTaskTypes = false;
+	bool fuseTasks = false;
+	int rebalanceInterval = 0;
+	PyObject *pyCpus = nullptr;
+	int priority = 0;
+	const char *waitMode = nullptr;
+	int window = 1000;
 
-	const char *kwlist[] = {"scheduler", "threads", "out_measurement_file", "in_measurement_file", "use_condition_variable", "sort_task_types", nullptr};
+	const char *kwlist[] = {"scheduler", "threads", "out_measurement_file", "in_measurement_file", "use_condition_variable", "sort_task_types", "fuse_tasks", "rebalance_interval", "cpus", "priority", "wait_mode", "window", nullptr};
 
-	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|issbb", (char **) kwlist, &schedName, &threads, &outMeasurementFile, &inMeasurementFile, &useConditionVariable, &sortTaskTypes))
+	if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|issbbbiOisi", (char **) kwlist, &schedName, &threads, &outMeasurementFile, &inMeasurementFile, &useConditionVariable, &sortTaskTypes, &fuseTasks, &rebalanceInterval, &pyCpus, &priority, &waitMode, &window))
 		return nullptr;
 
+	WaitMode mode = useConditionVariable ? WaitMode::Condition : WaitMode::Spin;
+	if (waitMode) {
+		if (!strcmp(waitMode, "spin"))
+			mode = WaitMode::Spin;
+		else if (!strcmp(waitMode, "condition"))
+			mode = WaitMode::Condition;
+		else if (!strcmp(waitMode, "adaptive"))
+			mode = WaitMode::Adaptive;
+		else {
+			PyErr_SetString(PyExc_ValueError, "invalid wait mode");
+			return nullptr;
+		}
+	}
+
+	std::vector<Int> cpus;
+	if (pyCpus) {
+		PyObject *seq = PySequence_Fast(pyCpus, "cpus must be a sequence of CPU numbers");
+		if (!seq)
+			return nullptr;
+		for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(seq); i++)
+			cpus.push_back(PyLong_AsLong(PySequence_Fast_GET_ITEM(seq, i)));
+		Py_DECREF(seq);
+		if (PyErr_Occurred())
+			return nullptr;
+	}
+
 	if (!strcmp(schedName, "sequential")) {
 		self->sim->setScheduler(std::make_shared<SequentialScheduler>(outMeasurementFile));
 	} else if (!strcmp(schedName, "omp_level")) {
@@ -603,16 +638,43 @@ PyObject* Python::Simulation::setScheduler(Simulation *self, PyObject *args, PyO
 		// TODO sensible default (`nproc`?)
 		if (threads <= 0)
 			threads = 1;
-		self->sim->setScheduler(std::make_shared<ThreadLevelScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, sortTaskTypes));
+		auto sched = std::make_shared<ThreadLevelScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable, sortTaskTypes);
+		sched->setCpuAffinity(cpus);
+		sched->setRealTimePriority(priority);
+		sched->setWaitMode(mode);
+		self->sim->setScheduler(sched);
 	} else if (!strcmp(schedName, "thread_list")) {
 		if (threads <= 0)
 			threads = 1;
-		self->sim->setScheduler(std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable));
+		auto sched = std::make_shared<ThreadListScheduler>(threads, outMeasurementFile, inMeasurementFile, useConditionVariable);
+		if (rebalanceInterval > 0)
+			sched->setRebalancing(rebalanceInterval);
+		sched->setCpuAffinity(cpus);
+		sched->setRealTimePriority(priority);
+		sched->setWaitMode(mode);
+		self->sim->setScheduler(sched);
+	} else if (!strcmp(schedName, "work_stealing")) {
+		if (threads <= 0)
+			threads = 1;
+		self->sim->setScheduler(std::make_shared<WorkStealingScheduler>(threads, outMeasurementFile, useConditionVariable ? 1000 : 0));
+	} else if (!strcmp(schedName, "subnet_pipeline")) {
+		if (threads <= 0)
+			threads = 1;
+		if (window <= 0) {
+			PyErr_SetString(PyExc_ValueError, "window must be positive");
+			return nullptr;
+		}
+		self->sim->setScheduler(std::make_shared<SubnetPipelineScheduler>(threads, window, outMeasurementFile));
 	} else {
 		PyErr_SetString(PyExc_ValueError, "invalid scheduler");
 		return nullptr;
 	}
 
+	// One super-task per thread and level for the cheap tasks
+	self->sim->doTaskFusion(fuseTasks);
+	if (fuseTasks)
+		self->sim->scheduler()->setTaskFusion(threads > 0 ? threads : std::thread::hardware_concurrency(), inMeasurementFile);
+
 	Py_RETURN_NONE;
 }
 
@@ -0,0 +1,60 @@
+import struct
+
+import numpy
+
+class BinaryLog(object):
+    """ Reader for log files written by a DataLogger with the binary format.
+
+        The rows are memory-mapped into a structured NumPy array without
+        parsing. Columns are accessed by name and returned as views.
+    """
+
+    MAGIC = b'DPSIMLOG'
+    TYPES = { b'f': '<f8', b'i': '<i8' }
+
+    def __init__(self, filename):
+        self.filename = filename
+
+        with open(filename, 'rb') as f:
+            magic, version, num_columns, downsampling, offset = struct.unpack('<8sIIII', f.read(24))
+            if magic != self.MAGIC:
+                raise ValueError('%s is not a binary DPsim log file' % filename)
+            if version != 1:
+                raise ValueError('Unsupported version %d of binary log file %s' % (version, filename))
+
+            names = []
+            formats = []
+            for _ in range(num_columns):
+                type, _, length = struct.unpack('<cBH', f.read(4))
+                names.append(f.read(length).decode())
+                formats.append(self.TYPES[type])
+
+        self.version = version
+        self.downsampling = downsampling
+        self.columns = names
+        self.dtype = numpy.dtype({ 'names': names, 'formats': formats })
+
+        # A file of a running simulation may end with an incomplete row
+        size = numpy.memmap(filename, dtype=numpy.uint8, mode='r').size
+        rows = (size - offset) // self.dtype.itemsize
+        if rows > 0:
+            self.data = numpy.memmap(filename, dtype=self.dtype, mode='r', offset=offset, shape=(rows,))
+        else:
+            self.data = numpy.zeros(0, dtype=self.dtype)
+
+    def __len__(self):
+        return self.data.shape[0]
+
+    def __getitem__(self, name):
+        return self.data[name]
+
+    @property
+    def time(self):
+        return self.data['time']
+
+    def to_dict(self):
+        """ Returns a dictionary of column views indexed by name. """
+        return { name: self.data[name] for name in self.columns }
+
+def read_binary_log(filename):
+    return BinaryLog(filename)
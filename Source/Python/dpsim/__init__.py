@@ -24,6 +24,7 @@ from _dpsim import load_cim
 from .Simulation import Simulation, RealTimeSimulation
 from .EventChannel import EventChannel
 from .Interface import Interface
+from .BinaryLog import BinaryLog, read_binary_log
 
 def __get_module(parts):
     full_name = ".".join(parts)
@@ -64,5 +65,7 @@ __all__ = [
     'Simulation',
     'SystemTopology',
     'Logger',
+    'BinaryLog',
+    'read_binary_log',
     'load_cim',
 ]
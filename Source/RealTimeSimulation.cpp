@@ -38,6 +38,9 @@ void RealTimeSimulation::run(const Timer::StartClock::time_point &startAt) {
 	sync();
 #endif
 
+	for (auto lg : mLoggers)
+		lg->start();
+
 	auto now_time = std::chrono::system_clock::to_time_t(startAt);
 	mLog->info("Starting simulation at {} (delta_T = {} seconds)",
 			  std::put_time(std::localtime(&now_time), "%F %T"),
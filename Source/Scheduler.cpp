@@ -6,12 +6,22 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/Config.h>
 #include <dpsim/Scheduler.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <unordered_map>
 #include <unordered_set>
+#include <thread>
+
+#ifdef HAVE_FUTEX
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
 
 using namespace CPS;
 using namespace DPsim;
@@ -21,12 +31,19 @@ CPS::AttributeBase::Ptr Scheduler::external;
 void Scheduler::initMeasurements(const Task::List& tasks) {
 	// Fill map here already since it's not protected by a mutex
 	for (auto task : tasks) {
-		mMeasurements[task.get()] = std::vector<TaskTime>();
+		mMeasurements[task.get()] = TaskStatistics();
 	}
 }
 
 void Scheduler::updateMeasurement(Task* ptr, TaskTime time) {
-	mMeasurements[ptr].push_back(time);
+	auto& stats = mMeasurements[ptr];
+	Real cost = static_cast<Real>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+	if (stats.count == 0)
+		stats.estimate = cost;
+	else
+		stats.estimate += mEstimateWeight * (cost - stats.estimate);
+	stats.total += time;
+	stats.count++;
 }
 
 void Scheduler::writeMeasurements(String filename) {
@@ -62,16 +79,15 @@ void Scheduler::readMeasurements(String filename, std::unordered_map<String, Tas
 }
 
 Scheduler::TaskTime Scheduler::getAveragedMeasurement(CPS::Task* task) {
-	TaskTime avg(0), tot(0);
-
-	for (TaskTime time : mMeasurements[task]) {
-		tot += time;
-	}
-
-	if (!mMeasurements[task].empty())
-		avg = tot / mMeasurements[task].size();
+	auto& stats = mMeasurements[task];
+	if (stats.count == 0)
+		return TaskTime(0);
+	return stats.total / stats.count;
+}
 
-	return avg;
+Real Scheduler::getEstimatedCost(CPS::Task* task) {
+	auto it = mMeasurements.find(task);
+	return it != mMeasurements.end() ? it->second.estimate : 0;
 }
 
 
@@ -194,6 +210,209 @@ void Scheduler::levelSchedule(const Task::List& tasks, const Edges& inEdges, con
 	}
 }
 
+Scheduler::TaskTime::rep Scheduler::estimateCost(const Task::Ptr& task) {
+	// The steps of single components only update a few values,
+	// whereas solves, logging and interfaces are considered expensive
+	static const std::unordered_set<String> cheapTypes = {
+		"MnaPreStep", "MnaPostStep", "MnaPreStepHarm", "MnaPostStepHarm",
+		"PreStep", "PostStep", "AddBStep", "ControlPreStep", "ControlStep"
+	};
+	String name = task->toString();
+	auto pos = name.rfind('.');
+	if (pos != String::npos && cheapTypes.count(name.substr(pos + 1)))
+		return 100;
+	return std::numeric_limits<TaskTime::rep>::max();
+}
+
+void Scheduler::fuseTasks(Task::List& tasks, Edges& inEdges, Edges& outEdges) {
+	Int numGroups = mFusionGroups > 0 ? mFusionGroups : threads();
+
+	std::unordered_map<String, TaskTime::rep> measurements;
+	if (!mFusionMeasurementFile.empty())
+		readMeasurements(mFusionMeasurementFile, measurements);
+
+	// Only the needed tasks are fused, all others are dropped from the schedule anyway
+	Task::List ordered;
+	topologicalSort(tasks, inEdges, outEdges, ordered);
+
+	std::unordered_map<Task::Ptr, Int> groupOf;
+	std::vector<Task::List> groups;
+	std::vector<TaskTime::rep> costs;
+	std::vector<Bool> cheap;
+	std::vector<Int> levels;
+
+	auto distinct = [](const Edges& edges, const Task::Ptr& task) {
+		std::unordered_set<Task::Ptr> result;
+		auto it = edges.find(task);
+		if (it != edges.end())
+			result.insert(it->second.begin(), it->second.end());
+		return result;
+	};
+
+	for (auto task : ordered) {
+		auto it = measurements.find(task->toString());
+		TaskTime::rep cost = it != measurements.end() ? it->second : estimateCost(task);
+		Bool isCheap = cost <= mFusionMaxTaskCost;
+
+		// Append the task to the chain of its only predecessor if it is its only successor
+		auto before = distinct(inEdges, task);
+		if (isCheap && before.size() == 1 && groupOf.count(*before.begin())) {
+			auto prev = *before.begin();
+			Int group = groupOf[prev];
+			if (cheap[group] && distinct(outEdges, prev).size() == 1) {
+				groupOf[task] = group;
+				groups[group].push_back(task);
+				costs[group] += cost;
+				continue;
+			}
+		}
+
+		// Start a new group one level after its latest predecessor
+		Int level = 0;
+		for (auto prev : before) {
+			auto group = groupOf.find(prev);
+			if (group != groupOf.end())
+				level = std::max(level, levels[group->second] + 1);
+		}
+		groupOf[task] = static_cast<Int>(groups.size());
+		groups.push_back({task});
+		costs.push_back(cost);
+		cheap.push_back(isCheap);
+		levels.push_back(level);
+	}
+
+	// Tasks on the same level do not depend on each other, so the cheap
+	// groups of each level are distributed to the super-tasks by cost
+	Int numLevels = levels.empty() ? 0 : *std::max_element(levels.begin(), levels.end()) + 1;
+	std::vector<std::vector<Int>> cheapGroups(numLevels);
+	for (size_t group = 0; group < groups.size(); group++) {
+		if (cheap[group])
+			cheapGroups[levels[group]].push_back(static_cast<Int>(group));
+	}
+
+	std::unordered_map<Task::Ptr, Task::Ptr> replacement;
+	UInt numFused = 0, numSuperTasks = 0;
+	auto replace = [&](const Task::List& fused) {
+		if (fused.size() < 2)
+			return;
+		auto superTask = std::make_shared<FusedTask>(fused);
+		mSLog->debug("Fused task {}", superTask->toString());
+		for (auto task : fused)
+			replacement[task] = superTask;
+		numFused += static_cast<UInt>(fused.size());
+		numSuperTasks++;
+	};
+
+	for (auto& level : cheapGroups) {
+		std::sort(level.begin(), level.end(), [&costs](Int a, Int b) {
+			return costs[a] > costs[b];
+		});
+		std::vector<Task::List> bins(std::min<size_t>(numGroups, level.size()));
+		std::vector<TaskTime::rep> binCosts(bins.size(), 0);
+		for (auto group : level) {
+			auto minIt = std::min_element(binCosts.begin(), binCosts.end());
+			auto bin = minIt - binCosts.begin();
+			bins[bin].insert(bins[bin].end(), groups[group].begin(), groups[group].end());
+			*minIt += costs[group];
+		}
+		for (auto& bin : bins)
+			replace(bin);
+	}
+	if (replacement.empty())
+		return;
+
+	auto map = [&replacement](const Task::Ptr& task) {
+		auto it = replacement.find(task);
+		return it != replacement.end() ? it->second : task;
+	};
+
+	Task::List fusedTasks;
+	std::unordered_set<Task::Ptr> added;
+	for (auto task : tasks) {
+		auto mapped = map(task);
+		if (added.insert(mapped).second)
+			fusedTasks.push_back(mapped);
+	}
+
+	Edges fusedInEdges, fusedOutEdges;
+	std::unordered_map<Task::Ptr, std::unordered_set<Task::Ptr>> fusedEdges;
+	for (auto task : tasks) {
+		auto out = outEdges.find(task);
+		if (out == outEdges.end())
+			continue;
+		auto from = map(task);
+		for (auto to : out->second) {
+			to = map(to);
+			if (to == from || !fusedEdges[from].insert(to).second)
+				continue;
+			fusedOutEdges[from].push_back(to);
+			fusedInEdges[to].push_back(from);
+		}
+	}
+
+	mSLog->info("Fused {} of {} tasks into {} super-tasks", numFused, ordered.size(), numSuperTasks);
+
+	tasks = std::move(fusedTasks);
+	inEdges = std::move(fusedInEdges);
+	outEdges = std::move(fusedOutEdges);
+}
+
+static String fusedName(const Task::List& tasks) {
+	String name = tasks.front()->toString();
+	for (size_t i = 1; i < tasks.size(); i++)
+		name += "+" + tasks[i]->toString();
+	return name;
+}
+
+FusedTask::FusedTask(const Task::List& tasks) :
+	Task(fusedName(tasks)), mTasks(tasks) {
+	for (auto task : mTasks) {
+		for (auto attr : task->getAttributeDependencies())
+			mAttributeDependencies.push_back(attr);
+		for (auto attr : task->getModifiedAttributes())
+			mModifiedAttributes.push_back(attr);
+		for (auto attr : task->getPrevStepDependencies())
+			mPrevStepDependencies.push_back(attr);
+	}
+	mCompiled.compile(mTasks);
+}
+
+void FusedTask::execute(Real time, Int timeStepCount) {
+	mCompiled.execute(time, timeStepCount);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+CompiledTask::CompiledTask(Task* task) : task(task) {
+	// GCC can resolve the final overrider of a bound member function to a plain
+	// function pointer taking the object as first argument
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpmf-conversions"
+	function = reinterpret_cast<Function>(task->*(&Task::execute));
+#pragma GCC diagnostic pop
+}
+#else
+static void executeTask(Task* task, Real time, Int timeStepCount) {
+	task->execute(time, timeStepCount);
+}
+
+CompiledTask::CompiledTask(Task* task) : function(executeTask), task(task) { }
+#endif
+
+void CompiledSchedule::compile(const Task::List& tasks) {
+	mTasks.clear();
+	mTasks.reserve(tasks.size());
+	for (auto& task : tasks)
+		mTasks.emplace_back(task.get());
+}
+
+void CompiledSchedule::executeTraced(Real time, Int timeStepCount) const {
+	for (auto& task : mTasks) {
+		auto begin = Trace::now();
+		task(time, timeStepCount);
+		Trace::record(task.task, begin, Trace::now());
+	}
+}
+
 void BarrierTask::addBarrier(Barrier* b) {
 	mBarriers.push_back(b);
 }
@@ -208,3 +427,32 @@ void BarrierTask::execute(Real time, Int timeStepCount) {
 		mBarriers[mBarriers.size()-1]->wait();
 	}
 }
+
+Int Sync::spinBudget(Int microseconds) {
+	// Calibrated once, as the duration of a pause instruction differs between CPUs
+	static const Real pausesPerMicrosecond = []() {
+		const Int pauses = 10000;
+		auto start = std::chrono::steady_clock::now();
+		for (Int i = 0; i < pauses; i++)
+			pause();
+		auto end = std::chrono::steady_clock::now();
+		Real duration = std::chrono::duration<Real, std::micro>(end - start).count();
+		return pauses / std::max(duration, 1e-3);
+	}();
+	return static_cast<Int>(microseconds * pausesPerMicrosecond);
+}
+
+void Sync::futexWait(std::atomic<Int>& value, Int expected) {
+#ifdef HAVE_FUTEX
+	static_assert(sizeof(std::atomic<Int>) == sizeof(int), "futex requires a 32 bit word");
+	syscall(SYS_futex, reinterpret_cast<int*>(&value), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+	std::this_thread::yield();
+#endif
+}
+
+void Sync::futexWake(std::atomic<Int>& value) {
+#ifdef HAVE_FUTEX
+	syscall(SYS_futex, reinterpret_cast<int*>(&value), FUTEX_WAKE_PRIVATE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#endif
+}
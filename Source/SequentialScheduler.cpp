@@ -23,6 +23,7 @@ void SequentialScheduler::createSchedule(const Task::List& tasks, const Edges& i
 	if (mOutMeasurementFile.size() != 0)
 		Scheduler::initMeasurements(tasks);
 	Scheduler::topologicalSort(tasks, inEdges, outEdges, mSchedule);
+	mCompiledSchedule.compile(mSchedule);
 
 	for (auto task : mSchedule)
         mSLog->info("{}", task->toString());
@@ -37,9 +38,7 @@ void SequentialScheduler::step(Real time, Int timeStepCount) {
 			updateMeasurement(task.get(), end-start);
 		}
 	} else {
-		for (auto it : mSchedule) {
-			it->execute(time, timeStepCount);
-		}
+		mCompiledSchedule.execute(time, timeStepCount);
 	}
 }
 
@@ -6,12 +6,15 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <cmath>
 #include <chrono>
+#include <cstdlib>
 #include <iomanip>
 #include <algorithm>
 #include <typeindex>
 
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/Trace.h>
 #include <dpsim/Simulation.h>
 #include <dpsim/Utils.h>
 #include <cps/Utils.h>
@@ -20,6 +23,7 @@
 #include <dpsim/MNASolverSysRecomp.h>
 #endif
 #include <dpsim/PFSolverPowerPolar.h>
+#include <dpsim/PFSolverFastDecoupled.h>
 #include <dpsim/DiakopticsSolver.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -32,6 +36,7 @@
   #include <cps/Solver/ODEInterface.h>
   #include <dpsim/DAESolver.h>
   #include <dpsim/ODESolver.h>
+  #include <dpsim/ODEAggregatedSolver.h>
 #endif
 
 using namespace CPS;
@@ -109,12 +114,25 @@ void Simulation::createSolvers() {
 			mSolvers.push_back(solver);
 			break;
 #endif /* WITH_SUNDIALS */
-		case Solver::Type::NRP:
-			solver = std::make_shared<PFSolverPowerPolar>(mName, mSystem, mTimeStep, mLogLevel);
+		case Solver::Type::NRP: {
+			auto pfSolver = std::make_shared<PFSolverPowerPolar>(mName, mSystem, mTimeStep, mLogLevel);
+			pfSolver->doSparseJacobian(mSparsePowerflowJacobian);
+			solver = pfSolver;
 			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
 			solver->initialize();
 			mSolvers.push_back(solver);
 			break;
+		}
+		case Solver::Type::FDP: {
+			auto pfSolver = std::make_shared<PFSolverFastDecoupled>(mName, mSystem, mTimeStep, mLogLevel);
+			pfSolver->setTimeWindows(mPowerflowThreads, mPowerflowWindowSize);
+			pfSolver->setFinalTime(mFinalTime);
+			solver = pfSolver;
+			solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
+			solver->initialize();
+			mSolvers.push_back(solver);
+			break;
+		}
 		default:
 			throw UnsupportedSolverException();
 	}
@@ -122,15 +140,40 @@ void Simulation::createSolvers() {
 	// Some components require a dedicated ODE solver.
 	// This solver is independent of the system solver.
 #ifdef WITH_SUNDIALS
-	for (auto comp : mSystem.mComponents) {
-		auto odeComp = std::dynamic_pointer_cast<ODEInterface>(comp);
-		if (odeComp) {
-			// TODO explicit / implicit integration
-			auto odeSolver = std::make_shared<ODESolver>(
-				odeComp->attribute<String>("name")->get() + "_ODE", odeComp, false, mTimeStep);
+	if (mAggregateODESolvers) {
+		// One solver for all ODE components of a subnet
+		std::vector<SystemTopology> subnets;
+		if (mSplitSubnets)
+			mSystem.splitSubnets<VarType>(subnets);
+		else
+			subnets.push_back(mSystem);
+
+		for (UInt net = 0; net < subnets.size(); ++net) {
+			std::vector<ODEInterface::Ptr> odeComps;
+			for (auto comp : subnets[net].mComponents) {
+				auto odeComp = std::dynamic_pointer_cast<ODEInterface>(comp);
+				if (odeComp)
+					odeComps.push_back(odeComp);
+			}
+			if (odeComps.empty())
+				continue;
+
+			auto odeSolver = std::make_shared<ODEAggregatedSolver>(
+				mName + "_ODE_" + std::to_string(net), odeComps, mImplicitODEIntegration, mTimeStep);
+			odeSolver->setNumThreads(mODEThreads);
 			mSolvers.push_back(odeSolver);
 		}
 	}
+	else {
+		for (auto comp : mSystem.mComponents) {
+			auto odeComp = std::dynamic_pointer_cast<ODEInterface>(comp);
+			if (odeComp) {
+				auto odeSolver = std::make_shared<ODESolver>(
+					odeComp->attribute<String>("name")->get() + "_ODE", odeComp, mImplicitODEIntegration, mTimeStep);
+				mSolvers.push_back(odeSolver);
+			}
+		}
+	}
 #endif /* WITH_SUNDIALS */
 }
 
@@ -138,6 +181,11 @@ template <typename VarType>
 void Simulation::createMNASolver() {
 	Solver::Ptr solver;
 	std::vector<SystemTopology> subnets;
+	if (mTearParts > 1 && mTearComponents.size() == 0) {
+		UInt torn = mSystem.tearSubnets<VarType>(mTearParts);
+		mTearComponents = mSystem.mTearComponents;
+		mLog->info("Network torn into {} parts at {} components", mTearParts, torn);
+	}
 	// The Diakoptics solver splits the system at a later point.
 	// That is why the system is not split here if tear components exist.
 	if (mSplitSubnets && mTearComponents.size() == 0)
@@ -160,29 +208,44 @@ void Simulation::createMNASolver() {
 		else if (mSystemMatrixRecomputation) {
 #ifdef WITH_SPARSE
 			// Recompute system matrix if switches or other components change
-			solver = std::make_shared<MnaSolverSysRecomp<VarType>>(
+			auto recompSolver = std::make_shared<MnaSolverSysRecomp<VarType>>(
 				mName + copySuffix, mDomain, mLogLevel);
-			solver->setTimeStep(mTimeStep);
-			solver->doSteadyStateInit(mSteadyStateInit);
-			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
-			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
-			solver->setSystem(subnets[net]);
-			solver->initialize();
+			recompSolver->setMaxUpdateRank(mMaxUpdateRank);
+			recompSolver->doBatchMachines(mBatchMachines);
+			recompSolver->setTimeStep(mTimeStep);
+			recompSolver->doSteadyStateInit(mSteadyStateInit);
+			recompSolver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
+			recompSolver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			recompSolver->setSystem(subnets[net]);
+			recompSolver->initialize();
+			solver = recompSolver;
 #else
 			throw SystemError("Recomputation Solver requires WITH_SPARSE to be set.");
 #endif
 		}
 		else {
 			// Default case with precomputed system matrices for different configurations
-			solver = MnaSolverFactory::factory<VarType>(mName + copySuffix, mDomain,
+			auto mnaSolver = MnaSolverFactory::factory<VarType>(mName + copySuffix, mDomain,
 												 mLogLevel, mMnaImpl);
-			solver->setTimeStep(mTimeStep);
-			solver->doSteadyStateInit(mSteadyStateInit);
-			solver->doFrequencyParallelization(mFreqParallel);
-			solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
-			solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
-			solver->setSystem(subnets[net]);
-			solver->initialize();
+#ifdef WITH_SPARSE
+			auto woodburySolver = std::dynamic_pointer_cast<MnaSolverWoodbury<VarType>>(mnaSolver);
+			if (woodburySolver)
+				woodburySolver->setSwitchCacheSize(mSwitchCacheSize);
+#endif
+			mnaSolver->doPrecomputeSwitchedMatrices(mPrecomputeSwitchedMatrices);
+			mnaSolver->setSwitchCacheMemoryBudget(mSwitchCacheMemoryBudget);
+			mnaSolver->setTimeStep(mTimeStep);
+			mnaSolver->doSteadyStateInit(mSteadyStateInit);
+			mnaSolver->doFrequencyParallelization(mFreqParallel);
+			mnaSolver->doBatchLinearComponents(mBatchLinearComponents);
+			mnaSolver->doBatchMachines(mBatchMachines);
+			mnaSolver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
+			mnaSolver->setSteadStIniAccLimit(mSteadStIniAccLimit);
+			mnaSolver->setSystem(subnets[net]);
+			mnaSolver->initialize();
+			if (mSwitchCacheWarmUp)
+				mnaSolver->warmUpSwitchedMatrices(mEvents.events());
+			solver = mnaSolver;
 		}
 		mSolvers.push_back(solver);
 	}
@@ -235,6 +298,8 @@ void Simulation::prepSchedule() {
 void Simulation::schedule() {
 	mLog->info("Scheduling tasks.");
 	prepSchedule();
+	if (mTaskFusion)
+		mScheduler->fuseTasks(mTasks, mTaskInEdges, mTaskOutEdges);
 	mScheduler->createSchedule(mTasks, mTaskInEdges, mTaskOutEdges);
 	mLog->info("Scheduling done.");
 }
@@ -370,13 +435,30 @@ void Simulation::start() {
 
 	sync();
 
+	// The step times are recorded without reallocating during the run
+	mStepTimes.reserve(mStepTimes.size() + static_cast<size_t>(std::ceil((mFinalTime - mTime) / mTimeStep)) + 1);
+
+	for (auto lg : mLoggers)
+		lg->start();
+
+	String traceFile = mTraceFile;
+	if (traceFile.empty() && std::getenv("DPSIM_TRACE"))
+		traceFile = std::getenv("DPSIM_TRACE");
+	if (!traceFile.empty()) {
+		mLog->info("Recording trace to {}", traceFile);
+		Trace::setThreadName("Simulation");
+		Trace::start(traceFile, mTraceEventsPerThread, mScheduler->threads());
+	}
+
 	mLog->info("Start simulation: {}", mName);
 	mLog->info("Time step: {:e}", mTimeStep);
 	mLog->info("Final time: {:e}", mFinalTime);
 }
 
 void Simulation::stop() {
+	// All threads that record into the trace are joined before its buffers are freed
 	mScheduler->stop();
+	Trace::stop();
 
 	for (auto ifm : mInterfaces)
 		ifm.interface->close();
@@ -401,8 +483,13 @@ Real Simulation::next() {
 void Simulation::run() {
 	start();
 
-	while (mTime < mFinalTime) {
-		step();
+	if (mScheduler->stepWindow() > 1) {
+		while (mTime < mFinalTime)
+			steps();
+	}
+	else {
+		while (mTime < mFinalTime)
+			step();
 	}
 
 	stop();
@@ -410,6 +497,7 @@ void Simulation::run() {
 
 Real Simulation::step() {
 	auto start = std::chrono::steady_clock::now();
+	Trace::Scope scope(Trace::Category::Step, "Step");
 	mEvents.handleEvents(mTime);
 
 	mScheduler->step(mTime, mTimeStepCount);
@@ -423,6 +511,33 @@ Real Simulation::step() {
 	return mTime;
 }
 
+Real Simulation::steps() {
+	auto start = std::chrono::steady_clock::now();
+	Trace::Scope scope(Trace::Category::Step, "Steps");
+	mEvents.handleEvents(mTime);
+
+	// The window ends before the step at which the next event is handled
+	Real nextEvent = mEvents.nextEventTime();
+	Real time = mTime;
+	Int numSteps = 0;
+	do {
+		time += mTimeStep;
+		numSteps++;
+	} while (numSteps < mScheduler->stepWindow() && time < mFinalTime
+		&& !(time > nextEvent || nextEvent - time < 1e-12));
+
+	mScheduler->steps(mTime, mTimeStep, mTimeStepCount, numSteps);
+
+	mTime = time;
+	mTimeStepCount += numSteps;
+
+	auto end = std::chrono::steady_clock::now();
+	std::chrono::duration<double> diff = end-start;
+	// Average step time, so that the step times cover each step
+	mStepTimes.insert(mStepTimes.end(), numSteps, diff.count() / numSteps);
+	return mTime;
+}
+
 void Simulation::reset() {
 
 	// Resets component states
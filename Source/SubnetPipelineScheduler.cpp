@@ -0,0 +1,172 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/SubnetPipelineScheduler.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+SubnetPipelineScheduler::SubnetPipelineScheduler(Int threads, Int window, String outMeasurementFile) :
+	mNumThreads(threads), mWindow(window), mOutMeasurementFile(outMeasurementFile),
+	mBarrier(threads, WaitMode::Adaptive) {
+	if (threads < 1 || window < 1)
+		throw SchedulingException();
+	mSchedules.resize(threads);
+	mCompiledSchedules.resize(threads);
+}
+
+SubnetPipelineScheduler::~SubnetPipelineScheduler() {
+	if (!mThreads.empty())
+		stop();
+}
+
+void SubnetPipelineScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	if (!mOutMeasurementFile.empty())
+		Scheduler::initMeasurements(tasks);
+
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+
+	// Tasks connected by dependencies within a step form a group
+	std::unordered_map<Task*, Task*> parent;
+	std::function<Task*(Task*)> find = [&](Task* task) {
+		while (parent[task] != task)
+			task = parent[task] = parent[parent[task]];
+		return task;
+	};
+	for (auto task : ordered)
+		parent[task.get()] = task.get();
+	for (auto task : ordered) {
+		auto it = inEdges.find(task);
+		if (it == inEdges.end())
+			continue;
+		for (auto req : it->second) {
+			if (req == mRoot || !parent.count(req.get()))
+				continue;
+			parent[find(req.get())] = find(task.get());
+		}
+	}
+
+	// The groups keep the topological order of their tasks
+	std::unordered_map<Task*, size_t> groupIdx;
+	std::vector<Task::List> groups;
+	std::vector<TaskTime::rep> groupCosts;
+	for (auto task : ordered) {
+		Task* root = find(task.get());
+		auto it = groupIdx.find(root);
+		if (it == groupIdx.end()) {
+			it = groupIdx.emplace(root, groups.size()).first;
+			groups.emplace_back();
+			groupCosts.push_back(0);
+		}
+		groups[it->second].push_back(task);
+		groupCosts[it->second] += estimateCost(task);
+	}
+
+	// Longest processing time first assignment of the groups to the threads
+	std::vector<size_t> order(groups.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+		return groupCosts[a] > groupCosts[b];
+	});
+	std::vector<TaskTime::rep> threadCosts(mNumThreads, 0);
+	std::vector<std::vector<size_t>> threadGroups(mNumThreads);
+	for (auto group : order) {
+		auto thread = std::min_element(threadCosts.begin(), threadCosts.end()) - threadCosts.begin();
+		threadGroups[thread].push_back(group);
+		threadCosts[thread] += groupCosts[group];
+	}
+
+	for (Int thread = 0; thread < mNumThreads; thread++) {
+		mSchedules[thread].clear();
+		// Groups in their original order, so that a thread runs the subnets of a step in a fixed order
+		std::sort(threadGroups[thread].begin(), threadGroups[thread].end());
+		for (auto group : threadGroups[thread])
+			mSchedules[thread].insert(mSchedules[thread].end(), groups[group].begin(), groups[group].end());
+		mCompiledSchedules[thread].compile(mSchedules[thread]);
+	}
+
+	mSLog->info("Scheduled {} task groups on {} threads", groups.size(), mNumThreads);
+	if (static_cast<Int>(groups.size()) < mNumThreads)
+		mSLog->warn("Fewer task groups than threads, some threads stay idle");
+	for (Int thread = 0; thread < mNumThreads; thread++) {
+		mSLog->info("Thread {}: {} tasks, estimated cost {} ns",
+			thread, mSchedules[thread].size(), threadCosts[thread]);
+	}
+}
+
+void SubnetPipelineScheduler::step(Real time, Int timeStepCount) {
+	// The time step is not needed for a single step
+	steps(time, 0, timeStepCount, 1);
+}
+
+void SubnetPipelineScheduler::steps(Real time, Real timeStep, Int timeStepCount, Int numSteps) {
+	if (mThreads.empty()) {
+		for (Int i = 1; i < mNumThreads; i++)
+			mThreads.emplace_back(threadFunction, this, i);
+	}
+
+	mTime = time;
+	mTimeStep = timeStep;
+	mTimeStepCount = timeStepCount;
+	mNumSteps = numSteps;
+	mBarrier.wait();
+	executeSteps(0);
+	Trace::Scope scope(Trace::Category::Wait, "Window barrier");
+	mBarrier.wait();
+}
+
+void SubnetPipelineScheduler::executeSteps(Int thread) {
+	auto& schedule = mSchedules[thread];
+	Real time = mTime;
+	for (Int i = 0; i < mNumSteps; i++) {
+		Int timeStepCount = mTimeStepCount + i;
+		if (mOutMeasurementFile.empty()) {
+			mCompiledSchedules[thread].execute(time, timeStepCount);
+		} else {
+			for (auto& task : schedule) {
+				auto start = std::chrono::steady_clock::now();
+				task->execute(time, timeStepCount);
+				auto end = std::chrono::steady_clock::now();
+				updateMeasurement(task.get(), end-start);
+			}
+		}
+		time += mTimeStep;
+	}
+}
+
+void SubnetPipelineScheduler::threadFunction(SubnetPipelineScheduler* sched, Int idx) {
+	Trace::setThreadName("Subnet thread " + std::to_string(idx));
+	while (true) {
+		sched->mBarrier.wait();
+		if (sched->mJoining)
+			return;
+		sched->executeSteps(idx);
+		Trace::Scope scope(Trace::Category::Wait, "Window barrier");
+		sched->mBarrier.wait();
+	}
+}
+
+void SubnetPipelineScheduler::stop() {
+	if (!mThreads.empty()) {
+		mJoining = true;
+		mBarrier.wait();
+		for (auto& thread : mThreads)
+			thread.join();
+		mThreads.clear();
+		mJoining = false;
+	}
+	if (!mOutMeasurementFile.empty())
+		writeMeasurements(mOutMeasurementFile);
+}
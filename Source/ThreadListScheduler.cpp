@@ -8,6 +8,7 @@
 
 #include <dpsim/ThreadListScheduler.h>
 
+#include <algorithm>
 #include <queue>
 
 using namespace CPS;
@@ -15,82 +16,260 @@ using namespace DPsim;
 
 ThreadListScheduler::ThreadListScheduler(Int threads, String outMeasurementFile, String inMeasurementFile, Bool useConditionVariables) :
 	ThreadScheduler(threads, outMeasurementFile, useConditionVariables), mInMeasurementFile(inMeasurementFile) {
+
+	addAttribute<Real>("critical_path", nullptr, [this](){ return mCriticalPath; }, Flags::read);
+	addAttribute<Real>("makespan", nullptr, [this](){ return mMakespan; }, Flags::read);
+	addAttribute<Real>("efficiency", nullptr, [this](){
+		return mStepTime > 0 ? mTotalCost / (mNumThreads * mStepTime) : 0;
+	}, Flags::read);
+	addAttribute<Int>("rebalances", nullptr, [this](){ return mRebalances; }, Flags::read);
 }
 
-void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
-	Task::List ordered;
+ThreadListScheduler::~ThreadListScheduler() {
+	stopPlanner();
+	freeSchedule(mPlanSchedule);
+}
 
-	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
-	Scheduler::initMeasurements(ordered);
+void ThreadListScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, mOrdered);
+	Scheduler::initMeasurements(mOrdered);
+	mTaskIndex.clear();
+	for (size_t i = 0; i < mOrdered.size(); i++)
+		mTaskIndex[mOrdered[i]] = i;
+	mInEdges = inEdges;
+	mOutEdges = outEdges;
 
-	std::unordered_map<Task::Ptr, int64_t> priorities;
-	std::unordered_map<String, TaskTime::rep> measurements;
+	std::unordered_map<Task::Ptr, Real> costs;
 	if (!mInMeasurementFile.empty()) {
+		std::unordered_map<String, TaskTime::rep> measurements;
 		readMeasurements(mInMeasurementFile, measurements);
 
 		// Check that measurements map is complete
-		for (auto task : ordered) {
-			if (measurements.find(task->toString()) == measurements.end())
+		for (auto task : mOrdered) {
+			auto it = measurements.find(task->toString());
+			if (it == measurements.end())
 				throw SchedulingException();
+			costs[task] = static_cast<Real>(it->second);
 		}
 	} else {
 		// Insert constant cost for each task (HLFNET)
-		for (auto task : ordered) {
-			measurements[task->toString()] = 1;
+		for (auto task : mOrdered) {
+			costs[task] = 1;
 		}
 	}
 
+	Real criticalPath;
+	assignTasks(costs, mAssignment, criticalPath);
+	for (Int thread = 0; thread < mNumThreads; thread++) {
+		for (auto task : mAssignment[thread])
+			scheduleTask(thread, task);
+	}
+
+	// The online cost estimates are based on the measured execution times
+	if (mRebalanceInterval > 0) {
+		mMeasureTasks = true;
+		mPlanCosts.resize(mOrdered.size());
+		if (!mPlanner.joinable())
+			mPlanner = std::thread(plannerFunction, this);
+	}
+
+	ThreadScheduler::finishSchedule(inEdges);
+}
+
+Real ThreadListScheduler::assignTasks(const std::unordered_map<Task::Ptr, Real>& costs,
+	std::vector<Task::List>& assignment, Real& criticalPath) {
+
 	// HLFET
-	for (auto it = ordered.rbegin(); it != ordered.rend(); ++it) {
+	std::unordered_map<Task::Ptr, Real> priorities;
+	criticalPath = 0;
+	for (auto it = mOrdered.rbegin(); it != mOrdered.rend(); ++it) {
 		auto task = *it;
-		int64_t maxLevel = 0;
-		if (outEdges.find(task) != outEdges.end()) {
-			for (auto dep : outEdges.at(task)) {
+		Real maxLevel = 0;
+		if (mOutEdges.find(task) != mOutEdges.end()) {
+			for (auto dep : mOutEdges.at(task)) {
 				if (priorities[dep] > maxLevel) {
 					maxLevel = priorities[dep];
 				}
 			}
 		}
-		priorities[task] = measurements.at(task->toString()) + maxLevel;
+		priorities[task] = costs.at(task) + maxLevel;
+		criticalPath = std::max(criticalPath, priorities[task]);
 	}
 
 	auto cmp = [&priorities](const Task::Ptr& p1, const Task::Ptr& p2) -> bool {
 		return priorities[p1] < priorities[p2];
 	};
 	std::priority_queue<Task::Ptr, std::deque<Task::Ptr>, decltype(cmp)> queue(cmp);
-	for (auto task : ordered) {
-		if (inEdges.find(task) == inEdges.end() || inEdges.at(task).empty()) {
+	for (auto task : mOrdered) {
+		if (mInEdges.find(task) == mInEdges.end() || mInEdges.at(task).empty()) {
 			queue.push(task);
 		} else {
 			break;
 		}
 	}
 
-	std::vector<TaskTime::rep> totalTimes(mNumThreads, 0);
-	Edges inEdgesCpy = inEdges;
+	assignment.assign(mNumThreads, Task::List());
+	std::vector<Real> totalTimes(mNumThreads, 0);
+	Edges inEdgesCpy = mInEdges;
 	while (!queue.empty()) {
 		auto task = queue.top();
 		queue.pop();
 
 		auto minIt = std::min_element(totalTimes.begin(), totalTimes.end());
 		Int minIdx = static_cast<UInt>(minIt - totalTimes.begin());
-		scheduleTask(minIdx, task);
-		totalTimes[minIdx] += measurements.at(task->toString());
+		assignment[minIdx].push_back(task);
+		totalTimes[minIdx] += costs.at(task);
 
-		if (outEdges.find(task) != outEdges.end()) {
-			for (auto after : outEdges.at(task)) {
+		if (mOutEdges.find(task) != mOutEdges.end()) {
+			for (auto after : mOutEdges.at(task)) {
 				for (auto edgeIt = inEdgesCpy[after].begin(); edgeIt != inEdgesCpy[after].end(); ++edgeIt) {
 					if (*edgeIt == task) {
 						inEdgesCpy[after].erase(edgeIt);
 						break;
 					}
 				}
-				if (inEdgesCpy[after].empty() && std::find(ordered.begin(), ordered.end(), after) != ordered.end()) {
+				if (inEdgesCpy[after].empty() && mTaskIndex.count(after)) {
 					queue.push(after);
 				}
 			}
 		}
 	}
 
-	ThreadScheduler::finishSchedule(inEdges);
+	return predictMakespan(costs, assignment);
+}
+
+Real ThreadListScheduler::predictMakespan(const std::unordered_map<Task::Ptr, Real>& costs,
+	const std::vector<Task::List>& assignment) {
+
+	// Each thread executes its tasks in order as soon as their predecessors are finished
+	std::unordered_map<Task::Ptr, Real> finish;
+	std::vector<size_t> next(assignment.size(), 0);
+	std::vector<Real> threadTimes(assignment.size(), 0);
+	size_t remaining = mOrdered.size();
+	while (remaining > 0) {
+		size_t scheduled = 0;
+		for (size_t thread = 0; thread < assignment.size(); thread++) {
+			for (; next[thread] < assignment[thread].size(); next[thread]++) {
+				auto task = assignment[thread][next[thread]];
+				Real start = threadTimes[thread];
+				Bool ready = true;
+				if (mInEdges.find(task) != mInEdges.end()) {
+					for (auto before : mInEdges.at(task)) {
+						auto it = finish.find(before);
+						if (it == finish.end()) {
+							ready = false;
+							break;
+						}
+						start = std::max(start, it->second);
+					}
+				}
+				if (!ready)
+					break;
+				threadTimes[thread] = finish[task] = start + costs.at(task);
+				scheduled++;
+			}
+		}
+		// Cannot happen for assignments created by assignTasks
+		if (scheduled == 0)
+			throw SchedulingException();
+		remaining -= scheduled;
+	}
+	return *std::max_element(threadTimes.begin(), threadTimes.end());
+}
+
+void ThreadListScheduler::requestPlan() {
+	// The measurements of the last step are complete and no thread updates them meanwhile
+	mTotalCost = 0;
+	for (size_t i = 0; i < mOrdered.size(); i++) {
+		mPlanCosts[i] = getEstimatedCost(mOrdered[i].get());
+		mTotalCost += mPlanCosts[i] * 1e-9;
+	}
+	{
+		std::lock_guard<std::mutex> lock(mPlanMutex);
+		mPlanState.store(PlanState::Requested, std::memory_order_release);
+	}
+	mPlanCondition.notify_one();
+}
+
+void ThreadListScheduler::plan() {
+	// The previous schedule is freed here instead of between the steps
+	freeSchedule(mPlanSchedule);
+
+	std::unordered_map<Task::Ptr, Real> costs;
+	for (size_t i = 0; i < mOrdered.size(); i++)
+		costs[mOrdered[i]] = mPlanCosts[i];
+
+	mPlanCurrent = predictMakespan(costs, mAssignment);
+	mPlanBalanced = assignTasks(costs, mPlanAssignment, mPlanCriticalPath);
+	mPlanSwap = mPlanCurrent > (1 + mRebalanceThreshold) * mPlanBalanced;
+	if (mPlanSwap)
+		buildSchedule(mPlanAssignment, mInEdges, mPlanSchedule);
+}
+
+void ThreadListScheduler::applyPlan(Int timeStepCount) {
+	mCriticalPath = mPlanCriticalPath * 1e-9;
+	mMakespan = mPlanCurrent * 1e-9;
+	if (mPlanSwap) {
+		// The helper threads wait at the start barrier meanwhile
+		swapSchedule(mPlanSchedule, timeStepCount);
+		mAssignment.swap(mPlanAssignment);
+		mMakespan = mPlanBalanced * 1e-9;
+		mRebalances++;
+		mSLog->info("Reassigned tasks, predicted makespan {} ns instead of {} ns", mPlanBalanced, mPlanCurrent);
+	}
+	mPlanState.store(PlanState::Idle, std::memory_order_relaxed);
+}
+
+void ThreadListScheduler::plannerFunction(ThreadListScheduler* sched) {
+	std::unique_lock<std::mutex> lock(sched->mPlanMutex);
+	while (true) {
+		sched->mPlanCondition.wait(lock, [sched]() {
+			return sched->mPlannerStop || sched->mPlanState.load(std::memory_order_acquire) == PlanState::Requested;
+		});
+		if (sched->mPlannerStop)
+			return;
+		lock.unlock();
+		sched->plan();
+		lock.lock();
+		sched->mPlanState.store(PlanState::Done, std::memory_order_release);
+	}
+}
+
+void ThreadListScheduler::stopPlanner() {
+	if (!mPlanner.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(mPlanMutex);
+		mPlannerStop = true;
+	}
+	mPlanCondition.notify_one();
+	mPlanner.join();
+	mPlannerStop = false;
+}
+
+void ThreadListScheduler::step(Real time, Int timeStepCount) {
+	if (mRebalanceInterval == 0) {
+		ThreadScheduler::step(time, timeStepCount);
+		return;
+	}
+
+	// The steps do not wait for the planner, a finished plan is applied before the next step
+	if (mPlanState.load(std::memory_order_acquire) == PlanState::Done)
+		applyPlan(timeStepCount);
+	if (timeStepCount > 0 && timeStepCount % mRebalanceInterval == 0
+		&& mPlanState.load(std::memory_order_acquire) == PlanState::Idle)
+		requestPlan();
+
+	auto start = std::chrono::steady_clock::now();
+	ThreadScheduler::step(time, timeStepCount);
+	Real duration = std::chrono::duration<Real>(std::chrono::steady_clock::now() - start).count();
+	if (mStepTime == 0)
+		mStepTime = duration;
+	else
+		mStepTime += mEstimateWeight * (duration - mStepTime);
+}
+
+void ThreadListScheduler::stop() {
+	stopPlanner();
+	ThreadScheduler::stop();
 }
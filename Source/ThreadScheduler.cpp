@@ -6,15 +6,26 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/Config.h>
 #include <dpsim/ThreadScheduler.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 
+#if defined(HAVE_PTHREAD_AFFINITY) || defined(HAVE_PTHREAD_SCHEDPARAM)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
 using namespace CPS;
 using namespace DPsim;
 
 ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile, Bool useConditionVariable) :
-	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable) {
+	mNumThreads(threads), mMeasureTasks(!outMeasurementFile.empty()),
+	mOutMeasurementFile(outMeasurementFile), mStartBarrier(threads, useConditionVariable),
+	mSetupBarrier(threads, useConditionVariable),
+	mWaitMode(useConditionVariable ? WaitMode::Condition : WaitMode::Spin) {
 	if (threads < 1)
 		throw SchedulingException();
 	mTempSchedules.resize(threads);
@@ -30,49 +41,166 @@ void ThreadScheduler::scheduleTask(int thread, CPS::Task::Ptr task) {
 	mTempSchedules[thread].push_back(task);
 }
 
-void ThreadScheduler::finishSchedule(const Edges& inEdges) {
-	std::map<CPS::Task::Ptr, Counter*> counters;
+void ThreadScheduler::buildSchedule(const std::vector<CPS::Task::List>& assignment, const Edges& inEdges, ScheduleBuffer& buffer) {
+	buffer.tasks = assignment;
+	buffer.entries.assign(mNumThreads, nullptr);
+	std::unordered_map<CPS::Task*, Counter*> counters;
 	for (int thread = 0; thread < mNumThreads; thread++) {
-	//	std::cout << "Thread " << thread << std::endl;
-	//	for (auto& entry : mSchedules[thread]) {
-	//		Task* t = entry.task.get();
-	//		char *refpos = reinterpret_cast<char*>(reinterpret_cast<void*>(t)) + sizeof(Task);
-	//		void *ref = *(reinterpret_cast<void**>(refpos));
-	//		std::cout << entry.task->toString() << " " << ref << std::endl;
-	//	}
-		mSchedules[thread] = new ScheduleEntry[mTempSchedules[thread].size()];
-		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			mSchedules[thread][i].task = task.get();
-			counters[task] = &mSchedules[thread][i].endCounter;
+		auto& tasks = buffer.tasks[thread];
+		buffer.entries[thread] = new ScheduleEntry[tasks.size()];
+		for (size_t i = 0; i < tasks.size(); i++) {
+			buffer.entries[thread][i].task = CompiledTask(tasks[i].get());
+			buffer.entries[thread][i].endCounter.setWaitMode(mWaitMode, mSpinWindow);
+			counters[tasks[i].get()] = &buffer.entries[thread][i].endCounter;
 		}
 	}
 	for (int thread = 0; thread < mNumThreads; thread++) {
-		for (size_t i = 0; i < mTempSchedules[thread].size(); i++) {
-			auto& task = mTempSchedules[thread][i];
-			if (inEdges.find(task) != inEdges.end()) {
-				for (auto req : inEdges.at(task)) {
-					mSchedules[thread][i].reqCounters.push_back(counters[req]);
-				}
-			}
+		auto& tasks = buffer.tasks[thread];
+		for (size_t i = 0; i < tasks.size(); i++) {
+			auto it = inEdges.find(tasks[i]);
+			if (it == inEdges.end())
+				continue;
+			for (auto req : it->second)
+				buffer.entries[thread][i].reqCounters.push_back(counters[req.get()]);
+		}
+	}
+}
+
+void ThreadScheduler::swapSchedule(ScheduleBuffer& buffer, Int timeStepCount) {
+	// Helpers without tasks may still be on their way back to the start barrier
+	mThreadsDone.wait(mStepCount * static_cast<Int>(mThreads.size()));
+	std::swap(mTempSchedules, buffer.tasks);
+	std::swap(mSchedules, buffer.entries);
+	// The counters are compared with the time step count
+	for (int thread = 0; thread < mNumThreads; thread++) {
+		for (size_t i = 0; i < mTempSchedules[thread].size(); i++)
+			mSchedules[thread][i].endCounter.set(timeStepCount);
+	}
+}
+
+void ThreadScheduler::freeSchedule(ScheduleBuffer& buffer) {
+	for (auto entries : buffer.entries)
+		delete[] entries;
+	buffer.entries.clear();
+	buffer.tasks.clear();
+}
+
+void ThreadScheduler::finishSchedule(const Edges& inEdges) {
+	mSetupEdges = &inEdges;
+	if (mThreads.empty()) {
+		configureThread(0);
+		for (int i = 1; i < mNumThreads; i++) {
+			mThreads.emplace_back(threadFunction, this, i);
 		}
 	}
-	for (int i = 1; i < mNumThreads; i++) {
-		mThreads.emplace_back(threadFunction, this, i);
+
+	// The helpers set up their own schedules when they pass the start barrier
+	mSetupPending = true;
+	mStartBarrier.wait();
+	setupThread(0);
+	mSetupPending = false;
+	mSetupEdges = nullptr;
+}
+
+void ThreadScheduler::setupThread(Int thread) {
+	auto& tasks = mTempSchedules[thread];
+	mSchedules[thread] = new ScheduleEntry[tasks.size()];
+	for (size_t i = 0; i < tasks.size(); i++) {
+		mSchedules[thread][i].task = CompiledTask(tasks[i].get());
+		// The counters are compared with the time step count, which starts at 0
+		mSchedules[thread][i].endCounter.set(0);
+		mSchedules[thread][i].endCounter.setWaitMode(mWaitMode, mSpinWindow);
+	}
+	// The entries of all threads must exist before they can be linked
+	mSetupBarrier.wait();
+
+	std::unordered_map<CPS::Task*, Counter*> counters;
+	for (int other = 0; other < mNumThreads; other++) {
+		for (size_t i = 0; i < mTempSchedules[other].size(); i++)
+			counters[mTempSchedules[other][i].get()] = &mSchedules[other][i].endCounter;
+	}
+	for (size_t i = 0; i < tasks.size(); i++) {
+		auto it = mSetupEdges->find(tasks[i]);
+		if (it == mSetupEdges->end())
+			continue;
+		for (auto req : it->second)
+			mSchedules[thread][i].reqCounters.push_back(counters[req.get()]);
 	}
+	mSetupBarrier.wait();
+}
+
+void ThreadScheduler::configureThread(Int thread) {
+	if (!mCpus.empty()) {
+		Int cpu = mCpus[thread % mCpus.size()];
+#ifdef HAVE_PTHREAD_AFFINITY
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpu, &cpuSet);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+			mSLog->warn("Failed to pin thread {} to CPU {}", thread, cpu);
+#else
+		mSLog->warn("Pinning thread {} to CPU {} is not supported on this platform", thread, cpu);
+#endif
+	}
+	if (mPriority > 0) {
+#ifdef HAVE_PTHREAD_SCHEDPARAM
+		sched_param param;
+		param.sched_priority = mPriority;
+		if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+			mSLog->warn("Failed to set real-time priority {} of thread {}", mPriority, thread);
+#else
+		mSLog->warn("Real-time priorities are not supported on this platform");
+#endif
+	}
+}
+
+void ThreadScheduler::setWaitMode(WaitMode mode, Int spinWindow) {
+	mWaitMode = mode;
+	mSpinWindow = spinWindow;
+	mStartBarrier.setWaitMode(mode, spinWindow);
+	mSetupBarrier.setWaitMode(mode, spinWindow);
+	mThreadsDone.setWaitMode(mode, spinWindow);
+}
+
+void ThreadScheduler::setStepTimeHistogram(String filename, Real binWidth, UInt bins) {
+	if (binWidth <= 0 || bins == 0)
+		throw SchedulingException();
+	mHistogramFile = filename;
+	mHistogramBinWidth = binWidth;
+	mStepTimeHistograms.assign(mNumThreads, std::vector<Int>(bins, 0));
+}
+
+void ThreadScheduler::writeStepTimeHistograms() {
+	std::ofstream os(mHistogramFile);
+	os << "thread,time,count" << std::endl;
+	for (size_t thread = 0; thread < mStepTimeHistograms.size(); thread++) {
+		auto& histogram = mStepTimeHistograms[thread];
+		for (size_t bin = 0; bin < histogram.size(); bin++) {
+			if (histogram[bin] > 0)
+				os << thread << "," << bin * mHistogramBinWidth << "," << histogram[bin] << std::endl;
+		}
+	}
+	os.close();
 }
 
 void ThreadScheduler::step(Real time, Int timeStepCount) {
 	mTime = time;
 	mTimeStepCount = timeStepCount;
-	mStartBarrier.wait();
+	{
+		Trace::Scope scope(Trace::Category::Wait, "Start barrier");
+		mStartBarrier.wait();
+	}
 	doStep(0);
 	// since we don't have a final BarrierTask, wait for all threads to finish
 	// their last task explicitly
-	for (int thread = 1; thread < mNumThreads; thread++) {
-		if (mTempSchedules[thread].size() != 0)
-			mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1);
+	{
+		Trace::Scope scope(Trace::Category::Wait, "Threads done");
+		for (int thread = 1; thread < mNumThreads; thread++) {
+			if (mTempSchedules[thread].size() != 0)
+				mSchedules[thread][mTempSchedules[thread].size()-1].endCounter.wait(mTimeStepCount+1);
+		}
 	}
+	mStepCount++;
 }
 
 void ThreadScheduler::stop() {
@@ -86,37 +214,89 @@ void ThreadScheduler::stop() {
 	if (!mOutMeasurementFile.empty()) {
 		writeMeasurements(mOutMeasurementFile);
 	}
+	if (!mHistogramFile.empty())
+		writeStepTimeHistograms();
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler* sched, Int idx) {
+	sched->configureThread(idx);
+	Trace::setThreadName("Scheduler thread " + std::to_string(idx));
 	while (true) {
-		sched->mStartBarrier.wait();
+		{
+			Trace::Scope scope(Trace::Category::Wait, "Start barrier");
+			sched->mStartBarrier.wait();
+		}
 		if (sched->mJoining)
 			return;
+		if (sched->mSetupPending) {
+			sched->setupThread(idx);
+			continue;
+		}
 
 		sched->doStep(idx);
+		sched->mThreadsDone.inc();
 	}
 }
 
 void ThreadScheduler::doStep(Int thread) {
-	if (mOutMeasurementFile.empty()) {
-		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
+	if (mStepTimeHistograms.empty()) {
+		executeTasks(thread);
+		return;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	executeTasks(thread);
+	auto end = std::chrono::steady_clock::now();
+	auto& histogram = mStepTimeHistograms[thread];
+	auto bin = static_cast<size_t>(std::chrono::duration<Real>(end - start).count() / mHistogramBinWidth);
+	histogram[std::min(bin, histogram.size() - 1)]++;
+}
+
+void ThreadScheduler::executeTasks(Int thread) {
+	const size_t size = mTempSchedules[thread].size();
+	if (Trace::enabled()) {
+		executeTasksTraced(thread);
+	} else if (!mMeasureTasks) {
+		for (size_t i = 0; i != size; i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
+			if (i + 1 != size)
+				CompiledSchedule::prefetch(entry[1].task.task);
 			for (Counter* counter : entry->reqCounters)
 				counter->wait(mTimeStepCount+1);
-			entry->task->execute(mTime, mTimeStepCount);
+			entry->task(mTime, mTimeStepCount);
 			entry->endCounter.inc();
 		}
 	} else {
-		for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
+		for (size_t i = 0; i != size; i++) {
 			ScheduleEntry* entry = &mSchedules[thread][i];
 			for (Counter* counter : entry->reqCounters)
 				counter->wait(mTimeStepCount+1);
 			auto start = std::chrono::steady_clock::now();
-			entry->task->execute(mTime, mTimeStepCount);
+			entry->task(mTime, mTimeStepCount);
 			auto end = std::chrono::steady_clock::now();
-			updateMeasurement(entry->task, end-start);
+			updateMeasurement(entry->task.task, end-start);
 			entry->endCounter.inc();
 		}
 	}
 }
+
+void ThreadScheduler::executeTasksTraced(Int thread) {
+	for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
+		ScheduleEntry* entry = &mSchedules[thread][i];
+		if (!entry->reqCounters.empty()) {
+			Trace::Scope scope(Trace::Category::Wait, "Dependencies");
+			for (Counter* counter : entry->reqCounters)
+				counter->wait(mTimeStepCount+1);
+		}
+		auto begin = Trace::now();
+		if (mMeasureTasks) {
+			auto start = std::chrono::steady_clock::now();
+			entry->task(mTime, mTimeStepCount);
+			updateMeasurement(entry->task.task, std::chrono::steady_clock::now() - start);
+		} else {
+			entry->task(mTime, mTimeStepCount);
+		}
+		Trace::record(entry->task.task, begin, Trace::now());
+		entry->endCounter.inc();
+	}
+}
@@ -0,0 +1,199 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/Trace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace DPsim;
+using namespace CPS;
+
+std::atomic<Bool> Trace::sEnabled(false);
+
+namespace {
+	struct TraceEvent {
+		std::uint64_t begin;
+		std::uint64_t end;
+		const char* name;
+		const Task* task;
+		Trace::Category category;
+	};
+
+	struct ThreadBuffer {
+		std::vector<TraceEvent> events;
+		size_t count = 0;
+		size_t dropped = 0;
+		String name;
+	};
+
+	/// State of the current recording. The buffers for the scheduler threads are
+	/// allocated by start and claimed by the threads on their first event, further
+	/// threads allocate their buffers under the lock.
+	struct TraceState {
+		std::mutex mutex;
+		String filename;
+		UInt eventsPerThread = 0;
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+		std::atomic<size_t> claimed { 0 };
+		std::vector<std::unique_ptr<ThreadBuffer>> extraBuffers;
+		/// Incremented by each start and stop to invalidate the buffers of the threads
+		std::atomic<UInt> generation { 0 };
+		std::uint64_t startTicks = 0;
+		std::chrono::steady_clock::time_point startTime;
+	};
+
+	TraceState& state() {
+		static TraceState s;
+		return s;
+	}
+
+	thread_local ThreadBuffer* tBuffer = nullptr;
+	thread_local UInt tGeneration = 0;
+	thread_local String tThreadName;
+
+	ThreadBuffer* threadBuffer() {
+		auto& s = state();
+		UInt generation = s.generation.load(std::memory_order_acquire);
+		if (tBuffer && tGeneration == generation)
+			return tBuffer;
+
+		size_t idx = s.claimed.fetch_add(1, std::memory_order_relaxed);
+		if (idx < s.buffers.size()) {
+			tBuffer = s.buffers[idx].get();
+		} else {
+			std::lock_guard<std::mutex> lock(s.mutex);
+			auto buffer = std::unique_ptr<ThreadBuffer>(new ThreadBuffer());
+			buffer->events.resize(s.eventsPerThread);
+			tBuffer = buffer.get();
+			s.extraBuffers.push_back(std::move(buffer));
+		}
+		tBuffer->name = tThreadName.empty() ? "thread " + std::to_string(idx) : tThreadName;
+		tGeneration = generation;
+		return tBuffer;
+	}
+
+	void append(const TraceEvent& event) {
+		// Events ending after stop, e.g. of a scope that was open, are discarded
+		if (!Trace::enabled())
+			return;
+		ThreadBuffer* buffer = threadBuffer();
+		if (buffer->count < buffer->events.size())
+			buffer->events[buffer->count++] = event;
+		else
+			buffer->dropped++;
+	}
+
+	const char* categoryName(Trace::Category category) {
+		switch (category) {
+			case Trace::Category::Step: return "step";
+			case Trace::Category::Task: return "task";
+			case Trace::Category::Wait: return "wait";
+			case Trace::Category::Solver: return "solver";
+		}
+		return "";
+	}
+
+	String escape(const String& str) {
+		String escaped;
+		for (char c : str) {
+			if (c == '"' || c == '\\')
+				escaped += '\\';
+			if (static_cast<unsigned char>(c) >= 0x20)
+				escaped += c;
+		}
+		return escaped;
+	}
+}
+
+void Trace::start(String filename, UInt eventsPerThread, UInt threads) {
+	auto& s = state();
+	{
+		std::lock_guard<std::mutex> lock(s.mutex);
+		s.filename = filename;
+		s.eventsPerThread = eventsPerThread;
+		s.buffers.clear();
+		s.extraBuffers.clear();
+		// The buffers are written once here, so that the threads do not
+		// allocate or page in their buffers during the simulation
+		for (UInt i = 0; i < threads; i++) {
+			s.buffers.emplace_back(new ThreadBuffer());
+			s.buffers.back()->events.resize(eventsPerThread);
+		}
+		s.claimed.store(0, std::memory_order_relaxed);
+		s.generation.fetch_add(1, std::memory_order_release);
+		s.startTime = std::chrono::steady_clock::now();
+		s.startTicks = now();
+	}
+	sEnabled = true;
+}
+
+void Trace::stop() {
+	if (!enabled())
+		return;
+	sEnabled = false;
+
+	auto& s = state();
+	std::lock_guard<std::mutex> lock(s.mutex);
+
+	// Calibrate the ticks against the steady clock over the whole recording
+	std::chrono::duration<Real, std::micro> elapsed = std::chrono::steady_clock::now() - s.startTime;
+	Real ticksPerUs = elapsed.count() > 0 ? (now() - s.startTicks) / elapsed.count() : 1;
+	auto toUs = [&](std::uint64_t ticks) {
+		return (static_cast<Real>(ticks) - static_cast<Real>(s.startTicks)) / ticksPerUs;
+	};
+
+	std::ofstream os(s.filename);
+	os.precision(3);
+	os << std::fixed << "{\"traceEvents\":[" << std::endl;
+	size_t claimed = std::min(s.claimed.load(std::memory_order_relaxed), s.buffers.size());
+	s.buffers.resize(claimed);
+	for (auto& buffer : s.extraBuffers)
+		s.buffers.push_back(std::move(buffer));
+	size_t dropped = 0;
+	for (size_t tid = 0; tid < s.buffers.size(); tid++) {
+		auto& buffer = *s.buffers[tid];
+		dropped += buffer.dropped;
+		os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+			<< ",\"args\":{\"name\":\"" << escape(buffer.name) << "\"}}," << std::endl;
+		for (size_t i = 0; i < buffer.count; i++) {
+			auto& event = buffer.events[i];
+			String name = event.task ? event.task->toString() : String(event.name);
+			os << "{\"name\":\"" << escape(name) << "\",\"cat\":\"" << categoryName(event.category)
+				<< "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+				<< ",\"ts\":" << toUs(event.begin)
+				<< ",\"dur\":" << (event.end - event.begin) / ticksPerUs << "}," << std::endl;
+		}
+	}
+	os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"dpsim\"}}" << std::endl;
+	os << "],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << dropped << "}}" << std::endl;
+	// The recording threads have been joined, so no thread appends to the freed buffers
+	s.buffers.clear();
+	s.extraBuffers.clear();
+	s.generation.fetch_add(1, std::memory_order_release);
+}
+
+void Trace::record(Category category, const char* name, std::uint64_t begin, std::uint64_t end) {
+	append({ begin, end, name, nullptr, category });
+}
+
+void Trace::record(const Task* task, std::uint64_t begin, std::uint64_t end) {
+	append({ begin, end, nullptr, task, Category::Task });
+}
+
+void Trace::setThreadName(const String& name) {
+	tThreadName = name;
+	if (tBuffer && tGeneration == state().generation.load(std::memory_order_acquire)) {
+		std::lock_guard<std::mutex> lock(state().mutex);
+		tBuffer->name = name;
+	}
+}
@@ -52,8 +52,8 @@ CommandLineArgs::CommandLineArgs(int argc, char *argv[],
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDP|MNA)", "Type of solver" },
+		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|EigenSparseWoodbury|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ "params",		required_argument,	0, 'p', "PATH", "Json file containing parametrization"},
@@ -105,8 +105,8 @@ CommandLineArgs::CommandLineArgs(
 		{ "start-at",		required_argument,	0, 'a', "ISO8601", "Start time of real-time simulation" },
 		{ "start-in",		required_argument,	0, 'i', "SECS", "" },
 		{ "solver-domain",	required_argument,	0, 'D', "(SP|DP|EMT)", "Domain of solver" },
-		{ "solver-type",	required_argument,	0, 'T', "(NRP|MNA)", "Type of solver" },
-		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
+		{ "solver-type",	required_argument,	0, 'T', "(NRP|FDP|MNA)", "Type of solver" },
+		{ "solver-mna-impl", required_argument, 0, 'U', "(EigenDense|EigenSparse|EigenSparseWoodbury|CUDADense|CUDASparse)", "Type of MNA Solver implementation"},
 		{ "option",		required_argument,	0, 'o', "KEY=VALUE", "User-definable options" },
 		{ "name",		required_argument,	0, 'n', "NAME", "Name of log files" },
 		{ 0 }
@@ -241,8 +241,10 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 					solver.type = Solver::Type::MNA;
 				else if (arg == "NRP")
 					solver.type = Solver::Type::NRP;
+				else if (arg == "FDP")
+					solver.type = Solver::Type::FDP;
 				else
-					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP or MNA");
+					throw std::invalid_argument("Invalid value for --solver-type: must be a string of NRP, FDP or MNA");
 				break;
 			}
 			case 'U': {
@@ -251,6 +253,8 @@ void CommandLineArgs::parseArguments(int argc, char *argv[])
 					mnaImpl = MnaSolverFactory::EigenDense;
 				} else if (arg == "EigenSparse") {
 					mnaImpl = MnaSolverFactory::EigenSparse;
+				} else if (arg == "EigenSparseWoodbury") {
+					mnaImpl = MnaSolverFactory::EigenSparseWoodbury;
 				} else if (arg == "CUDADense") {
 					mnaImpl = MnaSolverFactory::CUDADense;
 				} else if (arg == "CUDASparse") {
@@ -0,0 +1,232 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/WorkStealingScheduler.h>
+
+#include <unordered_map>
+
+using namespace CPS;
+using namespace DPsim;
+
+void WorkStealingDeque::resize(std::size_t capacity) {
+	std::size_t size = 1;
+	while (size < capacity)
+		size <<= 1;
+	mTasks.reset(new std::atomic<Int>[size]);
+	mMask = static_cast<std::int64_t>(size) - 1;
+	clear();
+}
+
+void WorkStealingDeque::push(Int task) {
+	std::int64_t b = mBottom.load(std::memory_order_relaxed);
+	mTasks[b & mMask].store(task, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	mBottom.store(b + 1, std::memory_order_relaxed);
+}
+
+Int WorkStealingDeque::take() {
+	std::int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+	mBottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t t = mTop.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		mBottom.store(b + 1, std::memory_order_relaxed);
+		return -1;
+	}
+
+	Int task = mTasks[b & mMask].load(std::memory_order_relaxed);
+	if (t == b) {
+		// Last task, compete with the thieves
+		if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			task = -1;
+		mBottom.store(b + 1, std::memory_order_relaxed);
+	}
+	return task;
+}
+
+Int WorkStealingDeque::steal() {
+	std::int64_t t = mTop.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t b = mBottom.load(std::memory_order_acquire);
+
+	if (t >= b)
+		return -1;
+
+	Int task = mTasks[t & mMask].load(std::memory_order_relaxed);
+	if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return -1;
+	return task;
+}
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads, String outMeasurementFile, UInt spinIterations) :
+	mNumThreads(threads), mOutMeasurementFile(outMeasurementFile), mSpinIterations(spinIterations) {
+	if (threads < 1)
+		throw SchedulingException();
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+	joinThreads();
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List& tasks, const Edges& inEdges, const Edges& outEdges) {
+	joinThreads();
+
+	Task::List ordered;
+	Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+	Scheduler::initMeasurements(ordered);
+
+	std::unordered_map<Task::Ptr, Int> indices;
+	mTasks.clear();
+	for (auto task : ordered) {
+		indices[task] = static_cast<Int>(mTasks.size());
+		mTasks.push_back(task.get());
+	}
+
+	// Edges to tasks which were dropped from the schedule (and the root task) are ignored
+	mSuccessorOffsets.assign(1, 0);
+	mSuccessors.clear();
+	mDependencyCounts.assign(mTasks.size(), 0);
+	mRootTasks.clear();
+	for (auto task : ordered) {
+		auto out = outEdges.find(task);
+		if (out != outEdges.end()) {
+			for (auto next : out->second) {
+				auto it = indices.find(next);
+				if (it == indices.end())
+					continue;
+				mSuccessors.push_back(it->second);
+				mDependencyCounts[it->second]++;
+			}
+		}
+		mSuccessorOffsets.push_back(static_cast<Int>(mSuccessors.size()));
+	}
+	for (size_t i = 0; i < mTasks.size(); i++) {
+		if (mDependencyCounts[i] == 0)
+			mRootTasks.push_back(static_cast<Int>(i));
+	}
+
+	mPending.reset(new std::atomic<Int>[mTasks.size()]);
+	mDeques.clear();
+	for (Int thread = 0; thread < mNumThreads; thread++) {
+		mDeques.emplace_back(new WorkStealingDeque());
+		mDeques.back()->resize(mTasks.size());
+	}
+
+	// The helpers must not miss a step which starts before they are running
+	mJoining = false;
+	Int generation = mGeneration.load(std::memory_order_acquire);
+	for (Int thread = 1; thread < mNumThreads; thread++)
+		mThreads.emplace_back(threadFunction, this, thread, generation);
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+	mTime = time;
+	mTimeStepCount = timeStepCount;
+
+	// All helper threads are idle, so the deques can be filled from here
+	for (size_t i = 0; i < mTasks.size(); i++)
+		mPending[i].store(mDependencyCounts[i], std::memory_order_relaxed);
+	for (auto& deque : mDeques)
+		deque->clear();
+	for (size_t i = 0; i < mRootTasks.size(); i++)
+		mDeques[i % mNumThreads]->push(mRootTasks[i]);
+	mRemaining.store(static_cast<Int>(mTasks.size()), std::memory_order_relaxed);
+	mFinished.store(0, std::memory_order_relaxed);
+
+	if (mSpinIterations > 0) {
+		{
+			std::lock_guard<std::mutex> lk(mMutex);
+			mGeneration.fetch_add(1, std::memory_order_release);
+		}
+		mCondition.notify_all();
+	} else {
+		mGeneration.fetch_add(1, std::memory_order_release);
+	}
+
+	doStep(0);
+
+	// The deques must not be touched before all helpers left the step
+	while (mFinished.load(std::memory_order_acquire) != mNumThreads - 1)
+		std::this_thread::yield();
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+	WorkStealingDeque& own = *mDeques[thread];
+
+	while (mRemaining.load(std::memory_order_acquire) > 0) {
+		Int task = own.take();
+		for (Int i = 1; task < 0 && i < mNumThreads; i++)
+			task = mDeques[(thread + i) % mNumThreads]->steal();
+		if (task < 0) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		if (mOutMeasurementFile.empty()) {
+			mTasks[task]->execute(mTime, mTimeStepCount);
+		} else {
+			auto start = std::chrono::steady_clock::now();
+			mTasks[task]->execute(mTime, mTimeStepCount);
+			auto end = std::chrono::steady_clock::now();
+			updateMeasurement(mTasks[task], end-start);
+		}
+
+		for (Int i = mSuccessorOffsets[task]; i < mSuccessorOffsets[task + 1]; i++) {
+			Int next = mSuccessors[i];
+			if (mPending[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				own.push(next);
+		}
+		mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
+
+Bool WorkStealingScheduler::waitForStep(Int thread, Int& generation) {
+	for (UInt i = 0; mSpinIterations == 0 || i < mSpinIterations; i++) {
+		if (mGeneration.load(std::memory_order_acquire) != generation) {
+			generation++;
+			return !mJoining.load(std::memory_order_acquire);
+		}
+		std::this_thread::yield();
+	}
+
+	std::unique_lock<std::mutex> lk(mMutex);
+	mCondition.wait(lk, [this, generation]() {
+		return mGeneration.load(std::memory_order_acquire) != generation;
+	});
+	generation++;
+	return !mJoining.load(std::memory_order_acquire);
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler* sched, Int thread, Int generation) {
+	while (sched->waitForStep(thread, generation)) {
+		sched->doStep(thread);
+		sched->mFinished.fetch_add(1, std::memory_order_release);
+	}
+}
+
+void WorkStealingScheduler::joinThreads() {
+	if (mThreads.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lk(mMutex);
+		mJoining = true;
+		mGeneration.fetch_add(1, std::memory_order_release);
+	}
+	mCondition.notify_all();
+	for (auto& thread : mThreads)
+		thread.join();
+	mThreads.clear();
+}
+
+void WorkStealingScheduler::stop() {
+	joinThreads();
+	if (!mOutMeasurementFile.empty())
+		writeMeasurements(mOutMeasurementFile);
+}
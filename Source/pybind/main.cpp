@@ -82,9 +82,16 @@ PYBIND11_MODULE(dpsimpy, m) {
 		.def("log_attr", &DPsim::Simulation::logIdObjAttr)
 		.def("do_init_from_nodes_and_terminals", &DPsim::Simulation::doInitFromNodesAndTerminals)
 		.def("do_system_matrix_recomputation", &DPsim::Simulation::doSystemMatrixRecomputation)
+		.def("set_max_update_rank", &DPsim::Simulation::setMaxUpdateRank)
 		.def("do_steady_state_init", &DPsim::Simulation::doSteadyStateInit)
 		.def("do_frequency_parallelization", &DPsim::Simulation::doFrequencyParallelization)
+		.def("do_batch_linear_components", &DPsim::Simulation::doBatchLinearComponents)
+		.def("do_batch_machines", &DPsim::Simulation::doBatchMachines)
+		.def("do_aggregate_ode_solvers", &DPsim::Simulation::doAggregateODESolvers)
+		.def("set_ode_threads", &DPsim::Simulation::setODEThreads)
+		.def("set_trace_file", &DPsim::Simulation::setTraceFile, "filename"_a, "events_per_thread"_a = 1 << 20)
 		.def("set_tearing_components", &DPsim::Simulation::setTearingComponents)
+		.def("set_automatic_tearing", &DPsim::Simulation::setAutomaticTearing)
 		.def("add_event", &DPsim::Simulation::addEvent);
 
 	py::class_<DPsim::RealTimeSimulation, DPsim::Simulation>(m, "RealTimeSimulation")
@@ -125,13 +132,24 @@ PYBIND11_MODULE(dpsimpy, m) {
 
 	py::class_<DPsim::Interface>(m, "Interface");
 
+	py::enum_<DPsim::DataLogger::Format>(m, "LoggerFormat")
+		.value("CSV", DPsim::DataLogger::Format::CSV)
+		.value("BINARY", DPsim::DataLogger::Format::Binary);
+
+	py::enum_<DPsim::DataLogger::OverflowPolicy>(m, "LoggerOverflowPolicy")
+		.value("DROP", DPsim::DataLogger::OverflowPolicy::Drop)
+		.value("BLOCK", DPsim::DataLogger::OverflowPolicy::Block)
+		.value("GROW", DPsim::DataLogger::OverflowPolicy::Grow);
+
 	py::class_<DPsim::DataLogger, std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
         .def(py::init<std::string>())
+		.def(py::init<std::string, CPS::Bool, CPS::UInt, DPsim::DataLogger::Format>(), "name"_a, "enabled"_a = true, "downsampling"_a = 1, "format"_a = DPsim::DataLogger::Format::CSV)
 		.def_static("set_log_dir", &CPS::Logger::setLogDir)
 		.def_static("get_log_dir", &CPS::Logger::logDir)
 		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute)
 		.def("log_attribute", (void (DPsim::DataLogger::*)(const CPS::String &, const CPS::String &, CPS::IdentifiedObject::Ptr, CPS::UInt, CPS::UInt)) &DPsim::DataLogger::addAttribute)
-		.def("log_attribute", (void (DPsim::DataLogger::*)(const std::vector<CPS::String> &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute);
+		.def("log_attribute", (void (DPsim::DataLogger::*)(const std::vector<CPS::String> &, const CPS::String &, CPS::IdentifiedObject::Ptr)) &DPsim::DataLogger::addAttribute)
+		.def("do_async", &DPsim::DataLogger::doAsync, "async"_a = true, "capacity"_a = 4096, "policy"_a = DPsim::DataLogger::OverflowPolicy::Block);
 
 	py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(m, "IdentifiedObject")
 		.def("name", &CPS::IdentifiedObject::name)
@@ -172,7 +190,8 @@ PYBIND11_MODULE(dpsimpy, m) {
 	py::enum_<DPsim::Solver::Type>(m, "Solver")
 		.value("MNA", DPsim::Solver::Type::MNA)
 		.value("DAE", DPsim::Solver::Type::DAE)
-		.value("NRP", DPsim::Solver::Type::NRP);
+		.value("NRP", DPsim::Solver::Type::NRP)
+		.value("FDP", DPsim::Solver::Type::FDP);
 
 	py::enum_<CPS::CSVReader::Mode>(m, "CSVReaderMode")
 		.value("AUTO", CPS::CSVReader::Mode::AUTO)
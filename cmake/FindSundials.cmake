@@ -24,8 +24,22 @@ else()
         ${SUNDIALS_KINSOL_LIBRARY}
     )
 
+    # The KLU linear solver is optional and needs the sparse matrix module and KLU itself
+    find_library(SUNDIALS_SUNMATRIXSPARSE_LIBRARY NAMES sundials_sunmatrixsparse)
+    find_library(SUNDIALS_SUNLINSOLKLU_LIBRARY NAMES sundials_sunlinsolklu)
+    find_library(KLU_LIBRARY NAMES klu)
+
+    if (SUNDIALS_SUNMATRIXSPARSE_LIBRARY AND SUNDIALS_SUNLINSOLKLU_LIBRARY AND KLU_LIBRARY)
+        set(Sundials_KLU_FOUND ON)
+        set(SUNDIALS_KLU_LIBRARIES
+            ${SUNDIALS_SUNLINSOLKLU_LIBRARY}
+            ${SUNDIALS_SUNMATRIXSPARSE_LIBRARY}
+            ${KLU_LIBRARY}
+        )
+    endif()
+
     # handle the QUIETLY and REQUIRED arguments and set SUNDIALS_FOUND to TRUE
     # if all listed variables are TRUE
     find_package_handle_standard_args(Sundials DEFAULT_MSG SUNDIALS_ARKODE_LIBRARY SUNDIALS_INCLUDE_DIR)
-    mark_as_advanced(SUNDIALS_INCLUDE_DIR)
+    mark_as_advanced(SUNDIALS_INCLUDE_DIR SUNDIALS_SUNMATRIXSPARSE_LIBRARY SUNDIALS_SUNLINSOLKLU_LIBRARY KLU_LIBRARY)
 endif()
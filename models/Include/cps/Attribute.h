@@ -104,12 +104,15 @@ namespace Flags {
 	public:
 		using Getter = std::function<T()>;
 		using Setter = std::function<void(const T&)>;
+		using Locator = std::function<const T*()>;
 
 	protected:
 		T *mValue;
 
 		Setter mSetter;
 		Getter mGetter;
+		/// Locates the value in memory for attributes with a getter
+		Locator mLocator;
 
 	public:
 		typedef T Type;
@@ -178,6 +181,20 @@ namespace Flags {
 				set(resetValue);
 		}
 
+		/// Returns the address of the value or nullptr if it is only available by value.
+		/// The address stays valid until the owner reallocates the value, e.g. by resizing a matrix.
+		const T* address() const {
+			if (!(mFlags & Flags::read))
+				return nullptr;
+			if (mFlags & Flags::getter)
+				return mLocator ? mLocator() : nullptr;
+			return mValue;
+		}
+
+		void setLocator(Locator locator) {
+			mLocator = locator;
+		}
+
 		T getByValue() const {
 			// Check access
 			if (mFlags & Flags::read) {
@@ -261,7 +278,12 @@ namespace Flags {
 				Complex copyValue = this->getByValue();
 				this->set(Complex(realPart, copyValue.imag()));
 			};
-			return Attribute<Real>::make(nullptr, get, mFlags, shared_from_this());
+			auto attr = Attribute<Real>::make(nullptr, get, mFlags, shared_from_this());
+			attr->setLocator([this]() -> const Real* {
+				auto value = this->address();
+				return value ? &reinterpret_cast<const Real*>(value)[0] : nullptr;
+			});
+			return attr;
 			//Real *realPart = &reinterpret_cast<Real*>(mValue)[0];
 			//return Attribute<Real>::make(realPart, mFlags, shared_from_this());
 		}
@@ -274,7 +296,12 @@ namespace Flags {
 				Complex copyValue = this->getByValue();
 				this->set(Complex(copyValue.real(), imagPart));
 			};
-			return Attribute<Real>::make(nullptr, get, mFlags, shared_from_this());
+			auto attr = Attribute<Real>::make(nullptr, get, mFlags, shared_from_this());
+			attr->setLocator([this]() -> const Real* {
+				auto value = this->address();
+				return value ? &reinterpret_cast<const Real*>(value)[1] : nullptr;
+			});
+			return attr;
 			//Real *imagPart = &reinterpret_cast<Real*>(mValue)[1];
 			//return Attribute<Real>::make(imagPart, mFlags, shared_from_this());
 		}
@@ -330,7 +357,12 @@ namespace Flags {
 			//	mat(row, col) = n;
 			//	this->set(mat);
 			//};
-			return Attribute<T>::make(get, mFlags, shared_from_this());
+			auto attr = Attribute<T>::make(get, mFlags, shared_from_this());
+			attr->setLocator([this, row, col]() -> const T* {
+				auto value = this->address();
+				return value && row < value->rows() && col < value->cols() ? &(*value)(row, col) : nullptr;
+			});
+			return attr;
 			//T *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
 			//return Attribute<T>::make(ptr, mFlags, shared_from_this());
 		}
@@ -354,7 +386,12 @@ namespace Flags {
 			//	mat(row, col) = n;
 			//	this->set(mat);
 			//};
-			return Attribute<Real>::make(get, mFlags, shared_from_this());
+			auto attr = Attribute<Real>::make(get, mFlags, shared_from_this());
+			attr->setLocator([this, row, col]() -> const Real* {
+				auto value = this->address();
+				return value && row < value->rows() && col < value->cols() ? &(*value)(row, col) : nullptr;
+			});
+			return attr;
 			//T *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
 			//return Attribute<T>::make(ptr, mFlags, shared_from_this());
 		}
@@ -373,7 +410,12 @@ namespace Flags {
 			ComplexAttribute::Getter get = [this, row, col]() -> Complex {
 				return this->getByValue()(row, col);
 			};
-			return std::make_shared<ComplexAttribute>(get, mFlags, shared_from_this());
+			auto attr = std::make_shared<ComplexAttribute>(get, mFlags, shared_from_this());
+			attr->setLocator([this, row, col]() -> const Complex* {
+				auto value = this->address();
+				return value && row < value->rows() && col < value->cols() ? &(*value)(row, col) : nullptr;
+			});
+			return attr;
 			//Complex *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
 			//return std::make_shared<ComplexAttribute>(ptr, mFlags, shared_from_this());
 		}
@@ -382,7 +424,13 @@ namespace Flags {
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
 				return this->getByValue()(row,col).real();
 			};
-			return Attribute<Real>::make(get, mFlags, shared_from_this());
+			auto attr = Attribute<Real>::make(get, mFlags, shared_from_this());
+			attr->setLocator([this, row, col]() -> const Real* {
+				auto value = this->address();
+				return value && row < value->rows() && col < value->cols()
+					? &reinterpret_cast<const Real*>(&(*value)(row, col))[0] : nullptr;
+			});
+			return attr;
 			//Complex *ptr = &mValue->data()[mValue->cols() * row + col]; // Column major
 			//Real *realPart = &reinterpret_cast<Real*>(ptr)[0];
 			//return Attribute<Real>::make(&realPart, mFlags, shared_from_this());
@@ -392,7 +440,13 @@ namespace Flags {
 			Attribute<Real>::Getter get = [this, row, col]() -> Real {
 				return this->getByValue()(row,col).imag();;
 			};
-			return Attribute<Real>::make(get, mFlags, shared_from_this());
+			auto attr = Attribute<Real>::make(get, mFlags, shared_from_this());
+			attr->setLocator([this, row, col]() -> const Real* {
+				auto value = this->address();
+				return value && row < value->rows() && col < value->cols()
+					? &reinterpret_cast<const Real*>(&(*value)(row, col))[1] : nullptr;
+			});
+			return attr;
 		}
 
 		Attribute<Real>::Ptr coeffMag(Index row, Index col) {
@@ -18,7 +18,7 @@ namespace Ph3 {
 		///Resistance [ohm]
 		Matrix mResistance;
 		///Conductance [S]
-		Matrix mConductance;
+		Matrix3 mConductance;
 	public:
 		/// Sets model specific parameters
 		void setParameters(Matrix resistance) {
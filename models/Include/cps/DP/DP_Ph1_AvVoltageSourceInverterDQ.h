@@ -85,7 +85,7 @@ namespace Ph1 {
 
 		// #### solver ####
 		///
-		std::vector<const Matrix*> mRightVectorStamps;
+		std::vector<const MNAInterface*> mRightVectorStamps;
 
 	public:
 		/// Defines name amd logging level
@@ -114,7 +114,7 @@ namespace Ph1 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Updates current through the component
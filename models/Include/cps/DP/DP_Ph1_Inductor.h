@@ -10,6 +10,7 @@
 
 #include <cps/SimPowerComp.h>
 #include <cps/Solver/MNATearInterface.h>
+#include <cps/Solver/MNABatchInterface.h>
 #include <cps/Base/Base_Ph1_Inductor.h>
 
 namespace CPS {
@@ -25,6 +26,7 @@ namespace Ph1 {
 	class Inductor :
 		public Base::Ph1::Inductor,
 		public MNATearInterface,
+		public MNABatchInterface,
 		public SimPowerComp<Complex>,
 		public SharedFactory<Inductor> {
 	protected:
@@ -56,7 +58,7 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVectors);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
@@ -75,6 +77,8 @@ namespace Ph1 {
 		void mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes);
 		/// Add MNA post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
+		/// Companion model for the batched execution of the MNA steps
+		Bool mnaBatchModel(MnaBatchModel& model);
 
 		// #### Tearing methods ####
 		void mnaTearInitialize(Real omega, Real timestep);
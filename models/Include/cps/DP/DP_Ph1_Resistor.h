@@ -10,6 +10,7 @@
 
 #include <cps/SimPowerComp.h>
 #include <cps/Solver/MNATearInterface.h>
+#include <cps/Solver/MNABatchInterface.h>
 #include <cps/Solver/DAEInterface.h>
 #include <cps/Base/Base_Ph1_Resistor.h>
 
@@ -20,6 +21,7 @@ namespace Ph1 {
 	class Resistor :
 		public Base::Ph1::Resistor,
 		public MNATearInterface,
+		public MNABatchInterface,
 		public DAEInterface,
 		public SimPowerComp<Complex>,
 		public SharedFactory<Resistor> {
@@ -40,7 +42,7 @@ namespace Ph1 {
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		void mnaInitializeHarm(Real omega, Real timeStep, std::vector<Attribute<Matrix>::Ptr> leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps system matrix considering the frequency index
 		void mnaApplySystemMatrixStampHarm(Matrix& systemMatrix, Int freqIdx);
 		/// Update interface voltage from MNA system result
@@ -53,6 +55,8 @@ namespace Ph1 {
 		void mnaPostStep(Real time, Int timeStepCount, Attribute<Matrix>::Ptr &leftVector);
 		/// add MNA pre and post step dependencies
 		void mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector);
+		/// Companion model for the batched execution of the MNA steps
+		Bool mnaBatchModel(MnaBatchModel& model);
 
 		class MnaPostStep : public Task {
 		public:
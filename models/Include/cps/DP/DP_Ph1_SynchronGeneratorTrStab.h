@@ -10,6 +10,7 @@
 
 #include <cps/SimPowerComp.h>
 #include <cps/Solver/MNAInterface.h>
+#include <cps/Solver/MNAMachineBatchInterface.h>
 #include <cps/Base/Base_SynchronGenerator.h>
 #include <cps/DP/DP_Ph1_VoltageSource.h>
 #include <cps/DP/DP_Ph1_Inductor.h>
@@ -23,6 +24,7 @@ namespace Ph1 {
 	class SynchronGeneratorTrStab :
 		public Base::SynchronGenerator,
 		public MNAInterface,
+		public MNAMachineBatchInterface,
 		public SimPowerComp<Complex>,
 		public SharedFactory<SynchronGeneratorTrStab> {
 	protected:
@@ -47,6 +49,8 @@ namespace Ph1 {
 		std::shared_ptr<VoltageSource> mSubVoltageSource;
 		/// Inner inductor that represents the generator impedance
 		std::shared_ptr<Inductor> mSubInductor;
+		/// Right side vectors of subcomponents
+		std::vector<const MNAInterface*> mRightVectorStamps;
 		/// Logging
 		Matrix mStates;
 		/// Flag for usage of attribute of w_ref (otherwise mNomOmega is used)
@@ -90,7 +94,7 @@ namespace Ph1 {
 		///
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Retrieves calculated voltage from simulation for next step
 		void mnaPostStep(Matrix& rightVector, Matrix& leftVector, Real time);
 		///
@@ -99,6 +103,8 @@ namespace Ph1 {
 		void mnaUpdateVoltage(const Matrix& leftVector);
 
 		void setReferenceOmega(Attribute<Real>::Ptr refOmegaPtr, Attribute<Real>::Ptr refDeltaPtr);
+		/// Machines with a reference omega are not batched
+		Bool mnaBatchMachine(MachineBatchModel& model);
 
 		class MnaPreStep : public Task {
 		public:
@@ -107,6 +113,13 @@ namespace Ph1 {
 				// other attributes generally also influence the pre step,
 				// but aren't marked as writable anyway
 				mPrevStepDependencies.push_back(generator.attribute("v_intf"));
+				// the rotor speed and angle may be the reference of other generators
+				if (generator.mUseOmegaRef) {
+					mAttributeDependencies.push_back(generator.attribute("w_ref"));
+					mAttributeDependencies.push_back(generator.attribute("delta_ref"));
+				}
+				mModifiedAttributes.push_back(generator.attribute("w_r"));
+				mModifiedAttributes.push_back(generator.attribute("delta_r"));
 				mModifiedAttributes.push_back(generator.mSubVoltageSource->attribute("V_ref"));
 			}
 
@@ -31,11 +31,11 @@ namespace Ph3 {
 		public SharedFactory<Capacitor> {
 	protected:
 		/// DC equivalent current source [A]
-		MatrixComp mEquivCurrent = Matrix::Zero(3, 1);
+		VectorComp3 mEquivCurrent = VectorComp3::Zero();
 		/// Equivalent conductance [S]
-		MatrixComp mEquivCond = Matrix::Zero(3, 1);
+		MatrixComp3 mEquivCond = MatrixComp3::Zero();
 		/// Coefficient in front of previous voltage value
-		MatrixComp mPrevVoltCoeff;
+		MatrixComp3 mPrevVoltCoeff;
 		/// init resistive companion model of capacitor
 		void initVars(Real omega, Real timeStep);
 
@@ -55,7 +55,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
@@ -29,9 +29,9 @@ namespace Ph3 {
 		public SharedFactory<Inductor> {
 	protected:
 		/// DC equivalent current source [A]
-		MatrixComp mEquivCurrent;
+		VectorComp3 mEquivCurrent;
 		/// Equivalent conductance [S]
-		MatrixComp mEquivCond;
+		MatrixComp3 mEquivCond;
 		/// Coefficient in front of previous current value
 		Complex mPrevCurrFac;
 
@@ -55,7 +55,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Upgrade values in the source vector and maybe system matrix before MNA solution
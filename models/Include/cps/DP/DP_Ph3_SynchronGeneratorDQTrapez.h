@@ -9,12 +9,15 @@
 #pragma once
 
 #include <cps/DP/DP_Ph3_SynchronGeneratorDQ.h>
+#include <cps/DiscreteStateSpace.h>
+#include <cps/Solver/MNADQMachineBatchInterface.h>
 
 namespace CPS {
 namespace DP {
 namespace Ph3 {
 	class SynchronGeneratorDQTrapez :
 		public SynchronGeneratorDQ,
+		public MNADQMachineBatchInterface,
 		public SharedFactory<SynchronGeneratorDQTrapez> {
 	public:
 		SynchronGeneratorDQTrapez(String uid, String name, Logger::Level loglevel = Logger::Level::off);
@@ -26,6 +29,12 @@ namespace Ph3 {
 
 		// #### MNA Section ####
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
+		/// Machines with multisampling or one damping winding in the q axis are not batched
+		Bool mnaBatchMachine(DQMachineBatchModel& model);
+		/// The machine has no inner components, so all of its tasks are replaced
+		void mnaRemoveBatchedTasks() { mMnaTasks.clear(); }
+		///
+		void mnaBatchUpdateRightVector() { mnaUpdateRightVector(); }
 
 		class MnaPreStep : public Task {
 		public:
@@ -47,6 +56,11 @@ namespace Ph3 {
 
 		// #### Trapezoidal Section ####
 
+		/// Flux state space model, whose state matrix depends on the rotor speed
+		DiscreteStateSpace<> mFluxStateSpace;
+		/// Rotor speed of the current flux state matrix
+		Real mFluxStateSpaceOmMech = std::numeric_limits<Real>::quiet_NaN();
+
 		/// Performs an Euler forward step with the state space model of a synchronous generator
 		/// to calculate the flux and current from the voltage vector in per unit.
 		void stepInPerUnit(Real time);
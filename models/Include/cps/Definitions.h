@@ -83,6 +83,14 @@ namespace CPS {
 	typedef Eigen::SparseLU<SparseMatrix> LUFactorizedSparse;
 	///
 	typedef Eigen::Matrix<Real, Eigen::Dynamic, 1> Vector;
+	/// @brief Fixed-size matrix for real three-phase quantities.
+	typedef Eigen::Matrix<Real, 3, 3> Matrix3;
+	/// @brief Fixed-size vector for real three-phase quantities.
+	typedef Eigen::Matrix<Real, 3, 1> Vector3;
+	/// @brief Fixed-size matrix for complex three-phase quantities.
+	typedef Eigen::Matrix<Complex, 3, 3> MatrixComp3;
+	/// @brief Fixed-size vector for complex three-phase quantities.
+	typedef Eigen::Matrix<Complex, 3, 1> VectorComp3;
 	///
 	template<typename VarType>
 	using MatrixVar = Eigen::Matrix<VarType, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
@@ -0,0 +1,141 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cps/Definitions.h>
+
+namespace CPS {
+	/// Discretization of the linear state space model dx/dt = A x + B u. In contrast to
+	/// Math::StateSpaceTrapezoidal, the discrete matrices are cached and only recomputed
+	/// if A, B or the time step change, and the matrix I - dt/2 A is factorized instead
+	/// of inverted. The number of states and inputs can be fixed at compile time for
+	/// small models to avoid heap allocations.
+	template <int States = Eigen::Dynamic, int Inputs = States>
+	class DiscreteStateSpace {
+	public:
+		typedef Eigen::Matrix<Real, States, States> StateMatrix;
+		typedef Eigen::Matrix<Real, States, Inputs> InputMatrix;
+		typedef Eigen::Matrix<Real, States, 1> StateVector;
+		typedef Eigen::Matrix<Real, Inputs, 1> InputVector;
+
+		enum class Method { Trapezoidal, Euler };
+
+		DiscreteStateSpace(Method method = Method::Trapezoidal) : mMethod(method) { }
+
+		void setMethod(Method method) {
+			if (method != mMethod) {
+				mMethod = method;
+				mValid = false;
+			}
+		}
+
+		/// Sets the state matrix and time step, the factorization is only updated if they changed
+		template <typename DerivedA>
+		void setStateMatrix(const Eigen::MatrixBase<DerivedA>& A, Real dt) {
+			if (mValid && dt == mTimeStep && A == mA)
+				return;
+
+			mA = A;
+			mTimeStep = dt;
+			mValid = true;
+			mStateMatrixValid = false;
+			mInputMatrixValid = false;
+			if (mMethod == Method::Trapezoidal) {
+				StateMatrix F2 = -(dt/2.) * mA;
+				F2.diagonal().array() += 1.;
+				mLu.compute(F2);
+				mF1 = (dt/2.) * mA;
+				mF1.diagonal().array() += 1.;
+			}
+		}
+
+		/// Sets the input matrix, the discrete input matrix is only updated if it changed
+		template <typename DerivedB>
+		void setInputMatrix(const Eigen::MatrixBase<DerivedB>& B) {
+			if (mInputMatrixValid && B == mB)
+				return;
+			mB = B;
+			mInputMatrixValid = false;
+		}
+
+		template <typename DerivedA, typename DerivedB>
+		void setSystem(const Eigen::MatrixBase<DerivedA>& A, const Eigen::MatrixBase<DerivedB>& B, Real dt) {
+			setStateMatrix(A, dt);
+			setInputMatrix(B);
+		}
+
+		/// Discrete state matrix, so that x_k = Ad x_k-1 + Bd (u_k + u_k-1) / 2 for the
+		/// trapezoidal rule and x_k = Ad x_k-1 + Bd u_k-1 for the Euler method
+		const StateMatrix& stateMatrix() {
+			if (!mStateMatrixValid) {
+				if (mMethod == Method::Trapezoidal) {
+					mAd = mLu.solve(mF1);
+				} else {
+					mAd = mTimeStep * mA;
+					mAd.diagonal().array() += 1.;
+				}
+				mStateMatrixValid = true;
+			}
+			return mAd;
+		}
+
+		/// Discrete input matrix, see stateMatrix
+		const InputMatrix& inputMatrix() {
+			if (!mInputMatrixValid) {
+				if (mMethod == Method::Trapezoidal)
+					mBd = mLu.solve(mTimeStep * mB);
+				else
+					mBd = mTimeStep * mB;
+				mInputMatrixValid = true;
+			}
+			return mBd;
+		}
+
+		/// Advances the states with the inputs of the new and the previous step
+		template <typename DerivedX, typename DerivedU1, typename DerivedU2>
+		StateVector step(const Eigen::MatrixBase<DerivedX>& states,
+			const Eigen::MatrixBase<DerivedU1>& uNew, const Eigen::MatrixBase<DerivedU2>& uOld) {
+			if (mMethod == Method::Trapezoidal)
+				return stateMatrix() * states + inputMatrix() * (0.5 * (uNew + uOld));
+			return stateMatrix() * states + inputMatrix() * uOld;
+		}
+
+		/// Advances the states with an input that is constant during the step
+		template <typename DerivedX, typename DerivedU>
+		StateVector step(const Eigen::MatrixBase<DerivedX>& states, const Eigen::MatrixBase<DerivedU>& u) {
+			return stateMatrix() * states + inputMatrix() * u;
+		}
+
+		/// Advances the states with the constant term input = B u. This does not compute the
+		/// discrete state matrix, which is faster if the state matrix changes in every step.
+		template <typename DerivedX, typename DerivedI>
+		StateVector stepWithInput(const Eigen::MatrixBase<DerivedX>& states, const Eigen::MatrixBase<DerivedI>& input) {
+			if (mMethod == Method::Trapezoidal)
+				return mLu.solve(mF1 * states + mTimeStep * input);
+			return states + mTimeStep * (mA * states + input);
+		}
+
+	private:
+		Method mMethod;
+		Real mTimeStep = 0;
+		/// Set if the state matrix and the time step are set for the current method
+		Bool mValid = false;
+		Bool mStateMatrixValid = false;
+		Bool mInputMatrixValid = false;
+
+		StateMatrix mA;
+		InputMatrix mB;
+		/// I + dt/2 A
+		StateMatrix mF1;
+		/// Factorization of I - dt/2 A
+		Eigen::PartialPivLU<StateMatrix> mLu;
+		StateMatrix mAd;
+		InputMatrix mBd;
+	};
+}
@@ -10,6 +10,7 @@
 
 #include <cps/Base/Base_Ph1_VoltageSource.h>
 #include <cps/SimPowerComp.h>
+#include <cps/DiscreteStateSpace.h>
 #include <cps/Solver/MNAInterface.h>
 
 namespace CPS {
@@ -93,6 +94,8 @@ namespace Ph3 {
 		Matrix mB;
 		Matrix mC;
 		Matrix mD;
+		/// Discretized state space model
+		DiscreteStateSpace<14, 6> mStateSpace;
 		// park transform matrix
 		Matrix mParkTransform;
 
@@ -137,7 +140,7 @@ namespace Ph3 {
 		/// Initializes internal variables of the component
 		void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 		/// Stamps system matrix
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Stamps right side (source) vector
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		/// Update interface voltage from MNA system result
@@ -29,9 +29,9 @@ namespace CPS {
 				public SharedFactory<Inductor> {
 			protected:
 				/// DC equivalent current source [A]
-				Matrix mEquivCurrent = Matrix::Zero(3, 1);
+				Vector3 mEquivCurrent = Vector3::Zero();
 				/// Equivalent conductance [S]
-				Matrix mEquivCond = Matrix::Zero(3, 3);
+				Matrix3 mEquivCond = Matrix3::Zero();
 			public:
 				/// Defines UID, name, component parameters and logging level
 				Inductor(String uid, String name, Logger::Level logLevel = Logger::Level::off);
@@ -49,7 +49,7 @@ namespace CPS {
 				/// Initializes internal variables of the component
 				void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 				/// Stamps system matrix
-				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+				void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Stamps right side (source) vector
 				void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 				/// Update interface voltage from MNA system result
@@ -29,7 +29,7 @@ namespace CPS {
 
 				// #### solver ####
 				/// Vector to collect subcomponent right vector stamps
-				std::vector<const Matrix*> mRightVectorStamps;
+				std::vector<const MNAInterface*> mRightVectorStamps;
 			public:
 				/// Defines UID, name, component parameters and logging level
 				NetworkInjection(String uid, String name, Logger::Level loglevel = Logger::Level::off);
@@ -56,7 +56,7 @@ namespace CPS {
 				/// Initializes internal variables of the component
 				void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 				/// Stamps system matrix
-				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+				void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Stamps right side (source) vector
 				void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 				/// Returns current through the component
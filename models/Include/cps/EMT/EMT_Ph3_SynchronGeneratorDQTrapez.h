@@ -9,6 +9,7 @@
 #pragma once
 
 #include <cps/EMT/EMT_Ph3_SynchronGeneratorDQ.h>
+#include <cps/DiscreteStateSpace.h>
 
 namespace CPS {
 namespace EMT {
@@ -40,6 +41,11 @@ namespace Ph3 {
 	protected:
 		// #### Trapezoidal Section ####
 
+		/// Flux state space model, whose state matrix depends on the rotor speed
+		DiscreteStateSpace<> mFluxStateSpace;
+		/// Rotor speed of the current flux state matrix
+		Real mFluxStateSpaceOmMech = std::numeric_limits<Real>::quiet_NaN();
+
 		/// Performs an Euler forward step with the state space model of a synchronous generator
 		/// to calculate the flux and current from the voltage vector in per unit.
 		void stepInPerUnit(Real time);
@@ -24,7 +24,7 @@ namespace CPS {
 				void updateState(Real time);
 
 				/// Equivalent current source [A]
-				Matrix mEquivCurrent = Matrix::Zero(3, 1);
+				Vector3 mEquivCurrent = Vector3::Zero();
 
 				//  ### Real Voltage source parameters ###
 				/// Resistance [ohm]
@@ -51,7 +51,7 @@ namespace CPS {
 				/// Initializes internal variables of the component
 				void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector);
 				/// Stamps system matrix
-				void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+				void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 				/// Stamps right side (source) vector
 				void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 				/// Update interface voltage from MNA system result
@@ -167,18 +167,67 @@ namespace CPS {
 					addToMatrixElement(mat, rows[phase], columns[phase], value);
 		}
 
+		// #### Sparse Matrix Operations ####
+		//
+		// Same layout as the dense variants above. Entries that do not exist yet
+		// are inserted into the sparsity pattern, existing entries are updated in place.
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) = value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) = value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) = - value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) = value.imag();
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Complex value, Int maxFreq = 1, Int freqIdx = 0) {
+			// Assume square matrix
+			Eigen::Index harmonicOffset = mat.rows() / maxFreq;
+			Eigen::Index complexOffset = harmonicOffset / 2;
+			Eigen::Index harmRow = row + harmonicOffset * freqIdx;
+			Eigen::Index harmCol = column + harmonicOffset * freqIdx;
+
+			mat.coeffRef(harmRow, harmCol) += value.real();
+			mat.coeffRef(harmRow + complexOffset, harmCol + complexOffset) += value.real();
+			mat.coeffRef(harmRow, harmCol + complexOffset) -= value.imag();
+			mat.coeffRef(harmRow + complexOffset, harmCol) += value.imag();
+		}
+
+		static void setMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) = value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Complex value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, Matrix::Index row, Matrix::Index column, Real value) {
+			mat.coeffRef(row, column) += value;
+		}
+
+		static void addToMatrixElement(SparseMatrixRow& mat, std::vector<UInt> rows, std::vector<UInt> columns, Real value) {
+			for (UInt phase = 0; phase < rows.size(); phase++)
+					addToMatrixElement(mat, rows[phase], columns[phase], value);
+		}
+
 		// #### Integration Methods ####
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u);
-		static Matrix StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix input, Real dt);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u);
+		static Matrix StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, Real u);
 		static Real StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u);
 
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u);
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u);
-		static Matrix StateSpaceEuler(Matrix states, Matrix A, Matrix input, Real dt);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u);
+		static Matrix StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u);
 		static Real StateSpaceEuler(Real states, Real A, Real B, Real C, Real dt, Real u);
 
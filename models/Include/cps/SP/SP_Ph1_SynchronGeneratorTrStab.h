@@ -47,6 +47,8 @@ namespace Ph1 {
 		std::shared_ptr<VoltageSource> mSubVoltageSource;
 		/// Inner inductor that represents the generator impedance
 		std::shared_ptr<Inductor> mSubInductor;
+		/// Right side vectors of subcomponents
+		std::vector<const MNAInterface*> mRightVectorStamps;
 		/// Logging
 		Matrix mStates;
 		/// Flag for usage of attribute of w_ref (otherwise mNomOmega is used)
@@ -90,7 +92,7 @@ namespace Ph1 {
 		///
 		void mnaApplyRightSideVectorStamp(Matrix& rightVector);
 		///
-		void mnaApplySystemMatrixStamp(Matrix& systemMatrix);
+		void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix);
 		/// Retrieves calculated voltage from simulation for next step
 		void mnaPostStep(Matrix& rightVector, Matrix& leftVector, Real time);
 		///
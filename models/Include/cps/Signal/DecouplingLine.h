@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 
 #include <cps/DP/DP_Ph1_CurrentSource.h>
@@ -34,16 +35,24 @@ namespace Signal {
 		std::shared_ptr<DP::Ph1::CurrentSource> mSrc1, mSrc2;
 		Attribute<Complex>::Ptr mSrcCur1, mSrcCur2;
 
-		// Ringbuffers for the values of previous timesteps
+		// Ringbuffers for the values of previous timesteps, indexed by the time step count
 		// TODO make these matrix attributes
 		std::vector<Complex> mVolt1, mVolt2, mCur1, mCur2;
 		// workaround for dependency analysis as long as the states aren't attributes
 		Matrix mStates;
-		UInt mBufIdx = 0;
+		/// Delay in time steps
 		UInt mBufSize;
 		Real mAlpha;
-
-		Complex interpolate(std::vector<Complex>& data);
+		/// Number of completed pre and post steps of each side. The ringbuffers hold
+		/// twice the delay, so that the two sides can be simulated by different threads
+		/// which run ahead of each other by up to the delay.
+		std::atomic<Int> mPreStepsDone[2];
+		std::atomic<Int> mPostStepsDone[2];
+
+		UInt bufferSlot(Int timeStepCount) const;
+		Complex interpolate(std::vector<Complex>& data, Int timeStepCount);
+		/// Blocks until the given number of steps of the other side are completed
+		static void waitForSteps(const std::atomic<Int>& stepsDone, Int steps);
 	public:
 		typedef std::shared_ptr<DecouplingLine> Ptr;
 
@@ -54,41 +63,43 @@ namespace Signal {
 
 		void setParameters(SimNode<Complex>::Ptr node1, SimNode<Complex>::Ptr node2, Real resistance, Real inductance, Real capacitance);
 		void initialize(Real omega, Real timeStep);
-		void step(Real time, Int timeStepCount);
-		void postStep();
+		/// Updates the current source of the given side (0 or 1) from the delayed values
+		void step(Real time, Int timeStepCount, UInt side);
+		/// Stores the current values of the given side in the ringbuffers
+		void postStep(Int timeStepCount, UInt side);
 		Task::List getTasks();
 		IdentifiedObject::List getLineComponents();
 
 		class PreStep : public Task {
 		public:
-			PreStep(DecouplingLine& line) :
-				Task(line.mName + ".MnaPreStep"), mLine(line) {
+			PreStep(DecouplingLine& line, UInt side) :
+				Task(line.mName + "_" + std::to_string(side + 1) + ".MnaPreStep"), mLine(line), mSide(side) {
 				mPrevStepDependencies.push_back(mLine.attribute("states"));
-				mModifiedAttributes.push_back(mLine.mSrc1->attribute("I_ref"));
-				mModifiedAttributes.push_back(mLine.mSrc2->attribute("I_ref"));
+				mModifiedAttributes.push_back((side == 0 ? mLine.mSrc1 : mLine.mSrc2)->attribute("I_ref"));
 			}
 
 			void execute(Real time, Int timeStepCount);
 
 		private:
 			DecouplingLine& mLine;
+			UInt mSide;
 		};
 
 		class PostStep : public Task {
 		public:
-			PostStep(DecouplingLine& line) :
-				Task(line.mName + ".PostStep"), mLine(line) {
-				mAttributeDependencies.push_back(mLine.mRes1->attribute("v_intf"));
-				mAttributeDependencies.push_back(mLine.mRes1->attribute("i_intf"));
-				mAttributeDependencies.push_back(mLine.mRes2->attribute("v_intf"));
-				mAttributeDependencies.push_back(mLine.mRes2->attribute("i_intf"));
+			PostStep(DecouplingLine& line, UInt side) :
+				Task(line.mName + "_" + std::to_string(side + 1) + ".PostStep"), mLine(line), mSide(side) {
+				auto res = side == 0 ? mLine.mRes1 : mLine.mRes2;
+				mAttributeDependencies.push_back(res->attribute("v_intf"));
+				mAttributeDependencies.push_back(res->attribute("i_intf"));
 				mModifiedAttributes.push_back(mLine.attribute("states"));
-				}
+			}
 
 			void execute(Real time, Int timeStepCount);
 
 		private:
 			DecouplingLine& mLine;
+			UInt mSide;
 		};
 	};
 }
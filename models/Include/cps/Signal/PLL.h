@@ -13,6 +13,7 @@
 #include <cps/SimPowerComp.h>
 #include <cps/SimSignalComp.h>
 #include <cps/Task.h>
+#include <cps/DiscreteStateSpace.h>
 
 namespace CPS {
 namespace Signal {
@@ -52,6 +53,8 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 2);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 2);
+		/// Discretized state space model
+		DiscreteStateSpace<2, 2> mStateSpace;
 		
 	public:
 		PLL(String name, Logger::Level logLevel = Logger::Level::off);
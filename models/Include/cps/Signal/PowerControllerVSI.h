@@ -13,6 +13,7 @@
 #include <cps/SimPowerComp.h>
 #include <cps/SimSignalComp.h>
 #include <cps/Task.h>
+#include <cps/DiscreteStateSpace.h>
 
 namespace CPS {
 namespace Signal {
@@ -72,6 +73,8 @@ namespace Signal {
 		Matrix mC = Matrix::Zero(2, 6);
 		/// matrix D of state space model
 		Matrix mD = Matrix::Zero(2, 6);
+		/// Discretized state space model, of which only the input matrix changes
+		DiscreteStateSpace<6, 6> mStateSpace;
 
 	public:
 		PowerControllerVSI(String name, Logger::Level logLevel = Logger::Level::off);
@@ -0,0 +1,42 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cps/Definitions.h>
+
+namespace CPS {
+	/// Interface for linear two-terminal components in the dynamic phasor domain
+	/// whose MNA pre and post steps can be executed by the solver in a batch.
+	class MNABatchInterface {
+	public:
+		typedef std::shared_ptr<MNABatchInterface> Ptr;
+
+		/// Companion model of the component for the current time step.
+		/// The history current of a step is history = voltageCoeff * v + currentCoeff * i
+		/// with the interface voltage and current of the previous step. After the
+		/// solution, the current is i = conductance * v + history.
+		struct MnaBatchModel {
+			Complex conductance;
+			Complex voltageCoeff;
+			Complex currentCoeff;
+			/// False for components without history current, which do not stamp the source vector
+			Bool hasHistory = false;
+			/// Matrix node indices of the terminals, -1 if grounded
+			Int node0 = -1;
+			Int node1 = -1;
+			/// Interface voltage and current of the component, updated by the batch
+			Complex* voltage = nullptr;
+			Complex* current = nullptr;
+		};
+
+		/// Fills the companion model after the MNA initialization.
+		/// Returns false if the component cannot be batched, e.g. with several frequencies.
+		virtual Bool mnaBatchModel(MnaBatchModel& model) = 0;
+	};
+}
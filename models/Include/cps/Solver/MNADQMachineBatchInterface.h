@@ -0,0 +1,71 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cps/Definitions.h>
+#include <cps/Attribute.h>
+
+namespace CPS {
+	/// Interface for three-phase synchronous generators in the dynamic phasor domain
+	/// that are modelled by a dq0 flux state space model with two damping windings
+	/// in the q axis, so that their flux and rotor dynamics can be integrated by the
+	/// solver in a batch.
+	class MNADQMachineBatchInterface {
+	public:
+		typedef std::shared_ptr<MNADQMachineBatchInterface> Ptr;
+
+		/// Number of windings and flux states of the model
+		static const Int NumStates = 7;
+
+		/// Parameters and states of the machine in per unit. The fluxes follow
+		/// dpsi/dt = w_base ((F + W w_r) psi + v) and the currents are i = C psi.
+		struct DQMachineBatchModel {
+			/// Discretize the fluxes with the trapezoidal rule instead of forward Euler
+			Bool trapezoidal = true;
+			Real timeStep = 0;
+			Real baseOmElec = 0;
+			Real baseOmMech = 0;
+			Real baseVoltage = 0;
+			Real baseCurrent = 0;
+			/// Flux state matrix F without the rotor speed term
+			const Matrix* fluxStateMat = nullptr;
+			/// Rotor speed term W of the flux state matrix
+			const Matrix* omegaFluxMat = nullptr;
+			/// Matrix C that calculates the currents from the fluxes
+			const Matrix* fluxToCurrentMat = nullptr;
+			/// Matrix node indices of the three phases of the terminal, -1 if grounded
+			Int nodes[3] = { -1, -1, -1 };
+			/// Parameters that may change during the simulation
+			const Real* inertia = nullptr;
+			const Real* mechTorque = nullptr;
+			/// States of the machine, updated by the batch
+			Real* omega = nullptr;
+			Real* theta = nullptr;
+			Real* elecTorque = nullptr;
+			Matrix* fluxes = nullptr;
+			Matrix* currents = nullptr;
+			/// Winding voltages, only the stator voltages are updated by the batch
+			Matrix* voltages = nullptr;
+			Matrix* voltageDq0 = nullptr;
+			Matrix* currentDq0 = nullptr;
+			/// Interface voltage and current of the machine, updated by the batch
+			MatrixComp* intfVoltage = nullptr;
+			MatrixComp* intfCurrent = nullptr;
+		};
+
+		/// Fills the machine model after the MNA initialization, returns false
+		/// if the machine cannot be batched
+		virtual Bool mnaBatchMachine(DQMachineBatchModel& model) = 0;
+		/// Removes the pre and post step tasks of the machine, which are replaced by the batch
+		virtual void mnaRemoveBatchedTasks() = 0;
+		/// Stamps the interface current that was updated by the batch into the
+		/// right side vector of the machine
+		virtual void mnaBatchUpdateRightVector() = 0;
+	};
+}
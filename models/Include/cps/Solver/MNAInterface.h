@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <map>
+
 #include <cps/AttributeList.h>
 #include <cps/Config.h>
 #include <cps/Definitions.h>
@@ -28,13 +30,13 @@ namespace CPS {
 		virtual void mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
 			mnaInitialize(omega, timeStep);
 		}
-		/// Stamps system matrix
-		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) { }
 		/// Stamps (sparse) system matrix
-		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
-			Matrix mat = Matrix(systemMatrix);
-			mnaApplySystemMatrixStamp(mat);
-			systemMatrix = mat.sparseView();
+		virtual void mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) { }
+		/// Stamps (dense) system matrix by adding the sparse stamp of the component
+		virtual void mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+			SparseMatrixRow stamp(systemMatrix.rows(), systemMatrix.cols());
+			mnaApplySystemMatrixStamp(stamp);
+			systemMatrix += stamp;
 		}
 		/// Stamps right side (source) vector
 		virtual void mnaApplyRightSideVectorStamp(Matrix& rightVector) { }
@@ -65,6 +67,33 @@ namespace CPS {
 		const Task::List& mnaTasks() {
 			return mMnaTasks;
 		}
+		/// Sets the rows of the right side vector that this component can stamp.
+		/// The stamp is then only stored for these rows, as values in the order of
+		/// the rows. An empty list means that the component can stamp any row.
+		void mnaSetRightVectorRows(const std::vector<UInt>& rows) {
+			mRightVectorRows = rows;
+			if (!rows.empty())
+				mRightVector = Matrix::Zero(rows.size(), 1);
+			else if (mRightVectorSize > 0 && mRightVector.cols() == 1 && (UInt) mRightVector.rows() != mRightVectorSize)
+				mRightVector = Matrix::Zero(mRightVectorSize, 1);
+		}
+		/// Returns the rows of the right side vector that this component can stamp
+		const std::vector<UInt>& mnaRightVectorRows() const {
+			return mRightVectorRows;
+		}
+		/// Returns the stored right side vector stamp, see mnaSetRightVectorRows
+		const Matrix& mnaRightVector() const {
+			return mRightVector;
+		}
+		/// Adds the stored right side vector stamp to the given vector
+		void mnaAddRightVector(Matrix& rightVector) const {
+			if (mRightVectorRows.empty()) {
+				rightVector += mRightVector;
+				return;
+			}
+			for (std::size_t i = 0; i < mRightVectorRows.size(); ++i)
+				rightVector(mRightVectorRows[i], 0) += mRightVector(i, 0);
+		}
 	protected:
 		/// Every MNA component modifies its source vector attribute.
 		MNAInterface() {
@@ -74,7 +103,68 @@ namespace CPS {
 		/// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
 		Task::List mMnaTasks;
 		/// This component's contribution ("stamp") to the right-side vector.
-		/// TODO performance improvements from a sparse representation, at least during copying / summation?
+		/// Only the rows in mRightVectorRows are stored if they are known.
 		Matrix mRightVector;
+		/// Rows of the right-side vector that this component can stamp, empty if unknown
+		std::vector<UInt> mRightVectorRows;
+		/// Number of rows of the right-side vector
+		UInt mRightVectorSize = 0;
+
+		/// Initializes the right-side vector stamp for a system with the given number of rows.
+		/// The stamp is stored for all rows until the solver sets the rows it can touch.
+		void mnaInitializeRightVector(UInt rows) {
+			mRightVectorSize = rows;
+			mRightVectorRows.clear();
+			mRightVector = Matrix::Zero(rows, 1);
+		}
+
+		/// Applies mnaApplyRightSideVectorStamp and stores the result for the known rows
+		void mnaUpdateRightVector() {
+			mnaStoreRightVector([this](Matrix& rightVector) {
+				mnaApplyRightSideVectorStamp(rightVector);
+			});
+		}
+
+		/// Stores the sum of the right-side vector stamps of subcomponents for the known rows
+		void mnaUpdateRightVector(const std::vector<const MNAInterface*>& stamps) {
+			mnaStoreRightVector([&stamps](Matrix& rightVector) {
+				for (auto stamp : stamps)
+					stamp->mnaAddRightVector(rightVector);
+			});
+		}
+
+		/// Adds the right-side vector stamps of subcomponents to the given vector
+		void mnaSumRightVectorStamps(Matrix& rightVector, const std::vector<const MNAInterface*>& stamps) {
+			for (auto stamp : stamps)
+				stamp->mnaAddRightVector(rightVector);
+		}
+
+	private:
+		/// Applies the given stamp to a zero workspace of the full size and stores its
+		/// known rows, which are reset afterwards. The cost is linear in the number of rows
+		/// of the component instead of the system size.
+		template <typename Stamp>
+		void mnaStoreRightVector(Stamp stamp) {
+			if (mRightVectorRows.empty()) {
+				mRightVector.setZero();
+				stamp(mRightVector);
+				return;
+			}
+			Matrix& workspace = mnaRightVectorWorkspace(mRightVectorSize);
+			stamp(workspace);
+			for (std::size_t i = 0; i < mRightVectorRows.size(); ++i) {
+				mRightVector(i, 0) = workspace(mRightVectorRows[i], 0);
+				workspace(mRightVectorRows[i], 0) = 0;
+			}
+		}
+
+		/// Zero vector of the given size per thread that stamps are applied to
+		static Matrix& mnaRightVectorWorkspace(UInt rows) {
+			static thread_local std::map<UInt, Matrix> workspaces;
+			Matrix& workspace = workspaces[rows];
+			if ((UInt) workspace.rows() != rows)
+				workspace = Matrix::Zero(rows, 1);
+			return workspace;
+		}
 	};
 }
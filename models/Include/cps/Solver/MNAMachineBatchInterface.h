@@ -0,0 +1,66 @@
+/* Copyright 2017-2020 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cps/Definitions.h>
+#include <cps/Attribute.h>
+
+namespace CPS {
+	/// Interface for synchronous generators in the dynamic phasor domain that are
+	/// modelled by a classical swing equation and an emf of constant magnitude
+	/// behind an inner impedance, so that their rotor dynamics can be integrated
+	/// by the solver in a batch.
+	class MNAMachineBatchInterface {
+	public:
+		typedef std::shared_ptr<MNAMachineBatchInterface> Ptr;
+
+		/// Parameters and states of the machine. The rotor speed derivative is
+		/// dw/dt = scale * (P_mech - P_elec - damping * (w - w_nom)) with
+		/// scale = w_nom^2 / (2 H P_nom w) or w_nom / (2 H P_nom).
+		struct MachineBatchModel {
+			Real nomOmega = 0;
+			Real nomPower = 0;
+			Real damping = 0;
+			/// Magnitude of the emf behind the inner impedance
+			Real emfAbs = 0;
+			/// Convert the torque to power with the rotor speed instead of the nominal speed
+			Bool convertWithOmegaMech = true;
+			/// Matrix node index of the terminal, -1 if grounded
+			Int node = -1;
+			/// Behaviour of the machine, the states are only integrated during the simulation
+			const Bool* behaviour = nullptr;
+			/// Parameters that may change during the simulation
+			const Real* inertia = nullptr;
+			const Real* mechPower = nullptr;
+			/// States of the machine, updated by the batch
+			Real* omega = nullptr;
+			Real* delta = nullptr;
+			Real* elecPower = nullptr;
+			Complex* emf = nullptr;
+			/// Interface voltage and current of the machine, updated by the batch
+			Complex* voltage = nullptr;
+			Complex* current = nullptr;
+			/// Logged states of the machine in the layout of the machine's own step,
+			/// updated by the batch if set
+			Matrix* states = nullptr;
+			/// Rotor speed and angle attributes, which other machines may use as reference
+			Attribute<Real>::Ptr omegaAttribute;
+			Attribute<Real>::Ptr deltaAttribute;
+			/// Reference voltage of the inner voltage source that is set to the emf
+			Attribute<Complex>::Ptr emfReference;
+			/// Current of the inner impedance, which is the interface current
+			Attribute<MatrixComp>::Ptr innerCurrent;
+		};
+
+		/// Fills the machine model after the MNA initialization and removes the
+		/// pre and post step tasks of the machine, which are replaced by the batch.
+		/// Returns false if the machine cannot be batched.
+		virtual Bool mnaBatchMachine(MachineBatchModel& model) = 0;
+	};
+}
@@ -242,6 +242,14 @@ namespace CPS {
 		template <typename VarType>
 		void splitSubnets(std::vector<CPS::SystemTopology>& splitSystems);
 
+		/// Moves components from the component list to the tear components, so that the
+		/// remaining network falls apart into the given number of parts of similar size
+		/// for the diakoptics solver. The parts are found by recursive bisection of the
+		/// node graph, where only two-terminal components supporting tearing are cut and
+		/// each part keeps a connection to ground. Returns the number of torn components.
+		template <typename VarType>
+		UInt tearSubnets(UInt parts);
+
 #ifdef WITH_GRAPHVIZ
 		Graph::Graph topologyGraph();
 		String render();
@@ -76,7 +76,7 @@ void DP::Ph1::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 		mIntfCurrent(0, freq) = mEquivCond(freq,0) * mIntfVoltage(0,freq) + mEquivCurrent(freq,0);
 	}
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
@@ -113,7 +113,7 @@ void DP::Ph1::Capacitor::mnaInitializeHarm(Real omega, Real timeStep, std::vecto
 	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
-void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
@@ -222,7 +222,7 @@ void DP::Ph1::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevStep
 }
 
 void DP::Ph1::Capacitor::mnaPreStep(Real time, Int timeStepCount) {
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
+	this->mnaUpdateRightVector();
 }
 
 void DP::Ph1::Capacitor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -236,6 +236,20 @@ void DP::Ph1::Capacitor::mnaPostStep(Real time, Int timeStepCount, Attribute<Mat
 	this->mnaUpdateCurrent(*leftVector);
 }
 
+Bool DP::Ph1::Capacitor::mnaBatchModel(MnaBatchModel& model) {
+	if (mNumFreqs != 1)
+		return false;
+	model.conductance = mEquivCond(0,0);
+	model.voltageCoeff = -mPrevVoltCoeff(0,0);
+	model.currentCoeff = -1;
+	model.hasHistory = true;
+	model.node0 = terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1;
+	model.node1 = terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1;
+	model.voltage = &mIntfVoltage(0,0);
+	model.current = &mIntfCurrent(0,0);
+	return true;
+}
+
 void DP::Ph1::Capacitor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mCapacitor.mnaApplyRightSideVectorStampHarm(mCapacitor.mRightVector);
 }
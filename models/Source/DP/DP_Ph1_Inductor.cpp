@@ -86,7 +86,7 @@ void DP::Ph1::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 
 	mSLog->info(
 		"\n--- MNA initialization ---"
@@ -110,7 +110,7 @@ void DP::Ph1::Inductor::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	mRightVector = Matrix::Zero(leftVectors[0]->get().rows(), mNumFreqs);
 }
 
-void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
 		if (terminalNotGrounded(0))
 			Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mEquivCond(freq,0), mNumFreqs, freq);
@@ -206,7 +206,7 @@ void DP::Ph1::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStepD
 }
 
 void DP::Ph1::Inductor::mnaPreStep(Real time, Int timeStepCount) {
-	this->mnaApplyRightSideVectorStamp(this->mRightVector);
+	this->mnaUpdateRightVector();
 }
 
 void DP::Ph1::Inductor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -220,6 +220,20 @@ void DP::Ph1::Inductor::mnaPostStep(Real time, Int timeStepCount, Attribute<Matr
 	this->mnaUpdateCurrent(*leftVector);
 }
 
+Bool DP::Ph1::Inductor::mnaBatchModel(MnaBatchModel& model) {
+	if (mNumFreqs != 1)
+		return false;
+	model.conductance = mEquivCond(0,0);
+	model.voltageCoeff = mEquivCond(0,0);
+	model.currentCoeff = mPrevCurrFac(0,0);
+	model.hasHistory = true;
+	model.node0 = terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1;
+	model.node1 = terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1;
+	model.voltage = &mIntfVoltage(0,0);
+	model.current = &mIntfCurrent(0,0);
+	return true;
+}
+
 void DP::Ph1::Inductor::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
 	mInductor.mnaApplyRightSideVectorStampHarm(mInductor.mRightVector);
 }
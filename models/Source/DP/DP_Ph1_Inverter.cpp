@@ -114,7 +114,7 @@ void DP::Ph1::Inverter::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 
 	calculatePhasors();
 }
@@ -130,7 +130,7 @@ void DP::Ph1::Inverter::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	calculatePhasors();
 }
 
-void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Inverter::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSLog->info("--- Stamping into system matrix ---");
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -189,7 +189,7 @@ void DP::Ph1::Inverter::mnaApplyRightSideVectorStampHarm(Matrix& rightVector, In
 
 void DP::Ph1::Inverter::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mInverter.calculatePhasors();
-	mInverter.mnaApplyRightSideVectorStamp(mInverter.mRightVector);
+	mInverter.mnaUpdateRightVector();
 }
 
 void DP::Ph1::Inverter::MnaPreStepHarm::execute(Real time, Int timeStepCount) {
@@ -115,16 +115,16 @@ void DP::Ph1::RXLoad::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>
 	}
 	if (mSubInductor) {
 		mSubInductor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+		mRightVectorStamps.push_back(mSubInductor.get());
 	}
 	if (mSubCapacitor) {
 		mSubCapacitor->mnaInitialize(omega, timeStep, leftVector);
-		mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+		mRightVectorStamps.push_back(mSubInductor.get());
 	}
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
 void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
@@ -136,7 +136,7 @@ void DP::Ph1::RXLoad::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		mSubCapacitor->mnaApplyRightSideVectorStamp(rightVector);
 }
 
-void DP::Ph1::RXLoad::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RXLoad::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (mSubResistor)
 		mSubResistor->mnaApplySystemMatrixStamp(systemMatrix);
 	if (mSubInductor)
@@ -178,7 +178,7 @@ void DP::Ph1::RXLoad::mnaPreStep(Real time, Int timeStepCount) {
 		mSubCapacitor->mnaPreStep(time, timeStepCount);
 
 	// pre-step of component itself
-	mnaApplyRightSideVectorStamp(mRightVector);
+	mnaUpdateRightVector();
 }
 
 void DP::Ph1::RXLoad::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
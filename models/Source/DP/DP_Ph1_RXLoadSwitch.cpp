@@ -79,25 +79,23 @@ void DP::Ph1::RXLoadSwitch::mnaInitialize(Real omega, Real timeStep, Attribute<M
 	mSubRXLoad->mnaInitialize(omega, timeStep, leftVector);
 	mSubSwitch->mnaInitialize(omega, timeStep, leftVector);
 	// get sub component right vector
-	mRightVectorStamps.push_back(&mSubRXLoad->attribute<Matrix>("right_vector")->get());
+	mRightVectorStamps.push_back(mSubRXLoad.get());
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
 void DP::Ph1::RXLoadSwitch::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	rightVector.setZero();
-	for (auto stamp : mRightVectorStamps)
-		rightVector += *stamp;
+	mnaSumRightVectorStamps(rightVector, mRightVectorStamps);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::RXLoadSwitch::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
-void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(Bool closed, Matrix& systemMatrix, Int freqIdx) {
+void DP::Ph1::RXLoadSwitch::mnaApplySwitchSystemMatrixStamp(Bool closed, SparseMatrixRow& systemMatrix, Int freqIdx) {
 	mSubRXLoad->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubSwitch->mnaApplySwitchSystemMatrixStamp(closed, systemMatrix, freqIdx);
 }
@@ -118,7 +116,7 @@ void DP::Ph1::RXLoadSwitch::mnaPreStep(Real time, Int timeStepCount) {
 
 	// pre-step of component itself
 	updateSwitchState(time);
-	mnaApplyRightSideVectorStamp(mRightVector);
+	mnaUpdateRightVector();
 }
 
 void DP::Ph1::RXLoadSwitch::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies,
@@ -69,7 +69,7 @@ void DP::Ph1::Resistor::mnaInitializeHarm(Real omega, Real timeStep, std::vector
 	mMnaTasks.push_back(std::make_shared<MnaPostStepHarm>(*this, leftVectors));
 }
 
-void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Complex conductance = Complex(1. / mResistance, 0);
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -131,6 +131,20 @@ void DP::Ph1::Resistor::mnaPostStep(Real time, Int timeStepCount, Attribute<Matr
 	this->mnaUpdateCurrent(*leftVector);
 }
 
+Bool DP::Ph1::Resistor::mnaBatchModel(MnaBatchModel& model) {
+	if (mNumFreqs != 1)
+		return false;
+	model.conductance = 1. / mResistance;
+	model.voltageCoeff = 0;
+	model.currentCoeff = 0;
+	model.hasHistory = false;
+	model.node0 = terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0)) : -1;
+	model.node1 = terminalNotGrounded(1) ? static_cast<Int>(matrixNodeIndex(1)) : -1;
+	model.voltage = &mIntfVoltage(0,0);
+	model.current = &mIntfCurrent(0,0);
+	return true;
+}
+
 void DP::Ph1::Resistor::MnaPostStepHarm::execute(Real time, Int timeStepCount) {
 	for (UInt freq = 0; freq < mResistor.mNumFreqs; freq++)
 		mResistor.mnaUpdateVoltageHarm(*mLeftVectors[freq], freq);
@@ -116,23 +116,23 @@ void DP::Ph1::SVC::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::P
 		mTerminals[0]->node()->name(), mTerminals[0]->node()->matrixNodeIndex());
 
     mSubInductor->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubInductor->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(mSubInductor.get());
 
     mSubInductorSwitch->mnaInitialize(omega, timeStep, leftVector);
-    mRighteVctorStamps.push_back(&mSubInductorSwitch->attribute<Matrix>("right_vector")->get());
+    mRighteVctorStamps.push_back(mSubInductorSwitch.get());
 
     mSubCapacitor->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubCapacitor->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(mSubCapacitor.get());
 
     mSubCapacitorSwitch->mnaInitialize(omega, timeStep, leftVector);
-    mRightVectorStamps.push_back(&mSubCapacitorSwitch->attribute<Matrix>("right_vector")->get());
+    mRightVectorStamps.push_back(mSubCapacitorSwitch.get());
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
-void DP::Ph1::SVC::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SVC::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitor->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubCapacitorSwitch->mnaApplySystemMatrixStamp(systemMatrix);
@@ -163,7 +163,7 @@ void DP::Ph1::SVC::mnaPreStep(Real time, Int timeStepCount) {
     mSubCapacitor->mnaPreStep(time, timeStepCount);
     mSubCapacitorSwitch->mnaPreStep(time, timeStepCount);
 
-    mnaApplyRightSideVectorStamp(mRightVector);
+    mnaUpdateRightVector();
 
 	if (time > 0.1 && !mDisconnect) {
 		if (mMechMode) {
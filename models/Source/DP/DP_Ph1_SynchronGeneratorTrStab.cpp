@@ -255,8 +255,11 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 
 	mSubVoltageSource->mnaInitialize(omega, timeStep, leftVector);
 	mSubInductor->mnaInitialize(omega, timeStep, leftVector);
+	mRightVectorStamps = {
+		mSubInductor.get(),
+		mSubVoltageSource.get() };
 	mTimeStep = timeStep;
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	for (auto task : mSubVoltageSource->mnaTasks()) {
 		mMnaTasks.push_back(task);
 	}
@@ -268,7 +271,7 @@ void DP::Ph1::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph1::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 }
@@ -285,9 +288,7 @@ void DP::Ph1::SynchronGeneratorTrStab::MnaPreStep::execute(Real time, Int timeSt
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::AddBStep::execute(Real time, Int timeStepCount) {
-	mGenerator.mRightVector =
-		mGenerator.mSubInductor->attribute<Matrix>("right_vector")->get()
-		+ mGenerator.mSubVoltageSource->attribute<Matrix>("right_vector")->get();
+	mGenerator.mnaUpdateRightVector(mGenerator.mRightVectorStamps);
 }
 
 void DP::Ph1::SynchronGeneratorTrStab::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -312,4 +313,38 @@ void DP::Ph1::SynchronGeneratorTrStab::setReferenceOmega(Attribute<Real>::Ptr re
 	mUseOmegaRef=true;
 
 	mSLog->info("Use of reference omega.");
-}
\ No newline at end of file
+}
+
+Bool DP::Ph1::SynchronGeneratorTrStab::mnaBatchMachine(MachineBatchModel& model) {
+	if (mUseOmegaRef)
+		return false;
+
+	model.nomOmega = mNomOmega;
+	model.nomPower = mNomPower;
+	model.damping = mKd;
+	model.emfAbs = mEp_abs;
+	model.convertWithOmegaMech = mConvertWithOmegaMech;
+	model.node = terminalNotGrounded(0) ? matrixNodeIndex(0) : -1;
+	model.behaviour = &mBehaviour;
+	model.inertia = &mInertia;
+	model.mechPower = &mMechPower;
+	model.omega = &mOmMech;
+	model.delta = &mDelta_p;
+	model.elecPower = &mElecActivePower;
+	model.emf = &mEp;
+	model.voltage = &mIntfVoltage(0, 0);
+	model.current = &mIntfCurrent(0, 0);
+	model.states = &mStates;
+	model.omegaAttribute = attribute<Real>("w_r");
+	model.deltaAttribute = attribute<Real>("delta_r");
+	model.emfReference = mSubVoltageSource->attribute<Complex>("V_ref");
+	model.innerCurrent = mSubInductor->attribute<MatrixComp>("i_intf");
+
+	Task::List tasks;
+	for (auto task : mMnaTasks) {
+		if (!std::dynamic_pointer_cast<MnaPreStep>(task) && !std::dynamic_pointer_cast<MnaPostStep>(task))
+			tasks.push_back(task);
+	}
+	mMnaTasks = tasks;
+	return true;
+}
@@ -17,7 +17,7 @@ DP::Ph3::Capacitor::Capacitor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Complex>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = MatrixComp::Zero(3,1);
+	mEquivCurrent = VectorComp3::Zero();
 	mIntfVoltage = MatrixComp::Zero(3,1);
 	mIntfCurrent = MatrixComp::Zero(3,1);
 
@@ -94,7 +94,7 @@ void DP::Ph3::Capacitor::initVars(Real omega, Real timeStep) {
 		Complex(mPrevVoltCoeffReal(2, 0), mPrevVoltCoeffImag(2, 0)), Complex(mPrevVoltCoeffReal(2, 1), mPrevVoltCoeffImag(2, 1)), Complex(mPrevVoltCoeffReal(2, 2), mPrevVoltCoeffImag(2, 2));
 
 
-	mEquivCurrent = -mPrevVoltCoeff * mIntfVoltage - mIntfCurrent;
+	mEquivCurrent = -mPrevVoltCoeff * mIntfVoltage.block<3, 1>(0, 0) - mIntfCurrent.block<3, 1>(0, 0);
 }
 
 void DP::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
@@ -127,12 +127,12 @@ void DP::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	// 			<< "<" << Math::phaseDeg(mIntfCurrent(0,0)) << std::endl
 	// 			<< "--- MNA initialization finished ---" << std::endl;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -202,7 +202,7 @@ void DP::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	//mCureqr = mCurrr + mGcr * mDeltavr + mGci * mDeltavi;
 	//mCureqi = mCurri + mGcr * mDeltavi - mGci * mDeltavr;
 
-	mEquivCurrent = -mIntfCurrent + -mPrevVoltCoeff * mIntfVoltage;
+	mEquivCurrent = -mIntfCurrent.block<3, 1>(0, 0) + -mPrevVoltCoeff * mIntfVoltage.block<3, 1>(0, 0);
 
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
@@ -217,7 +217,7 @@ void DP::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 }
 
 void DP::Ph3::Capacitor::MnaPreStep::execute(Real time, Int timeStepCount) {
-	mCapacitor.mnaApplyRightSideVectorStamp(mCapacitor.mRightVector);
+	mCapacitor.mnaUpdateRightVector();
 }
 
 void DP::Ph3::Capacitor::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -241,5 +241,5 @@ void DP::Ph3::Capacitor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void DP::Ph3::Capacitor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
+	mIntfCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mEquivCurrent;
 }
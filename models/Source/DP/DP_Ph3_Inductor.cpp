@@ -15,7 +15,7 @@ DP::Ph3::Inductor::Inductor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Complex>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = MatrixComp::Zero(3,1);
+	mEquivCurrent = VectorComp3::Zero();
 	mIntfVoltage = MatrixComp::Zero(3,1);
 	mIntfCurrent = MatrixComp::Zero(3,1);
 
@@ -83,7 +83,7 @@ void DP::Ph3::Inductor::initVars(Real omega, Real timeStep) {
 
 
 	// TODO: check if this is correct or if it should be only computed before the step
-	mEquivCurrent = mEquivCond * mIntfVoltage + mPrevCurrFac * mIntfCurrent;
+	mEquivCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mPrevCurrFac * mIntfCurrent.block<3, 1>(0, 0);
 	// no need to update this now
 	//mIntfCurrent = mEquivCond.cwiseProduct(mIntfVoltage) + mEquivCurrent;
 }
@@ -99,10 +99,10 @@ void DP::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
-void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -161,7 +161,7 @@ void DP::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 void DP::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 
 	// Calculate equivalent current source for next time step
-	mEquivCurrent = mEquivCond * mIntfVoltage + mPrevCurrFac * mIntfCurrent;
+	mEquivCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mPrevCurrFac * mIntfCurrent.block<3, 1>(0, 0);
 
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
@@ -176,7 +176,7 @@ void DP::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 }
 
 void DP::Ph3::Inductor::MnaPreStep::execute(Real time, Int timeStepCount) {
-	mInductor.mnaApplyRightSideVectorStamp(mInductor.mRightVector);
+	mInductor.mnaUpdateRightVector();
 }
 
 void DP::Ph3::Inductor::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -200,7 +200,7 @@ void DP::Ph3::Inductor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void DP::Ph3::Inductor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
+	mIntfCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mEquivCurrent;
 }
 
 void DP::Ph3::Inductor::mnaTearInitialize(Real omega, Real timeStep) {
@@ -59,7 +59,7 @@ void DP::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void DP::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void DP::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 
 	//// Set diagonal entries
 	//if (terminalNotGrounded(0))
@@ -153,7 +153,7 @@ void DP::Ph3::Resistor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void DP::Ph3::Resistor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mConductance * mIntfVoltage;
+	mIntfCurrent = mConductance * mIntfVoltage.block<3, 1>(0, 0);
 
 	SPDLOG_LOGGER_DEBUG(mSLog, "Current A: {} < {}", std::abs(mIntfCurrent(0,0)), std::arg(mIntfCurrent(0,0)));
 }
@@ -23,7 +23,11 @@ void DP::Ph3::SynchronGeneratorDQTrapez::mnaInitialize(Real omega, Real timeStep
 	updateMatrixNodeIndices();
 	mTimeStep = timeStep;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mFluxStateSpace.setMethod(mNumericalMethod == NumericalMethod::Euler
+		? DiscreteStateSpace<>::Method::Euler : DiscreteStateSpace<>::Method::Trapezoidal);
+	mFluxStateSpaceOmMech = std::numeric_limits<Real>::quiet_NaN();
+
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
@@ -36,9 +40,39 @@ void DP::Ph3::SynchronGeneratorDQTrapez::mnaInitialize(Real omega, Real timeStep
 		mVdq0(0,0)/mIdq0(0,0),mVdq0(1,0)/mIdq0(1,0),mVdq0(2,0)/mIdq0(2,0));
 }
 
+Bool DP::Ph3::SynchronGeneratorDQTrapez::mnaBatchMachine(DQMachineBatchModel& model) {
+	if (mMultisamplingRate != 1 || mNumDampingWindings != 2)
+		return false;
+
+	model.trapezoidal = mNumericalMethod != NumericalMethod::Euler;
+	model.timeStep = mTimeStep;
+	model.baseOmElec = mBase_OmElec;
+	model.baseOmMech = mBase_OmMech;
+	model.baseVoltage = mBase_V;
+	model.baseCurrent = mBase_I;
+	model.fluxStateMat = &mFluxStateSpaceMat;
+	model.omegaFluxMat = &mOmegaFluxMat;
+	model.fluxToCurrentMat = &mFluxToCurrentMat;
+	for (UInt phase = 0; phase < 3; phase++)
+		model.nodes[phase] = terminalNotGrounded(0) ? static_cast<Int>(matrixNodeIndex(0, phase)) : -1;
+	model.inertia = &mInertia;
+	model.mechTorque = &mMechTorque;
+	model.omega = &mOmMech;
+	model.theta = &mThetaMech;
+	model.elecTorque = &mElecTorque;
+	model.fluxes = &mPsisr;
+	model.currents = &mIsr;
+	model.voltages = &mVsr;
+	model.voltageDq0 = &mVdq0;
+	model.currentDq0 = &mIdq0;
+	model.intfVoltage = &mIntfVoltage;
+	model.intfCurrent = &mIntfCurrent;
+	return true;
+}
+
 void DP::Ph3::SynchronGeneratorDQTrapez::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mSynGen.stepInPerUnit(time); //former system solve (trapezoidal)
-	mSynGen.mnaApplyRightSideVectorStamp(mSynGen.mRightVector);
+	mSynGen.mnaUpdateRightVector();
 }
 
 void DP::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
@@ -74,16 +108,13 @@ void DP::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	// Update of omega using Euler
 	mOmMech = mOmMech + mTimeStep * (1./(2.*mInertia) * (mMechTorque - mElecTorque));
 
-	// Update of fluxes
-	if (mNumericalMethod == NumericalMethod::Euler) {
-		mPsisr = Math::StateSpaceEuler(mPsisr,
-			mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
-			mBase_OmElec*mVsr, mTimeStep / mMultisamplingRate);
-	} else {
-		mPsisr = Math::StateSpaceTrapezoidal(mPsisr,
-			mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
-			mBase_OmElec*mVsr, mTimeStep / mMultisamplingRate);
+	// Update of fluxes, the state matrix is only refactorized if the rotor speed changed
+	if (mOmMech != mFluxStateSpaceOmMech) {
+		mFluxStateSpace.setStateMatrix(mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
+			mTimeStep / mMultisamplingRate);
+		mFluxStateSpaceOmMech = mOmMech;
 	}
+	mPsisr = mFluxStateSpace.stepWithInput(mPsisr, mBase_OmElec*mVsr);
 
 	// Calculate new currents from fluxes
 	mIsr = mFluxToCurrentMat * mPsisr;
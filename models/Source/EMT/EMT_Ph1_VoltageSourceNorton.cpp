@@ -40,12 +40,12 @@ void EMT::Ph1::VoltageSourceNorton::mnaInitialize(Real omega, Real timeStep, Att
 	updateMatrixNodeIndices();
 
 	mIntfVoltage(0, 0) = attributeComplex("V_ref")->get().real();
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph1::VoltageSourceNorton::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph1::VoltageSourceNorton::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Apply matrix stamp for equivalent resistance
 	if (terminalNotGrounded(0))
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0), matrixNodeIndex(0), mConductance);
@@ -75,7 +75,7 @@ void EMT::Ph1::VoltageSourceNorton::updateState(Real time) {
 
 void EMT::Ph1::VoltageSourceNorton::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mVoltageSource.updateState(time);
-	mVoltageSource.mnaApplyRightSideVectorStamp(mVoltageSource.mRightVector);
+	mVoltageSource.mnaUpdateRightVector();
 }
 
 void EMT::Ph1::VoltageSourceNorton::MnaPostStep::execute(Real time, Int timeStepCount) {
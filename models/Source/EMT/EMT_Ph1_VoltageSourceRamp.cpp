@@ -67,7 +67,7 @@ void EMT::Ph1::VoltageSourceRamp::mnaInitialize(Real omega, Real timeStep, Attri
 	}
 }
 
-void EMT::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph1::VoltageSourceRamp::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 }
 
@@ -161,7 +161,8 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::updateStates() {
 	newU <<
 		mOmegaN, mPref, mQref, mIntfVoltage;
 
-	newStates = Math::StateSpaceTrapezoidal(mStates, mA, mB, mTimeStep, newU, mU);
+	mStateSpace.setSystem(mA, mB, mTimeStep);
+	newStates = mStateSpace.step(mStates, newU, mU);
 
 	// update states
 	mThetaPLL = newStates(0, 0);
@@ -286,9 +287,9 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaInitialize(Real omega, Real ti
 	initializeStates(omega, timeStep, leftVector);
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
-void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Apply matrix stamp for equivalent resistance
 	if (terminalNotGrounded(0)) {
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mYc);
@@ -329,7 +330,7 @@ void EMT::Ph3::AvVoltSourceInverterStateSpace::mnaApplyRightSideVectorStamp(Matr
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mAvVoltSourceInverterStateSpace.updateEquivCurrent(time);
-	mAvVoltSourceInverterStateSpace.mnaApplyRightSideVectorStamp(mAvVoltSourceInverterStateSpace.mRightVector);
+	mAvVoltSourceInverterStateSpace.mnaUpdateRightVector();
 }
 
 void EMT::Ph3::AvVoltSourceInverterStateSpace::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -14,7 +14,7 @@ EMT::Ph3::Capacitor::Capacitor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Real>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = Matrix::Zero(3, 1);
+	mEquivCurrent = Vector3::Zero();
 	mIntfVoltage = Matrix::Zero(3, 1);
 	mIntfCurrent = Matrix::Zero(3, 1);
 
@@ -67,13 +67,13 @@ void EMT::Ph3::Capacitor::mnaInitialize(Real omega, Real timeStep, Attribute<Mat
 	// Update internal state
 	mEquivCurrent = - mIntfCurrent + - mEquivCond * mIntfVoltage;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 
 }
 
-void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -128,7 +128,7 @@ void EMT::Ph3::Capacitor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 }
 
 void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
-	mEquivCurrent = -mIntfCurrent + -mEquivCond * mIntfVoltage;
+	mEquivCurrent = -mIntfCurrent.block<3, 1>(0, 0) + -mEquivCond * mIntfVoltage.block<3, 1>(0, 0);
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -139,9 +139,10 @@ void EMT::Ph3::Capacitor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 1), -mEquivCurrent(1, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 2), -mEquivCurrent(2, 0));
 	}
-	mSLog->debug(
-		"\nEquivalent Current: {:s}",
-		Logger::matrixToString(mEquivCurrent));
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nEquivalent Current: {:s}",
+			Logger::matrixToString(mEquivCurrent));
 }
 
 void EMT::Ph3::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -152,7 +153,7 @@ void EMT::Ph3::Capacitor::mnaAddPreStepDependencies(AttributeBase::List &prevSte
 }
 
 void EMT::Ph3::Capacitor::mnaPreStep(Real time, Int timeStepCount) {
-	mnaApplyRightSideVectorStamp(mRightVector);
+	mnaUpdateRightVector();
 }
 
 void EMT::Ph3::Capacitor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -182,10 +183,11 @@ void EMT::Ph3::Capacitor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void EMT::Ph3::Capacitor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nCurrent: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
+	mIntfCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mEquivCurrent;
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nCurrent: {:s}",
+			Logger::matrixToString(mIntfCurrent)
+		);
 }
 
@@ -14,7 +14,7 @@ EMT::Ph3::Inductor::Inductor(String uid, String name, Logger::Level logLevel)
 	: SimPowerComp<Real>(uid, name, logLevel) {
 	mPhaseType = PhaseType::ABC;
 	setTerminalNumber(2);
-	mEquivCurrent = Matrix::Zero(3, 1);
+	mEquivCurrent = Vector3::Zero();
 	mIntfVoltage = Matrix::Zero(3, 1);
 	mIntfCurrent = Matrix::Zero(3, 1);
 
@@ -71,7 +71,7 @@ void EMT::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 
 	mSLog->info(
 		"\n--- MNA initialization ---"
@@ -85,7 +85,7 @@ void EMT::Ph3::Inductor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	mSLog->flush();
 }
 
-void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mEquivCond(0, 0));
@@ -141,7 +141,7 @@ void EMT::Ph3::Inductor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
 
 void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 	// Update internal state
-	mEquivCurrent = mEquivCond * mIntfVoltage + mIntfCurrent;
+	mEquivCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mIntfCurrent.block<3, 1>(0, 0);
 	if (terminalNotGrounded(0)) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 0), mEquivCurrent(0, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(0, 1), mEquivCurrent(1, 0));
@@ -152,10 +152,12 @@ void EMT::Ph3::Inductor::mnaApplyRightSideVectorStamp(Matrix& rightVector) {
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 1), -mEquivCurrent(1, 0));
 		Math::setVectorElement(rightVector, matrixNodeIndex(1, 2), -mEquivCurrent(2, 0));
 	}
-	mSLog->debug(
-		"\nEquivalent Current (mnaApplyRightSideVectorStamp): {:s}",
-		Logger::matrixToString(mEquivCurrent));
-	mSLog->flush();
+	if (mSLog->should_log(spdlog::level::debug)) {
+		mSLog->debug(
+			"\nEquivalent Current (mnaApplyRightSideVectorStamp): {:s}",
+			Logger::matrixToString(mEquivCurrent));
+		mSLog->flush();
+	}
 }
 
 void EMT::Ph3::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes) {
@@ -166,7 +168,7 @@ void EMT::Ph3::Inductor::mnaAddPreStepDependencies(AttributeBase::List &prevStep
 }
 
 void EMT::Ph3::Inductor::mnaPreStep(Real time, Int timeStepCount) {
-	mnaApplyRightSideVectorStamp(mRightVector);
+	mnaUpdateRightVector();
 }
 
 void EMT::Ph3::Inductor::mnaAddPostStepDependencies(AttributeBase::List &prevStepDependencies, AttributeBase::List &attributeDependencies, AttributeBase::List &modifiedAttributes, Attribute<Matrix>::Ptr &leftVector) {
@@ -193,18 +195,21 @@ void EMT::Ph3::Inductor::mnaUpdateVoltage(const Matrix& leftVector) {
 		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
 		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
 	}
-	mSLog->debug(
-		"\nUpdate Voltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
+	if (mSLog->should_log(spdlog::level::debug))
+		mSLog->debug(
+			"\nUpdate Voltage: {:s}",
+			Logger::matrixToString(mIntfVoltage)
+		);
 }
 
 void EMT::Ph3::Inductor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mEquivCond * mIntfVoltage + mEquivCurrent;
-	mSLog->debug(
-		"\nUpdate Current: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
-	mSLog->flush();
+	mIntfCurrent = mEquivCond * mIntfVoltage.block<3, 1>(0, 0) + mEquivCurrent;
+	if (mSLog->should_log(spdlog::level::debug)) {
+		mSLog->debug(
+			"\nUpdate Current: {:s}",
+			Logger::matrixToString(mIntfCurrent)
+		);
+		mSLog->flush();
+	}
 }
 
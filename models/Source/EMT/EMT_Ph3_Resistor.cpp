@@ -61,7 +61,7 @@ void EMT::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matr
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Set diagonal entries
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
@@ -141,18 +141,22 @@ void EMT::Ph3::Resistor::mnaUpdateVoltage(const Matrix& leftVector) {
 		mIntfVoltage(1, 0) = mIntfVoltage(1, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 1));
 		mIntfVoltage(2, 0) = mIntfVoltage(2, 0) - Math::realFromVectorElement(leftVector, matrixNodeIndex(0, 2));
 	}
-	mSLog->debug(
-		"\nVoltage: {:s}",
-		Logger::matrixToString(mIntfVoltage)
-	);
-	mSLog->flush();
+	if (mSLog->should_log(spdlog::level::debug)) {
+		mSLog->debug(
+			"\nVoltage: {:s}",
+			Logger::matrixToString(mIntfVoltage)
+		);
+		mSLog->flush();
+	}
 }
 
 void EMT::Ph3::Resistor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mConductance * mIntfVoltage;
-	mSLog->debug(
-		"\nCurrent: {:s}",
-		Logger::matrixToString(mIntfCurrent)
-	);
-	mSLog->flush();
+	mIntfCurrent = mConductance * mIntfVoltage.block<3, 1>(0, 0);
+	if (mSLog->should_log(spdlog::level::debug)) {
+		mSLog->debug(
+			"\nCurrent: {:s}",
+			Logger::matrixToString(mIntfCurrent)
+		);
+		mSLog->flush();
+	}
 }
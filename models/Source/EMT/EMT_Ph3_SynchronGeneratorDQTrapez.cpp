@@ -28,14 +28,18 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::mnaInitialize(Real omega, Real timeSte
 	updateMatrixNodeIndices();
 	mTimeStep = timeStep;
 
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mFluxStateSpace.setMethod(mNumericalMethod == NumericalMethod::Euler
+		? DiscreteStateSpace<>::Method::Euler : DiscreteStateSpace<>::Method::Trapezoidal);
+	mFluxStateSpaceOmMech = std::numeric_limits<Real>::quiet_NaN();
+
+	mnaInitializeRightVector(leftVector->get().rows());
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
 void EMT::Ph3::SynchronGeneratorDQTrapez::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mSynGen.stepInPerUnit(time); //former system solve (trapezoidal)
-	mSynGen.mnaApplyRightSideVectorStamp(mSynGen.mRightVector);
+	mSynGen.mnaUpdateRightVector();
 }
 
 void EMT::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
@@ -73,11 +77,13 @@ void EMT::Ph3::SynchronGeneratorDQTrapez::stepInPerUnit(Real time) {
 	// Update using euler
 	mDelta = mDelta + mTimeStep * (mOmMech - 1);
 
-	// Update of fluxes
-	if (mNumericalMethod == NumericalMethod::Euler)
-		mPsisr = Math::StateSpaceEuler(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
-	else
-		mPsisr = Math::StateSpaceTrapezoidal(mPsisr, mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech), mBase_OmElec*mVsr, mTimeStep);
+	// Update of fluxes, the state matrix is only refactorized if the rotor speed changed
+	if (mOmMech != mFluxStateSpaceOmMech) {
+		mFluxStateSpace.setStateMatrix(mBase_OmElec*(mFluxStateSpaceMat + mOmegaFluxMat*mOmMech),
+			mTimeStep);
+		mFluxStateSpaceOmMech = mOmMech;
+	}
+	mPsisr = mFluxStateSpace.stepWithInput(mPsisr, mBase_OmElec*mVsr);
 
 	// Calculate new currents from fluxes
 	mIsr = mFluxToCurrentMat * mPsisr;
@@ -250,8 +250,11 @@ void EMT::Ph3::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 
 	mSubVoltageSource->mnaInitialize(omega, timeStep, leftVector);
 	mSubInductor->mnaInitialize(omega, timeStep, leftVector);
+	mRightVectorStamps = {
+		mSubInductor.get(),
+		mSubVoltageSource.get() };
 	mTimeStep = timeStep;
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 	for (auto task : mSubVoltageSource->mnaTasks()) {
 		mMnaTasks.push_back(task);
 	}
@@ -263,7 +266,7 @@ void EMT::Ph3::SynchronGeneratorTrStab::mnaInitialize(Real omega, Real timeStep,
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void EMT::Ph3::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::SynchronGeneratorTrStab::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	mSubVoltageSource->mnaApplySystemMatrixStamp(systemMatrix);
 	mSubInductor->mnaApplySystemMatrixStamp(systemMatrix);
 }
@@ -282,9 +285,7 @@ void EMT::Ph3::SynchronGeneratorTrStab::MnaPreStep::execute(Real time, Int timeS
 }
 
 void EMT::Ph3::SynchronGeneratorTrStab::AddBStep::execute(Real time, Int timeStepCount) {
-	mGenerator.mRightVector =
-		mGenerator.mSubInductor->attribute<Matrix>("right_vector")->get()
-		+ mGenerator.mSubVoltageSource->attribute<Matrix>("right_vector")->get();
+	mGenerator.mnaUpdateRightVector(mGenerator.mRightVectorStamps);
 }
 
 void EMT::Ph3::SynchronGeneratorTrStab::MnaPostStep::execute(Real time, Int timeStepCount) {
@@ -47,10 +47,10 @@ void EMT::Ph3::VoltageSourceNorton::mnaInitialize(Real omega, Real timeStep, Att
 
 	mMnaTasks.push_back(std::make_shared<MnaPreStep>(*this));
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
-	mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
+	mnaInitializeRightVector(leftVector->get().rows());
 }
 
-void EMT::Ph3::VoltageSourceNorton::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void EMT::Ph3::VoltageSourceNorton::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	// Apply matrix stamp for equivalent resistance
 	if (terminalNotGrounded(0)){
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), mConductance);
@@ -96,7 +96,7 @@ void EMT::Ph3::VoltageSourceNorton::updateState(Real time) {
 		mIntfVoltage(2, 0) = Math::abs(mVoltageRef) * cos(2. * PI * mSrcFreq * time + Math::phase(mVoltageRef) + 2. / 3. * M_PI);
 	}
 
-	mEquivCurrent = mIntfVoltage / mResistance;
+	mEquivCurrent = mIntfVoltage.block<3, 1>(0, 0) / mResistance;
 }
 
 
@@ -116,7 +116,7 @@ void EMT::Ph3::VoltageSourceNorton::mnaUpdateVoltage(const Matrix& leftVector) {
 
 void EMT::Ph3::VoltageSourceNorton::MnaPreStep::execute(Real time, Int timeStepCount) {
 	mVoltageSourceNorton.updateState(time);
-	mVoltageSourceNorton.mnaApplyRightSideVectorStamp(mVoltageSourceNorton.mRightVector);
+	mVoltageSourceNorton.mnaUpdateRightVector();
 }
 
 void EMT::Ph3::VoltageSourceNorton::MnaPostStep::execute(Real time, Int timeStepCount) {
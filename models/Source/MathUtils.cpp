@@ -10,37 +10,37 @@
 
 using namespace CPS;
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u_new, Matrix u_old) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u_new, const Matrix& u_old) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
 	Matrix F1 = I + (dt/2.) * A;
 	Matrix F2 = I - (dt/2.) * A;
-	Matrix F2inv = F2.inverse();
+	Eigen::PartialPivLU<Matrix> F2lu = F2.partialPivLu();
 
-	return F2inv*F1*states + F2inv*(dt/2.) * B*(u_new + u_old);
+	return F2lu.solve(F1*states + (dt/2.) * B*(u_new + u_old));
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u_new, Matrix u_old) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u_new, const Matrix& u_old) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
 	Matrix F1 = I + (dt/2.) * A;
 	Matrix F2 = I - (dt/2.) * A;
-	Matrix F2inv = F2.inverse();
+	Eigen::PartialPivLU<Matrix> F2lu = F2.partialPivLu();
 
-	return F2inv*F1*states + F2inv*(dt/2.) * B*(u_new + u_old) + F2inv*dt*C;
+	return F2lu.solve(F1*states + (dt/2.) * B*(u_new + u_old) + dt*C);
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
 	Matrix F1 = I + (dt/2.) * A;
 	Matrix F2 = I - (dt/2.) * A;
-	Matrix F2inv = F2.inverse();
+	Eigen::PartialPivLU<Matrix> F2lu = F2.partialPivLu();
 
-	return F2inv*F1*states + F2inv*dt*B*u + F2inv*dt*C;
+	return F2lu.solve(F1*states + dt*B*u + dt*C);
 }
 
 Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, Real u) {
@@ -51,26 +51,26 @@ Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real C, Real dt, R
 	return F2inv*F1*states + F2inv*dt*B*u + F2inv*dt*C;
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix B, Real dt, Matrix u) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
 	Matrix F1 = I + (dt/2.) * A;
 	Matrix F2 = I - (dt/2.) * A;
-	Matrix F2inv = F2.inverse();
+	Eigen::PartialPivLU<Matrix> F2lu = F2.partialPivLu();
 
-	return F2inv * F1*states + F2inv * dt*B*u;
+	return F2lu.solve(F1*states + dt*B*u);
 }
 
-Matrix Math::StateSpaceTrapezoidal(Matrix states, Matrix A, Matrix input, Real dt) {
+Matrix Math::StateSpaceTrapezoidal(const Matrix& states, const Matrix& A, const Matrix& input, Real dt) {
 	Matrix::Index n = states.rows();
 	Matrix I = Matrix::Identity(n, n);
 
 	Matrix F1 = I + (dt/2.) * A;
 	Matrix F2 = I - (dt/2.) * A;
-	Matrix F2inv = F2.inverse();
+	Eigen::PartialPivLU<Matrix> F2lu = F2.partialPivLu();
 
-	return F2inv*F1*states + F2inv*dt*input;
+	return F2lu.solve(F1*states + dt*input);
 }
 
 Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u) {
@@ -81,7 +81,7 @@ Real Math::StateSpaceTrapezoidal(Real states, Real A, Real B, Real dt, Real u) {
 	return F2inv * F1*states + F2inv * dt*B*u;
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Real dt, Matrix u) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, Real dt, const Matrix& u) {
 	return states + dt * ( A*states + B*u );
 }
 
@@ -89,7 +89,7 @@ Real Math::StateSpaceEuler(Real states, Real A, Real B, Real dt, Real u) {
 	return states + dt * ( A*states + B*u );
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix B, Matrix C, Real dt, Matrix u) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& B, const Matrix& C, Real dt, const Matrix& u) {
 	return states + dt * ( A*states + B*u + C );
 }
 
@@ -97,7 +97,7 @@ Real Math::StateSpaceEuler(Real states, Real A, Real B, Real C, Real dt, Real u)
 	return states + dt * ( A*states + B*u + C );
 }
 
-Matrix Math::StateSpaceEuler(Matrix states, Matrix A, Matrix input, Real dt) {
+Matrix Math::StateSpaceEuler(const Matrix& states, const Matrix& A, const Matrix& input, Real dt) {
 	return states + dt * ( A*states + input );
 }
 
@@ -101,7 +101,7 @@ void SP::Ph1::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 		Logger::phasorToString(mIntfCurrent(0, 0)));
 }
 
-void SP::Ph1::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph1::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	Complex conductance = Complex(1. / mResistance, 0);
 
 	for (UInt freq = 0; freq < mNumFreqs; freq++) {
@@ -53,7 +53,7 @@ void SP::Ph3::Resistor::mnaInitialize(Real omega, Real timeStep, Attribute<Matri
 	mMnaTasks.push_back(std::make_shared<MnaPostStep>(*this, leftVector));
 }
 
-void SP::Ph3::Resistor::mnaApplySystemMatrixStamp(Matrix& systemMatrix) {
+void SP::Ph3::Resistor::mnaApplySystemMatrixStamp(SparseMatrixRow& systemMatrix) {
 	if (terminalNotGrounded(0)) {
 		// set upper left block, 3x3 entries
 		Math::addToMatrixElement(systemMatrix, matrixNodeIndex(0, 0), matrixNodeIndex(0, 0), Complex( mConductance(0, 0), 0));
@@ -137,7 +137,7 @@ void SP::Ph3::Resistor::mnaUpdateVoltage(const Matrix& leftVector) {
 }
 
 void SP::Ph3::Resistor::mnaUpdateCurrent(const Matrix& leftVector) {
-	mIntfCurrent = mConductance * mIntfVoltage;
+	mIntfCurrent = mConductance * mIntfVoltage.block<3, 1>(0, 0);
 	//mLog.debug() << "Current A: " << std::abs(mIntfCurrent(0, 0))
 	//	<< "<" << std::arg(mIntfCurrent(0, 0)) << std::endl;
 }
@@ -9,6 +9,8 @@
 #include "cps/Definitions.h"
 #include <cps/Signal/DecouplingLine.h>
 
+#include <thread>
+
 using namespace CPS;
 using namespace CPS::DP::Ph1;
 using namespace CPS::Signal;
@@ -106,65 +108,96 @@ void DecouplingLine::initialize(Real omega, Real timeStep) {
 	mSLog->info("initial currents: i_km {} i_mk {}", cur1, cur2);
 
 	// Resize ring buffers and initialize
-	mVolt1.resize(mBufSize, volt1);
-	mVolt2.resize(mBufSize, volt2);
-	mCur1.resize(mBufSize, cur1);
-	mCur2.resize(mBufSize, cur2);
+	mVolt1.assign(2 * mBufSize, volt1);
+	mVolt2.assign(2 * mBufSize, volt2);
+	mCur1.assign(2 * mBufSize, cur1);
+	mCur2.assign(2 * mBufSize, cur2);
+
+	for (UInt side = 0; side < 2; side++) {
+		mPreStepsDone[side] = 0;
+		mPostStepsDone[side] = 0;
+	}
+}
+
+UInt DecouplingLine::bufferSlot(Int timeStepCount) const {
+	Int size = static_cast<Int>(mVolt1.size());
+	return static_cast<UInt>((timeStepCount % size + size) % size);
 }
 
-Complex DecouplingLine::interpolate(std::vector<Complex>& data) {
+Complex DecouplingLine::interpolate(std::vector<Complex>& data, Int timeStepCount) {
 	// linear interpolation of the nearest values
-	Complex c1 = data[mBufIdx];
-	Complex c2 = mBufIdx == mBufSize-1 ? data[0] : data[mBufIdx+1];
+	Int delayed = timeStepCount - static_cast<Int>(mBufSize);
+	Complex c1 = data[bufferSlot(delayed)];
+	Complex c2 = mBufSize > 1 ? data[bufferSlot(delayed + 1)] : c1;
 	return mAlpha * c1 + (1-mAlpha) * c2;
 }
 
-void DecouplingLine::step(Real time, Int timeStepCount) {
-	Complex volt1 = interpolate(mVolt1);
-	Complex volt2 = interpolate(mVolt2);
-	Complex cur1 = interpolate(mCur1);
-	Complex cur2 = interpolate(mCur2);
+void DecouplingLine::waitForSteps(const std::atomic<Int>& stepsDone, Int steps) {
+	while (stepsDone.load(std::memory_order_acquire) < steps)
+		std::this_thread::yield();
+}
+
+void DecouplingLine::step(Real time, Int timeStepCount, UInt side) {
+	UInt other = 1 - side;
+	// The interpolation reads the values of the other side up to this step
+	Int delayed = timeStepCount - static_cast<Int>(mBufSize) + (mBufSize > 1 ? 1 : 0);
+	waitForSteps(mPostStepsDone[other], delayed + 1);
 
+	Complex volt = interpolate(side == 0 ? mVolt1 : mVolt2, timeStepCount);
+	Complex cur = interpolate(side == 0 ? mCur1 : mCur2, timeStepCount);
+	Complex voltOther = interpolate(side == 0 ? mVolt2 : mVolt1, timeStepCount);
+	Complex curOther = interpolate(side == 0 ? mCur2 : mCur1, timeStepCount);
+
+	Complex srcCurRef;
 	if (timeStepCount == 0) {
 		// bit of a hack for proper initialization
-		mSrcCur1Ref = cur1 - volt1 / (mSurgeImpedance + mResistance / 4);
-		mSrcCur2Ref = cur2 - volt2 / (mSurgeImpedance + mResistance / 4);
+		srcCurRef = cur - volt / (mSurgeImpedance + mResistance / 4);
 	} else {
 		// Update currents
 		Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
-		mSrcCur1Ref = -mSurgeImpedance / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2)
-			- mResistance/4 / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1);
-		mSrcCur2Ref = -mSurgeImpedance / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1)
-			- mResistance/4 / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2);
-		mSrcCur1Ref = mSrcCur1Ref * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
-		mSrcCur2Ref = mSrcCur2Ref * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
+		srcCurRef = -mSurgeImpedance / denom * (voltOther + (mSurgeImpedance - mResistance/4) * curOther)
+			- mResistance/4 / denom * (volt + (mSurgeImpedance - mResistance/4) * cur);
+		srcCurRef = srcCurRef * Complex(cos(-2.*PI*50*mDelay),sin(-2.*PI*50*mDelay));
+	}
+	if (side == 0) {
+		mSrcCur1Ref = srcCurRef;
+		mSrcCur1->set(mSrcCur1Ref);
+	} else {
+		mSrcCur2Ref = srcCurRef;
+		mSrcCur2->set(mSrcCur2Ref);
 	}
-	mSrcCur1->set(mSrcCur1Ref);
-	mSrcCur2->set(mSrcCur2Ref);
+	mPreStepsDone[side].store(timeStepCount + 1, std::memory_order_release);
 }
 
 void DecouplingLine::PreStep::execute(Real time, Int timeStepCount) {
-	mLine.step(time, timeStepCount);
+	mLine.step(time, timeStepCount, mSide);
 }
 
-void DecouplingLine::postStep() {
+void DecouplingLine::postStep(Int timeStepCount, UInt side) {
+	// The slot may only be overwritten after the other side has read it
+	UInt other = 1 - side;
+	waitForSteps(mPreStepsDone[other], timeStepCount - static_cast<Int>(mBufSize) + 1);
+
 	// Update ringbuffers with new values
-	mVolt1[mBufIdx] = -mRes1->intfVoltage()(0, 0);
-	mVolt2[mBufIdx] = -mRes2->intfVoltage()(0, 0);
-	mCur1[mBufIdx] = -mRes1->intfCurrent()(0, 0) + mSrcCur1->get();
-	mCur2[mBufIdx] = -mRes2->intfCurrent()(0, 0) + mSrcCur2->get();
-
-	mBufIdx++;
-	if (mBufIdx == mBufSize)
-		mBufIdx = 0;
+	UInt slot = bufferSlot(timeStepCount);
+	if (side == 0) {
+		mVolt1[slot] = -mRes1->intfVoltage()(0, 0);
+		mCur1[slot] = -mRes1->intfCurrent()(0, 0) + mSrcCur1->get();
+	} else {
+		mVolt2[slot] = -mRes2->intfVoltage()(0, 0);
+		mCur2[slot] = -mRes2->intfCurrent()(0, 0) + mSrcCur2->get();
+	}
+	mPostStepsDone[side].store(timeStepCount + 1, std::memory_order_release);
 }
 
 void DecouplingLine::PostStep::execute(Real time, Int timeStepCount) {
-	mLine.postStep();
+	mLine.postStep(timeStepCount, mSide);
 }
 
 Task::List DecouplingLine::getTasks() {
-	return Task::List({std::make_shared<PreStep>(*this), std::make_shared<PostStep>(*this)});
+	return Task::List({
+		std::make_shared<PreStep>(*this, 0), std::make_shared<PreStep>(*this, 1),
+		std::make_shared<PostStep>(*this, 0), std::make_shared<PostStep>(*this, 1)});
 }
 
 IdentifiedObject::List DecouplingLine::getLineComponents() {
@@ -8,6 +8,8 @@
 
 #include <cps/Signal/DecouplingLineEMT.h>
 
+#include <thread>
+
 using namespace CPS;
 using namespace CPS::EMT::Ph1;
 using namespace CPS::Signal;
@@ -70,63 +72,95 @@ void DecouplingLineEMT::initialize(Real omega, Real timeStep) {
 	mSLog->info("initial currents: i_km {} i_mk {}", cur1, cur2);
 
 	// Resize ring buffers and initialize
-	mVolt1.resize(mBufSize, volt1.real());
-	mVolt2.resize(mBufSize, volt2.real());
-	mCur1.resize(mBufSize, cur1.real());
-	mCur2.resize(mBufSize, cur2.real());
+	mVolt1.assign(2 * mBufSize, volt1.real());
+	mVolt2.assign(2 * mBufSize, volt2.real());
+	mCur1.assign(2 * mBufSize, cur1.real());
+	mCur2.assign(2 * mBufSize, cur2.real());
+
+	for (UInt side = 0; side < 2; side++) {
+		mPreStepsDone[side] = 0;
+		mPostStepsDone[side] = 0;
+	}
+}
+
+UInt DecouplingLineEMT::bufferSlot(Int timeStepCount) const {
+	Int size = static_cast<Int>(mVolt1.size());
+	return static_cast<UInt>((timeStepCount % size + size) % size);
 }
 
-Real DecouplingLineEMT::interpolate(std::vector<Real>& data) {
+Real DecouplingLineEMT::interpolate(std::vector<Real>& data, Int timeStepCount) {
 	// linear interpolation of the nearest values
-	Real c1 = data[mBufIdx];
-	Real c2 = mBufIdx == mBufSize-1 ? data[0] : data[mBufIdx+1];
+	Int delayed = timeStepCount - static_cast<Int>(mBufSize);
+	Real c1 = data[bufferSlot(delayed)];
+	Real c2 = mBufSize > 1 ? data[bufferSlot(delayed + 1)] : c1;
 	return mAlpha * c1 + (1-mAlpha) * c2;
 }
 
-void DecouplingLineEMT::step(Real time, Int timeStepCount) {
-	Real volt1 = interpolate(mVolt1);
-	Real volt2 = interpolate(mVolt2);
-	Real cur1 = interpolate(mCur1);
-	Real cur2 = interpolate(mCur2);
+void DecouplingLineEMT::waitForSteps(const std::atomic<Int>& stepsDone, Int steps) {
+	while (stepsDone.load(std::memory_order_acquire) < steps)
+		std::this_thread::yield();
+}
+
+void DecouplingLineEMT::step(Real time, Int timeStepCount, UInt side) {
+	UInt other = 1 - side;
+	// The interpolation reads the values of the other side up to this step
+	Int delayed = timeStepCount - static_cast<Int>(mBufSize) + (mBufSize > 1 ? 1 : 0);
+	waitForSteps(mPostStepsDone[other], delayed + 1);
+
+	Real volt = interpolate(side == 0 ? mVolt1 : mVolt2, timeStepCount);
+	Real cur = interpolate(side == 0 ? mCur1 : mCur2, timeStepCount);
+	Real voltOther = interpolate(side == 0 ? mVolt2 : mVolt1, timeStepCount);
+	Real curOther = interpolate(side == 0 ? mCur2 : mCur1, timeStepCount);
 	Real denom = (mSurgeImpedance + mResistance/4) * (mSurgeImpedance + mResistance/4);
 
+	Real srcCurRef;
 	if (timeStepCount == 0) {
 		// initialization
-		mSrcCur1Ref = cur1 - volt1 / (mSurgeImpedance + mResistance / 4);
-		mSrcCur2Ref = cur2 - volt2 / (mSurgeImpedance + mResistance / 4);
+		srcCurRef = cur - volt / (mSurgeImpedance + mResistance / 4);
 	} else {
 		// Update currents
-		mSrcCur1Ref = -mSurgeImpedance / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2)
-			-mResistance/4 / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1);
-		mSrcCur2Ref = -mSurgeImpedance / denom * (volt1 + (mSurgeImpedance - mResistance/4) * cur1)
-			-mResistance/4 / denom * (volt2 + (mSurgeImpedance - mResistance/4) * cur2);
+		srcCurRef = -mSurgeImpedance / denom * (voltOther + (mSurgeImpedance - mResistance/4) * curOther)
+			-mResistance/4 / denom * (volt + (mSurgeImpedance - mResistance/4) * cur);
+	}
+	if (side == 0) {
+		mSrcCur1Ref = srcCurRef;
+		mSrcCur1->set(mSrcCur1Ref);
+	} else {
+		mSrcCur2Ref = srcCurRef;
+		mSrcCur2->set(mSrcCur2Ref);
 	}
-	mSrcCur1->set(mSrcCur1Ref);
-	mSrcCur2->set(mSrcCur2Ref);
+	mPreStepsDone[side].store(timeStepCount + 1, std::memory_order_release);
 }
 
 void DecouplingLineEMT::PreStep::execute(Real time, Int timeStepCount) {
-	mLine.step(time, timeStepCount);
+	mLine.step(time, timeStepCount, mSide);
 }
 
-void DecouplingLineEMT::postStep() {
+void DecouplingLineEMT::postStep(Int timeStepCount, UInt side) {
+	// The slot may only be overwritten after the other side has read it
+	UInt other = 1 - side;
+	waitForSteps(mPreStepsDone[other], timeStepCount - static_cast<Int>(mBufSize) + 1);
+
 	// Update ringbuffers with new values
-	mVolt1[mBufIdx] = -mRes1->intfVoltage()(0,0);
-	mVolt2[mBufIdx] = -mRes2->intfVoltage()(0,0);
-	mCur1[mBufIdx] = -mRes1->intfCurrent()(0,0) + mSrcCur1->get().real();
-	mCur2[mBufIdx] = -mRes2->intfCurrent()(0,0) + mSrcCur2->get().real();
-
-	mBufIdx++;
-	if (mBufIdx == mBufSize)
-		mBufIdx = 0;
+	UInt slot = bufferSlot(timeStepCount);
+	if (side == 0) {
+		mVolt1[slot] = -mRes1->intfVoltage()(0,0);
+		mCur1[slot] = -mRes1->intfCurrent()(0,0) + mSrcCur1->get().real();
+	} else {
+		mVolt2[slot] = -mRes2->intfVoltage()(0,0);
+		mCur2[slot] = -mRes2->intfCurrent()(0,0) + mSrcCur2->get().real();
+	}
+	mPostStepsDone[side].store(timeStepCount + 1, std::memory_order_release);
 }
 
 void DecouplingLineEMT::PostStep::execute(Real time, Int timeStepCount) {
-	mLine.postStep();
+	mLine.postStep(timeStepCount, mSide);
 }
 
 Task::List DecouplingLineEMT::getTasks() {
-	return Task::List({std::make_shared<PreStep>(*this), std::make_shared<PostStep>(*this)});
+	return Task::List({
+		std::make_shared<PreStep>(*this, 0), std::make_shared<PreStep>(*this, 1),
+		std::make_shared<PostStep>(*this, 0), std::make_shared<PostStep>(*this, 1)});
 }
 
 IdentifiedObject::List DecouplingLineEMT::getLineComponents() {
@@ -92,7 +92,8 @@ void PLL::signalStep(Real time, Int timeStepCount) {
     mSLog->info("Time {}:", time);
     mSLog->info("Input values: inputCurr = ({}, {}), inputPrev = ({}, {}), stateCurr = ({}, {}), statePrev = ({}, {})", mInputCurr(0,0), mInputCurr(1,0), mInputPrev(0,0), mInputPrev(1,0), mStateCurr(0,0), mStateCurr(1,0), mStatePrev(0,0), mStatePrev(1,0));
 
-    mStateCurr = Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev);
+    mStateSpace.setSystem(mA, mB, mTimeStep);
+    mStateCurr = mStateSpace.step(mStatePrev, mInputCurr, mInputPrev);
     mOutputCurr = mC * mStateCurr + mD * mInputCurr;
 
     mSLog->info("State values: stateCurr = ({}, {})", mStateCurr(0,0), mStateCurr(1,0));
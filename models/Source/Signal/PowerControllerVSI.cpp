@@ -160,7 +160,8 @@ void PowerControllerVSI::signalStep(Real time, Int timeStepCount) {
     mSLog->debug("Time {}\n: inputCurr = \n{}\n , inputPrev = \n{}\n , statePrev = \n{}", time, mInputCurr, mInputPrev, mStatePrev);
 
 	// calculate new states
-	mStateCurr = Math::StateSpaceTrapezoidal(mStatePrev, mA, mB, mTimeStep, mInputCurr, mInputPrev);
+	mStateSpace.setSystem(mA, mB, mTimeStep);
+	mStateCurr = mStateSpace.step(mStatePrev, mInputCurr, mInputPrev);
 	mSLog->debug("stateCurr = \n {}", mStateCurr);
 
 	// calculate new outputs
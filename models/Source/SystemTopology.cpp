@@ -9,12 +9,161 @@
 #include <iostream>
 #include <iomanip>
 #include <fstream>
+#include <deque>
+#include <functional>
+#include <map>
+#include <numeric>
 #include <unordered_map>
 
 #include <cps/SystemTopology.h>
+#include <cps/Solver/MNATearInterface.h>
 
 using namespace CPS;
 
+namespace {
+	/// Network graph for the tearing, where nodes that must not be separated
+	/// are contracted into a single vertex
+	struct TearGraph {
+		/// Number of network nodes of each vertex
+		std::vector<UInt> weights;
+		/// Neighbours and number of tearable components to each neighbour
+		std::vector<std::vector<std::pair<UInt, UInt>>> adjacency;
+		/// Vertices with a component connected to ground
+		std::vector<bool> grounded;
+
+		void partition(const std::vector<UInt>& vertices, UInt parts, UInt firstLabel, std::vector<UInt>& labels) const;
+		void groundParts(std::vector<UInt>& labels) const;
+	};
+
+	/// Recursively bisects the vertices and assigns the labels firstLabel to firstLabel + parts - 1
+	void TearGraph::partition(const std::vector<UInt>& vertices, UInt parts, UInt firstLabel, std::vector<UInt>& labels) const {
+		if (parts == 1 || vertices.size() < 2) {
+			for (auto v : vertices)
+				labels[v] = firstLabel;
+			return;
+		}
+
+		UInt partsA = parts / 2;
+		UInt total = 0, maxWeight = 0;
+		for (auto v : vertices) {
+			total += weights[v];
+			maxWeight = std::max(maxWeight, weights[v]);
+		}
+		Real target = static_cast<Real>(total) * partsA / parts;
+
+		std::vector<char> inSet(weights.size(), 0), sideA(weights.size(), 0);
+		for (auto v : vertices)
+			inSet[v] = 1;
+
+		// Breadth-first order, continuing with unvisited vertices of disconnected sets
+		std::vector<UInt> order;
+		auto bfs = [&](UInt start) {
+			std::vector<char> visited(weights.size(), 0);
+			order.clear();
+			std::deque<UInt> queue;
+			for (UInt next = 0; order.size() < vertices.size(); next++) {
+				UInt root = next == 0 ? start : vertices[next - 1];
+				if (visited[root])
+					continue;
+				visited[root] = 1;
+				queue.push_back(root);
+				while (!queue.empty()) {
+					UInt v = queue.front();
+					queue.pop_front();
+					order.push_back(v);
+					for (auto& edge : adjacency[v]) {
+						if (inSet[edge.first] && !visited[edge.first]) {
+							visited[edge.first] = 1;
+							queue.push_back(edge.first);
+						}
+					}
+				}
+			}
+		};
+		// The last vertex of a search approximates a peripheral vertex
+		bfs(vertices[0]);
+		bfs(order.back());
+
+		Real weightA = 0;
+		for (auto v : order) {
+			if (weightA >= target)
+				break;
+			sideA[v] = 1;
+			weightA += weights[v];
+		}
+
+		// Move vertices that reduce the cut as long as the balance is kept
+		Real tolerance = std::max(0.05 * total, static_cast<Real>(maxWeight));
+		for (Int pass = 0; pass < 10; pass++) {
+			Bool moved = false;
+			for (auto v : vertices) {
+				Int gain = 0;
+				for (auto& edge : adjacency[v]) {
+					if (inSet[edge.first])
+						gain += sideA[edge.first] != sideA[v] ? edge.second : -static_cast<Int>(edge.second);
+				}
+				if (gain <= 0)
+					continue;
+				Real newWeightA = sideA[v] ? weightA - weights[v] : weightA + weights[v];
+				if (std::abs(newWeightA - target) > tolerance)
+					continue;
+				sideA[v] = !sideA[v];
+				weightA = newWeightA;
+				moved = true;
+			}
+			if (!moved)
+				break;
+		}
+
+		std::vector<UInt> verticesA, verticesB;
+		for (auto v : vertices)
+			(sideA[v] ? verticesA : verticesB).push_back(v);
+		partition(verticesA, partsA, firstLabel, labels);
+		partition(verticesB, parts - partsA, firstLabel + partsA, labels);
+	}
+
+	/// Merges connected pieces of the parts without connection to ground into
+	/// the neighbouring part they share the most tearable components with
+	void TearGraph::groundParts(std::vector<UInt>& labels) const {
+		const UInt n = static_cast<UInt>(weights.size());
+		Bool merged = true;
+		while (merged) {
+			merged = false;
+			std::vector<char> visited(n, 0);
+			for (UInt start = 0; start < n && !merged; start++) {
+				if (visited[start])
+					continue;
+				std::vector<UInt> piece = { start };
+				visited[start] = 1;
+				Bool pieceGrounded = false;
+				std::map<UInt, UInt> neighbourLabels;
+				for (size_t i = 0; i < piece.size(); i++) {
+					UInt v = piece[i];
+					pieceGrounded = pieceGrounded || grounded[v];
+					for (auto& edge : adjacency[v]) {
+						if (labels[edge.first] != labels[v])
+							neighbourLabels[labels[edge.first]] += edge.second;
+						else if (!visited[edge.first]) {
+							visited[edge.first] = 1;
+							piece.push_back(edge.first);
+						}
+					}
+				}
+				if (pieceGrounded || neighbourLabels.empty())
+					continue;
+
+				auto best = std::max_element(neighbourLabels.begin(), neighbourLabels.end(),
+					[](const std::pair<const UInt, UInt>& a, const std::pair<const UInt, UInt>& b) {
+						return a.second < b.second;
+					});
+				for (auto v : piece)
+					labels[v] = best->first;
+				merged = true;
+			}
+		}
+	}
+}
+
 template<typename VarType>
 void SystemTopology::multiplyPowerComps(Int numberCopies) {
 	typename SimNode<VarType>::List newNodes;
@@ -187,6 +336,105 @@ int SystemTopology::checkTopologySubnets(std::unordered_map<typename SimNode<Var
 	return currentNet;
 }
 
+template <typename VarType>
+UInt SystemTopology::tearSubnets(UInt parts) {
+	if (parts < 2)
+		return 0;
+
+	std::unordered_map<typename SimNode<VarType>::Ptr, UInt> nodeIdx;
+	for (auto tnode : mNodes) {
+		auto node = std::dynamic_pointer_cast<SimNode<VarType>>(tnode);
+		if (!node || tnode->isGround())
+			continue;
+		UInt idx = static_cast<UInt>(nodeIdx.size());
+		nodeIdx.emplace(node, idx);
+	}
+
+	// Contract the nodes of components that cannot be torn
+	std::vector<UInt> parent(nodeIdx.size());
+	std::iota(parent.begin(), parent.end(), 0);
+	std::function<UInt(UInt)> find = [&](UInt v) {
+		while (parent[v] != v)
+			v = parent[v] = parent[parent[v]];
+		return v;
+	};
+	std::vector<UInt> groundedNodes;
+	typename SimPowerComp<VarType>::List candidates;
+	for (auto comp : mComponents) {
+		auto pcomp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(comp);
+		if (!pcomp)
+			continue;
+		if (pcomp->terminalNumberConnected() == 2 && std::dynamic_pointer_cast<MNATearInterface>(comp)
+			&& !pcomp->node(0)->isGround() && !pcomp->node(1)->isGround()) {
+			if (pcomp->node(0) != pcomp->node(1))
+				candidates.push_back(pcomp);
+			continue;
+		}
+
+		Int first = -1;
+		Bool toGround = false;
+		for (UInt t = 0; t < pcomp->terminalNumberConnected(); t++) {
+			if (pcomp->node(t)->isGround()) {
+				toGround = true;
+				continue;
+			}
+			UInt idx = nodeIdx.at(pcomp->node(t));
+			if (first < 0)
+				first = idx;
+			else
+				parent[find(idx)] = find(first);
+		}
+		if (toGround && first >= 0)
+			groundedNodes.push_back(first);
+	}
+
+	TearGraph graph;
+	std::vector<Int> vertex(nodeIdx.size(), -1);
+	for (UInt v = 0; v < nodeIdx.size(); v++) {
+		UInt root = find(v);
+		if (vertex[root] < 0) {
+			vertex[root] = static_cast<Int>(graph.weights.size());
+			graph.weights.push_back(0);
+		}
+		graph.weights[vertex[root]]++;
+	}
+	graph.grounded.assign(graph.weights.size(), false);
+	for (auto v : groundedNodes)
+		graph.grounded[vertex[find(v)]] = true;
+
+	std::map<std::pair<UInt, UInt>, UInt> edges;
+	auto candidateVertex = [&](const typename SimPowerComp<VarType>::Ptr& comp, UInt terminal) {
+		return static_cast<UInt>(vertex[find(nodeIdx.at(comp->node(terminal)))]);
+	};
+	for (auto comp : candidates) {
+		UInt a = candidateVertex(comp, 0), b = candidateVertex(comp, 1);
+		if (a != b)
+			edges[std::make_pair(std::min(a, b), std::max(a, b))]++;
+	}
+	graph.adjacency.resize(graph.weights.size());
+	for (auto& edge : edges) {
+		graph.adjacency[edge.first.first].emplace_back(edge.first.second, edge.second);
+		graph.adjacency[edge.first.second].emplace_back(edge.first.first, edge.second);
+	}
+
+	std::vector<UInt> vertices(graph.weights.size());
+	std::iota(vertices.begin(), vertices.end(), 0);
+	std::vector<UInt> labels(graph.weights.size(), 0);
+	graph.partition(vertices, parts, 0, labels);
+	graph.groundParts(labels);
+
+	// Tear the components between different parts
+	UInt torn = 0;
+	for (auto comp : candidates) {
+		if (labels[candidateVertex(comp, 0)] == labels[candidateVertex(comp, 1)])
+			continue;
+		mComponents.erase(std::find(mComponents.begin(), mComponents.end(), comp));
+		addTearComponent(comp);
+		torn++;
+	}
+	return torn;
+}
+
 #ifdef WITH_GRAPHVIZ
 
 Graph::Graph SystemTopology::topologyGraph() {
@@ -305,3 +553,5 @@ template int SystemTopology::checkTopologySubnets<Real>(std::unordered_map<typen
 template int SystemTopology::checkTopologySubnets<Complex>(std::unordered_map<typename CPS::SimNode<Complex>::Ptr, int>& subnet);
 template void SystemTopology::splitSubnets<Real>(std::vector<CPS::SystemTopology>& splitSystems);
 template void SystemTopology::splitSubnets<Complex>(std::vector<CPS::SystemTopology>& splitSystems);
+template UInt SystemTopology::tearSubnets<Real>(UInt parts);
+template UInt SystemTopology::tearSubnets<Complex>(UInt parts);